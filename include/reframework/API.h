@@ -7,7 +7,7 @@
 #endif
 
 #define REFRAMEWORK_PLUGIN_VERSION_MAJOR 1
-#define REFRAMEWORK_PLUGIN_VERSION_MINOR 15
+#define REFRAMEWORK_PLUGIN_VERSION_MINOR 16
 #define REFRAMEWORK_PLUGIN_VERSION_PATCH 0
 
 #define REFRAMEWORK_RENDERER_D3D11 0
@@ -193,6 +193,10 @@ typedef struct {
 
     REFrameworkTypeInfoHandle (*get_type_info)(REFrameworkTypeDefinitionHandle);
     REFrameworkManagedObjectHandle (*get_runtime_type)(REFrameworkTypeDefinitionHandle);
+
+    /* Concrete instantiation of a generic type (the definition or any instantiation of it) with the given arguments. */
+    /* Only instantiations that exist in the TDB can be found, NULL otherwise. Lookups are cached. */
+    REFrameworkTypeDefinitionHandle (*instantiate)(REFrameworkTypeDefinitionHandle, const REFrameworkTypeDefinitionHandle* args, unsigned int num_args);
 } REFrameworkTDBTypeDefinition;
 
 /*
@@ -612,6 +612,11 @@ public:
             static const auto fn = API::s_instance->sdk()->type_definition->get_runtime_type;
             return (API::ManagedObject*)fn(*this);
         }
+
+        API::TypeDefinition* instantiate(const std::vector<API::TypeDefinition*>& args) const {
+            static const auto fn = API::s_instance->sdk()->type_definition->instantiate;
+            return (API::TypeDefinition*)fn(*this, (const REFrameworkTypeDefinitionHandle*)args.data(), (unsigned int)args.size());
+        }
     };
 
     struct Method {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 #include "RETypeDB.hpp"
@@ -9,32 +10,6 @@
 
 namespace sdk {
 
-const char* Application::Function::get_description() const {
-    if (GameIdentity::get().tdb_ver() < 74)
-        return *reinterpret_cast<const char* const*>(reinterpret_cast<uintptr_t>(this) + 0x18);
-    return *reinterpret_cast<const char* const*>(reinterpret_cast<uintptr_t>(this) + 0x10);
-}
-
-uint16_t Application::Function::get_priority() const {
-    if (GameIdentity::get().tdb_ver() < 74)
-        return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x20);
-    return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x18);
-}
-
-uint16_t Application::Function::get_type_val() const {
-    if (GameIdentity::get().tdb_ver() < 74)
-        return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x22);
-    return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x1A);
-}
-
-size_t Application::get_function_stride() {
-    if (GameIdentity::get().tdb_ver() < 74) return 0xD0;
-    return 0xC8;
-}
-
-Application::Function* Application::get_function_at(Application::Function* base, size_t index) {
-    return reinterpret_cast<Function*>(reinterpret_cast<uintptr_t>(base) + index * get_function_stride());
-}
 RETypeDefinition* Application::get_type() {
     return sdk::find_type_definition("via.Application");
 }
@@ -241,65 +216,60 @@ Application::Function* Application::get_functions() {
     return (Application::Function*)((uintptr_t)this + *functions_offset);
 }
 
-Application::Function* Application::get_function(uint16_t index) {
+const Application::FunctionIndex* Application::get_function_index() {
     auto functions = get_functions();
 
     if (functions == nullptr) {
         return nullptr;
     }
 
-    for (auto i = 0; i < 1024; ++i) {
-        auto* fn = get_function_at(functions, i);
-        if (fn->get_priority() == index) {
-            return fn;
-        }
-    }
+    // The functions offset is resolved once and there's only one via.Application, so the table never moves.
+    static const FunctionIndex index{functions, MAX_FUNCTIONS};
 
-    return nullptr;
+    return &index;
 }
 
-Application::Function* Application::get_function(std::string_view name) {
-    auto functions = get_functions();
+Application::Function* Application::get_function(uint16_t index) {
+    const auto function_index = get_function_index();
 
-    if (functions == nullptr) {
+    if (function_index == nullptr) {
         return nullptr;
     }
 
-    const auto module_entry_enum = sdk::find_type_definition("via.ModuleEntry");
-    /*const auto function_index = sdk::get_object_field<uint16_t>(nullptr, module_entry_enum, name, true);
+    return function_index->find(index);
+}
+
+Application::Function* Application::get_function(std::string_view name) {
+    const auto function_index = get_function_index();
 
     if (function_index == nullptr) {
         return nullptr;
-    }*/
-
-    for (auto i = 0; i < 1024; ++i) {
-        auto* fn = get_function_at(functions, i);
-        if (fn->get_description() != nullptr && fn->get_description() == name) {
-            return fn;
-        }
     }
 
-    return nullptr;
+    return function_index->find(name);
 }
 
 std::vector<Application::Function*> Application::generate_chain(std::string_view start_name, std::string_view end_name) {
     std::vector<Function*> chain{};
-    
-    const auto module_entry_enum = sdk::find_type_definition("via.ModuleEntry");
-    //const auto start_index = sdk::get_object_field<uint16_t>(nullptr, module_entry_enum, start_name, true);
-    //const auto end_index = sdk::get_object_field<uint16_t>(nullptr, module_entry_enum, end_name, true);
 
-    const auto start_index = get_function(start_name)->get_priority();
-    const auto end_index = get_function(end_name)->get_priority();
+    const auto function_index = get_function_index();
 
-    /*if (start_index == nullptr || end_index == nullptr) {
+    if (function_index == nullptr) {
         return chain;
-    }*/
+    }
+
+    const auto start = function_index->find(start_name);
+    const auto end = function_index->find(end_name);
+
+    if (start == nullptr || end == nullptr) {
+        return chain;
+    }
 
-    for (auto i = start_index; i <= end_index; ++i) {
-        const auto function = get_function(i);
+    const auto range = function_index->get_range(start->get_priority(), end->get_priority());
+    chain.reserve(range.size());
 
-        if (function == nullptr || function->func == nullptr) {
+    for (auto function : range) {
+        if (function->func == nullptr) {
             continue;
         }
 
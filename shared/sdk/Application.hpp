@@ -2,7 +2,9 @@
 
 #include <vector>
 #include <cstdint>
+#include <span>
 #include <string_view>
+#include <unordered_map>
 
 #include "TDBVer.hpp"
 
@@ -29,6 +31,27 @@ struct Application {
     };
     static_assert(sizeof(Function) == 0xC8, "Function has wrong size");
 
+    // Number of slots in the module entry table.
+    static constexpr size_t MAX_FUNCTIONS = 1024;
+
+    // Name and priority lookups over the module entry table, built once so they don't rescan it.
+    // Matches the old linear scans: the first slot with a given name or priority wins.
+    class FunctionIndex {
+    public:
+        FunctionIndex(Function* functions, size_t count);
+
+        Function* find(uint16_t priority) const;
+        Function* find(std::string_view name) const;
+
+        // One entry per priority in [start, end], sorted by priority. Entries with a null func are included.
+        std::span<Function* const> get_range(uint16_t start, uint16_t end) const;
+
+    private:
+        std::unordered_map<std::string_view, Function*> m_by_name{};
+        std::unordered_map<uint16_t, Function*> m_by_priority{};
+        std::vector<Function*> m_sorted{};
+    };
+
     static size_t get_function_stride();
     static Function* get_function_at(Function* base, size_t index);
 
@@ -39,7 +62,9 @@ struct Application {
     Function* get_functions();
     Function* get_function(uint16_t index);
     Function* get_function(std::string_view name);
+    const FunctionIndex* get_function_index();
 
+    // Entries from start_name to end_name (inclusive) that have a func, in priority order.
     std::vector<Function*> generate_chain(std::string_view start_name, std::string_view end_name);
 
     float get_delta_time();
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include "Application.hpp"
+#include "GameIdentity.hpp"
+
+// Layout accessors and the module entry index. Kept apart from Application.cpp so they only need
+// GameIdentity, which lets the tests run the index over a synthetic table.
+namespace sdk {
+const char* Application::Function::get_description() const {
+    if (GameIdentity::get().tdb_ver() < 74)
+        return *reinterpret_cast<const char* const*>(reinterpret_cast<uintptr_t>(this) + 0x18);
+    return *reinterpret_cast<const char* const*>(reinterpret_cast<uintptr_t>(this) + 0x10);
+}
+
+uint16_t Application::Function::get_priority() const {
+    if (GameIdentity::get().tdb_ver() < 74)
+        return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x20);
+    return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x18);
+}
+
+uint16_t Application::Function::get_type_val() const {
+    if (GameIdentity::get().tdb_ver() < 74)
+        return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x22);
+    return *reinterpret_cast<const uint16_t*>(reinterpret_cast<uintptr_t>(this) + 0x1A);
+}
+
+size_t Application::get_function_stride() {
+    if (GameIdentity::get().tdb_ver() < 74) return 0xD0;
+    return 0xC8;
+}
+
+Application::Function* Application::get_function_at(Application::Function* base, size_t index) {
+    return reinterpret_cast<Function*>(reinterpret_cast<uintptr_t>(base) + index * get_function_stride());
+}
+
+Application::FunctionIndex::FunctionIndex(Function* functions, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        auto* fn = get_function_at(functions, i);
+
+        if (m_by_priority.emplace(fn->get_priority(), fn).second) {
+            m_sorted.push_back(fn);
+        }
+
+        const auto description = fn->get_description();
+
+        // Slots past the end of the real table can hold garbage.
+        if (description == nullptr) {
+            continue;
+        }
+
+#ifdef _WIN32
+        if (IsBadReadPtr(description, 1)) {
+            continue;
+        }
+#endif
+
+        m_by_name.emplace(std::string_view{description}, fn);
+    }
+
+    std::sort(m_sorted.begin(), m_sorted.end(), [](const Function* a, const Function* b) {
+        return a->get_priority() < b->get_priority();
+    });
+
+    spdlog::info("[Application] Indexed {} module entries ({} named)", m_sorted.size(), m_by_name.size());
+}
+
+Application::Function* Application::FunctionIndex::find(uint16_t priority) const {
+    if (auto it = m_by_priority.find(priority); it != m_by_priority.end()) {
+        return it->second;
+    }
+
+    return nullptr;
+}
+
+Application::Function* Application::FunctionIndex::find(std::string_view name) const {
+    if (auto it = m_by_name.find(name); it != m_by_name.end()) {
+        return it->second;
+    }
+
+    return nullptr;
+}
+
+std::span<Application::Function* const> Application::FunctionIndex::get_range(uint16_t start, uint16_t end) const {
+    if (start > end) {
+        return {};
+    }
+
+    const auto first = std::lower_bound(m_sorted.begin(), m_sorted.end(), start, [](const Function* fn, uint16_t priority) {
+        return fn->get_priority() < priority;
+    });
+
+    const auto last = std::upper_bound(first, m_sorted.end(), end, [](uint16_t priority, const Function* fn) {
+        return priority < fn->get_priority();
+    });
+
+    return {first, last};
+}
+}
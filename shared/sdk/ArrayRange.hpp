@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+// Bounds checks behind SystemArray's bulk access (get_objects, copy_to, set_range, set_range_raw).
+// Works on the raw REArrayBase fields and element storage, so it doesn't need the array layout headers.
+namespace sdk::array_range {
+enum class RawWrite {
+    OK,
+    BAD_BYTE_COUNT, // Not a whole number of elements
+    OUT_OF_RANGE,
+};
+
+// Element count stored in the array header, negative counts read as empty.
+constexpr size_t size_from_header(int32_t num_elements) {
+    return num_elements > 0 ? (size_t)num_elements : 0;
+}
+
+// Whether [start, start + count) lies inside size elements. Written so it can't overflow.
+constexpr bool fits(size_t size, size_t start, size_t count) {
+    return start <= size && count <= size - start;
+}
+
+// Copies up to out.size() elements of source starting at start. Returns the number copied.
+template <typename T>
+size_t copy_out(std::span<T> source, std::span<std::remove_const_t<T>> out, size_t start) {
+    if (start >= source.size()) {
+        return 0;
+    }
+
+    const auto count = std::min(out.size(), source.size() - start);
+    std::copy_n(source.begin() + start, count, out.begin());
+
+    return count;
+}
+
+// Raw copy into inline element storage of size elements, element_size bytes each.
+// Nothing is written unless the whole range fits.
+inline RawWrite write_raw(uint8_t* data, size_t size, uint32_t element_size, size_t start, std::span<const uint8_t> bytes) {
+    if (element_size == 0 || bytes.size() % element_size != 0) {
+        return RawWrite::BAD_BYTE_COUNT;
+    }
+
+    if (!fits(size, start, bytes.size() / element_size)) {
+        return RawWrite::OUT_OF_RANGE;
+    }
+
+    if (!bytes.empty()) {
+        std::memcpy(data + start * element_size, bytes.data(), bytes.size());
+    }
+
+    return RawWrite::OK;
+}
+}
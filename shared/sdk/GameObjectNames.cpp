@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include <utility/Fnv1a.hpp>
+#include <utility/String.hpp>
+
+#include "RETypeDB.hpp"
+#include "REString.hpp"
+#include "REGameObject.hpp"
+#include "SceneManager.hpp"
+
+#include "GameObjectNames.hpp"
+
+namespace sdk {
+GameObjectNames& GameObjectNames::get() {
+    static GameObjectNames instance{};
+    return instance;
+}
+
+std::string GameObjectNames::get_name(const REGameObject* obj) {
+    if (obj == nullptr) {
+        return {};
+    }
+
+    const auto print = fingerprint(obj->get_name_string());
+
+    {
+        std::shared_lock _{m_mutex};
+
+        if (const auto entry = find_locked(obj, print); entry != nullptr) {
+            return entry->name;
+        }
+    }
+
+    return refresh(obj, print).name;
+}
+
+size_t GameObjectNames::get_name_hash(const REGameObject* obj) {
+    if (obj == nullptr) {
+        return utility::hash(std::string_view{});
+    }
+
+    const auto print = fingerprint(obj->get_name_string());
+
+    {
+        std::shared_lock _{m_mutex};
+
+        if (const auto entry = find_locked(obj, print); entry != nullptr) {
+            return entry->hash;
+        }
+    }
+
+    return refresh(obj, print).hash;
+}
+
+GameObjectNames::Fingerprint GameObjectNames::fingerprint(SystemString* source) {
+    if (source == nullptr) {
+        return {};
+    }
+
+    const auto length = (uint32_t)std::max(source->size, 0);
+
+    return {source, length, utility::fnv1a::hash64(source->data, length * sizeof(wchar_t))};
+}
+
+// Called with m_mutex held either way, last_used is the only thing written under the shared lock.
+const GameObjectNames::Entry* GameObjectNames::find_locked(const REGameObject* obj, const Fingerprint& print) {
+    const auto it = m_entries.find(obj);
+
+    if (it == m_entries.end() || it->second.fingerprint != print) {
+        return nullptr;
+    }
+
+    std::atomic_ref{it->second.last_used}.store(m_frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return &it->second;
+}
+
+GameObjectNames::Entry GameObjectNames::refresh(const REGameObject* obj, const Fingerprint& print) {
+    Entry entry{print, print.source != nullptr ? utility::re_string::get_string(print.source) : std::string{}};
+    entry.hash = utility::hash(entry.name);
+    entry.last_used = m_frame.load(std::memory_order_relaxed);
+
+    std::unique_lock _{m_mutex};
+
+    if (m_entries.size() >= MAX_ENTRIES && !m_entries.contains(obj)) {
+        evict_locked();
+    }
+
+    m_entries[obj] = entry;
+
+    return entry;
+}
+
+// Dead objects are never removed individually. Drop whatever hasn't been looked up in a while first,
+// then the least recently used quarter if that wasn't enough.
+void GameObjectNames::evict_locked() {
+    const auto frame = m_frame.load(std::memory_order_relaxed);
+
+    std::erase_if(m_entries, [&](const auto& kv) {
+        return frame - kv.second.last_used > STALE_FRAMES;
+    });
+
+    if (m_entries.size() < MAX_ENTRIES - MAX_ENTRIES / 4) {
+        return;
+    }
+
+    std::vector<uint64_t> last_used{};
+    last_used.reserve(m_entries.size());
+
+    for (const auto& [obj, entry] : m_entries) {
+        last_used.push_back(entry.last_used);
+    }
+
+    const auto nth = last_used.begin() + last_used.size() / 4;
+    std::nth_element(last_used.begin(), nth, last_used.end());
+    const auto cutoff = *nth;
+
+    std::erase_if(m_entries, [&](const auto& kv) {
+        return kv.second.last_used < cutoff;
+    });
+
+    // Everything was used in the same frame, nothing is older than anything else.
+    if (m_entries.size() >= MAX_ENTRIES) {
+        m_entries.clear();
+    }
+}
+
+std::vector<REGameObject*> GameObjectNames::find_game_objects_by_name(size_t name_hash) {
+    const auto scene = sdk::get_current_scene();
+
+    if (scene == nullptr) {
+        return {};
+    }
+
+    {
+        std::shared_lock _{m_index_mutex};
+
+        if (m_index_valid && m_index_scene == scene) {
+            if (auto it = m_index.find(name_hash); it != m_index.end()) {
+                return it->second;
+            }
+
+            return {};
+        }
+    }
+
+    std::unique_lock _{m_index_mutex};
+
+    if (!m_index_valid || m_index_scene != scene) {
+        build_index(scene);
+    }
+
+    if (auto it = m_index.find(name_hash); it != m_index.end()) {
+        return it->second;
+    }
+
+    return {};
+}
+
+std::vector<REGameObject*> GameObjectNames::find_game_objects_by_name(std::string_view name) {
+    return find_game_objects_by_name(utility::hash(name));
+}
+
+void GameObjectNames::begin_frame() {
+    m_frame.fetch_add(1, std::memory_order_relaxed);
+
+    std::unique_lock _{m_index_mutex};
+
+    m_index_valid = false;
+    m_index_scene = nullptr;
+}
+
+void GameObjectNames::build_index(REManagedObject* scene) {
+    static const auto scene_def = sdk::find_type_definition("via.Scene");
+    static const auto transform_def = sdk::find_type_definition("via.Transform");
+    static const auto first_transform_method = scene_def != nullptr ? scene_def->get_method("get_FirstTransform") : nullptr;
+    static const auto next_transform_method = transform_def != nullptr ? transform_def->get_method("get_Next") : nullptr;
+    static const auto get_gameobject_method = transform_def != nullptr ? transform_def->get_method("get_GameObject") : nullptr;
+
+    // Keep the buckets around, most names are the same from frame to frame.
+    for (auto& [hash, objects] : m_index) {
+        objects.clear();
+    }
+
+    m_index_scene = scene;
+    m_index_valid = true;
+
+    if (first_transform_method == nullptr || next_transform_method == nullptr || get_gameobject_method == nullptr) {
+        return;
+    }
+
+    const auto context = sdk::get_thread_context();
+
+    for (auto transform = first_transform_method->call<::REManagedObject*>(context, scene);
+        transform != nullptr;
+        transform = next_transform_method->call<::REManagedObject*>(context, transform))
+    {
+        const auto owner = get_gameobject_method->call<REGameObject*>(context, transform);
+
+        if (owner == nullptr) {
+            continue;
+        }
+
+        m_index[get_name_hash(owner)].push_back(owner);
+    }
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class REGameObject;
+class REManagedObject;
+class SystemString;
+
+namespace sdk {
+// Caches the UTF-8 name and name hash of GameObjects, so tools and scripts filtering by name
+// don't transcode every object they touch. Entries are keyed by the object and checked against its
+// name string's address, length and a hash of its UTF-16 payload, so renaming an object, a new object
+// at a reused address or a new string at a reused address all refresh the entry.
+class GameObjectNames {
+public:
+    static constexpr size_t MAX_ENTRIES = 1 << 16;
+
+    // Entries nobody looked up for this many frames are dropped first when the cache is full,
+    // their objects are most likely gone.
+    static constexpr uint64_t STALE_FRAMES = 300;
+
+    static GameObjectNames& get();
+
+    std::string get_name(const REGameObject* obj);
+
+    // utility::hash of the UTF-8 name.
+    size_t get_name_hash(const REGameObject* obj);
+
+    // All GameObjects in the current scene with the given name. The index is built from a single
+    // walk of the scene's transforms and reused until the next begin_frame().
+    std::vector<REGameObject*> find_game_objects_by_name(size_t name_hash);
+    std::vector<REGameObject*> find_game_objects_by_name(std::string_view name);
+
+    // GameObjects can be destroyed between frames, so the scene index never outlives one.
+    void begin_frame();
+
+private:
+    // Identifies the contents of a name string without transcoding it.
+    struct Fingerprint {
+        SystemString* source{};
+        uint32_t length{};
+        uint64_t payload_hash{};
+
+        bool operator==(const Fingerprint&) const = default;
+    };
+
+    struct Entry {
+        Fingerprint fingerprint{};
+        std::string name{};
+        size_t hash{};
+        uint64_t last_used{}; // Frame of the last lookup, updated through an atomic_ref under the shared lock
+    };
+
+    static Fingerprint fingerprint(SystemString* source);
+
+    const Entry* find_locked(const REGameObject* obj, const Fingerprint& print);
+    Entry refresh(const REGameObject* obj, const Fingerprint& print);
+    void evict_locked();
+    void build_index(REManagedObject* scene);
+
+    std::shared_mutex m_mutex{};
+    std::unordered_map<const REGameObject*, Entry> m_entries{};
+    std::atomic<uint64_t> m_frame{0};
+
+    std::shared_mutex m_index_mutex{};
+    REManagedObject* m_index_scene{};
+    bool m_index_valid{false};
+    std::unordered_map<size_t, std::vector<REGameObject*>> m_index{};
+};
+}
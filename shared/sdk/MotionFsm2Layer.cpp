@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 #include <utility/Relocate.hpp>
@@ -7,6 +8,7 @@
 #include "REContext.hpp"
 #include "Memory.hpp"
 #include "RENativeArray.hpp"
+#include "NativeArrayEdit.hpp"
 
 #include "MotionFsm2Layer.hpp"
 
@@ -71,66 +73,32 @@ std::vector<::REManagedObject*> TreeNode::get_unloaded_actions() const {
 }
 
 std::vector<::REManagedObject*> TreeNode::get_actions() const {
-    const auto tree_data = get_data();
-
-    if (tree_data == nullptr) {
-        return {};
-    }
-
     const auto tree_owner = this->get_owner();
-    
+
     if (tree_owner == nullptr) {
         return {};
     }
-    
-    std::vector<::REManagedObject*> out{};
-    auto& actions = tree_data->get_actions();
 
-    for (uint64_t i = 0; i < actions.size(); ++i) {
-        const auto action_index = actions[i];
-        const auto action = tree_owner->get_action(action_index);
-
-        // Push it back even if it's null, because the action may not be loaded
-        // and we may want to compare indices, or just want to know what the action is before it's loaded.
-        out.push_back(action);
-    }
+    std::vector<::REManagedObject*> out{};
+    tree_owner->resolve().collect_actions(this, out);
 
     return out;
 }
 
 std::vector<::REManagedObject*> TreeNode::get_transition_conditions() const {
-    const auto tree_data = get_data();
-
-    if (tree_data == nullptr) {
-        return {};
-    }
-
     const auto tree_owner = this->get_owner();
-    
+
     if (tree_owner == nullptr) {
         return {};
     }
-    
-    std::vector<::REManagedObject*> out{};
-    auto& tc = tree_data->get_transition_conditions();
-
-    for (uint64_t i = 0; i < tc.size(); ++i) {
-        const auto transition_index = tc[i];
-        const auto transition = tree_owner->get_condition(transition_index);
 
-        out.push_back(transition);
-    }
+    std::vector<::REManagedObject*> out{};
+    tree_owner->resolve().collect_transition_conditions(this, out);
 
     return out;
 }
 
 std::vector<::REManagedObject*> TreeNode::get_transition_events() const {
-    const auto tree_data = get_data();
-
-    if (tree_data == nullptr) {
-        return {};
-    }
-
     const auto tree_owner = this->get_owner();
 
     if (tree_owner == nullptr) {
@@ -138,25 +106,12 @@ std::vector<::REManagedObject*> TreeNode::get_transition_events() const {
     }
 
     std::vector<::REManagedObject*> out{};
-    auto& st = tree_data->get_start_transitions();
-
-    for (uint64_t i = 0; i < st.size(); ++i) {
-        const auto transition_index = st[i];
-        const auto transition = tree_owner->get_transition(transition_index);
-
-        out.push_back(transition);
-    }
+    tree_owner->resolve().collect_transition_events(this, out);
 
     return out;
 }
 
 std::vector<::REManagedObject*> TreeNode::get_conditions() const {
-    const auto tree_data = get_data();
-
-    if (tree_data == nullptr) {
-        return {};
-    }
-
     const auto tree_owner = this->get_owner();
 
     if (tree_owner == nullptr) {
@@ -164,14 +119,7 @@ std::vector<::REManagedObject*> TreeNode::get_conditions() const {
     }
 
     std::vector<::REManagedObject*> out{};
-    auto& conds = tree_data->get_conditions();
-
-    for (uint64_t i = 0; i < conds.size(); ++i) {
-        const auto condition_index = conds[i];
-        const auto condition = tree_owner->get_condition(condition_index);
-
-         out.push_back(condition);
-    }
+    tree_owner->resolve().collect_conditions(this, out);
 
     return out;
 }
@@ -265,18 +213,28 @@ void TreeNode::remove_action(uint32_t index) {
     arr.erase(index);
 }
 
-void TreeNode::relocate(uintptr_t old_start, uintptr_t old_end, uintptr_t new_start) {
-    auto selector = (::REManagedObject*)get_selector();
+namespace {
+void relocate_node(TreeNode* node, utility::PointerRelocator& relocator) {
+    auto selector = (::REManagedObject*)node->get_selector();
 
     if (selector != nullptr && REManagedObject::is_managed_object(selector)) {
         const auto td = selector->get_type_definition();
 
         if (td != nullptr) {
-            utility::relocate_pointers((uint8_t*)selector, old_start, old_end, new_start, 1, sizeof(void*), td->get_size());
+            relocator.scan((uint8_t*)selector, 1, td->get_size());
         }
     }
 
-    utility::relocate_pointers((uint8_t*)this, old_start, old_end, new_start, 0, sizeof(void*), tree_node_stride());
+    relocator.scan((uint8_t*)node, 0, tree_node_stride());
+}
+}
+
+void TreeNode::relocate(uintptr_t old_start, uintptr_t old_end, uintptr_t new_start) {
+    const utility::RelocationRange range{old_start, old_end, new_start};
+    utility::PointerRelocator relocator{std::span{&range, 1}};
+
+    relocate_node(this, relocator);
+    relocator.log_summary("TreeNode");
 }
 
 void BehaviorTree::set_current_node(sdk::behaviortree::TreeNode* node, uint32_t tree_idx, void* set_node_info) {
@@ -325,13 +283,18 @@ void TreeObject::relocate(uintptr_t old_start, uintptr_t old_end, sdk::NativeArr
     const auto node_count = new_nodes.num;
     const auto stride = tree_node_stride();
 
+    // One relocator for the whole tree, so memory regions are queried and shared objects are scanned only once.
+    const utility::RelocationRange range{old_start, old_end, new_start};
+    utility::PointerRelocator relocator{std::span{&range, 1}};
+
     for (uint32_t i = 0; i < node_count; i++) {
         auto* node = (TreeNode*)((uint8_t*)new_nodes.elements + i * stride);
-        node->relocate(old_start, old_end, new_start);
+        relocate_node(node, relocator);
     }
 
     // TreeObject is 0xD8 in both layouts
-    utility::relocate_pointers((uint8_t*)this, old_start, old_end, new_start, 1, sizeof(void*), 0xD8);
+    relocator.scan((uint8_t*)this, 1, 0xD8);
+    relocator.log_summary("TreeObject");
 
     set_root_node((TreeNode*)new_nodes.elements);
 }
@@ -344,8 +307,12 @@ void TreeObject::relocate_datas(uintptr_t old_start, uintptr_t old_end, sdk::Nat
     auto* nodes_base = get_nodes_ptr();
     const auto total_nodes_bytes = node_count * tree_node_stride();
 
-    utility::relocate_pointers((uint8_t*)nodes_base, old_start, old_end, new_start, 1, sizeof(void*), total_nodes_bytes);
-    utility::relocate_pointers((uint8_t*)this, old_start, old_end, new_start, 1, sizeof(void*), 0xD8);
+    const utility::RelocationRange range{old_start, old_end, new_start};
+    utility::PointerRelocator relocator{std::span{&range, 1}};
+
+    relocator.scan((uint8_t*)nodes_base, 1, total_nodes_bytes);
+    relocator.scan((uint8_t*)this, 1, 0xD8);
+    relocator.log_summary("TreeObject datas");
 }
 
 ::REManagedObject* TreeObject::get_uservariable_hub() const {
@@ -390,49 +357,7 @@ void CoreHandle::relocate_datas(uintptr_t old_start, uintptr_t old_end, sdk::Nat
 }
 
 ::REManagedObject* TreeObject::get_action(uint32_t index) const {
-    const auto is_delay_setup_objects = is_delayed();
-    const auto data = get_data();
-
-    if (data == nullptr) {
-        return nullptr;
-    }
-
-    if (_bittest((const long*)&index, 30)) {
-        const auto new_idx = index & 0xFFFFFFF;
-        auto& sa = data->get_static_actions();
-        if (new_idx >= sa.size() || sa.elements == nullptr) {
-            return nullptr;
-        }
-
-        return (::REManagedObject*)sa[new_idx];
-    } else {
-        if (sdk::GameIdentity::get().tdb_ver() >= 69) {
-            if (is_delay_setup_objects) {
-                auto& da = get_delayed_actions();
-                if (index >= da.size() || da.elements == nullptr) {
-                    return nullptr;
-                }
-
-                return (::REManagedObject*)da[index];
-            } else {
-                auto& a = get_action_array();
-                if (index >= a.size() || a.elements == nullptr) {
-                    return nullptr;
-                }
-
-                return (::REManagedObject*)a[index];
-            }
-        } else {
-            auto& a = get_action_array();
-            if (index >= a.size() || a.elements == nullptr) {
-                return nullptr;
-            }
-
-            return (::REManagedObject*)a[index];
-        }
-    }
-
-    return nullptr;
+    return resolve().get_action(index);
 }
 
 ::REManagedObject* TreeObject::get_unloaded_action(uint32_t index) const {
@@ -464,110 +389,382 @@ void CoreHandle::relocate_datas(uintptr_t old_start, uintptr_t old_end, sdk::Nat
 }
 
 ::REManagedObject* TreeObject::get_condition(int32_t index) const {
+    return resolve().get_condition(index);
+}
+
+::REManagedObject* TreeObject::get_transition(int32_t index) const {
+    return resolve().get_transition(index);
+}
+
+ResolvedTreeObject TreeObject::resolve() const {
+    return ResolvedTreeObject{this};
+}
+
+uint32_t TreeObject::get_action_count() const {
+    const auto is_delay_setup_objects = is_delayed();
+    return is_delay_setup_objects ? get_delayed_actions().size() : get_action_array().size();
+}
+
+uint32_t TreeObject::get_condition_count() const {
     const auto is_delay_setup_objects = is_delayed();
-    const auto data = get_data();
+    return is_delay_setup_objects ? get_delayed_conditions().size() : get_condition_array().size();
+}
 
-    if (data == nullptr || index == -1) {
-        return nullptr;
+uint32_t TreeObject::get_transition_count() const {
+    const auto is_delay_setup_objects = is_delayed();
+    return is_delay_setup_objects ? get_delayed_transitions().size() : get_transition_array().size();
+}
+
+namespace {
+std::span<::REManagedObject* const> as_span(const sdk::NativeArray<::REManagedObject*>& arr) {
+    if (arr.elements == nullptr) {
+        return {};
     }
 
+    return {arr.elements, arr.size()};
+}
+
+// Indices with bit 30 set refer to the static arrays in TreeObjectData.
+::REManagedObject* lookup(std::span<::REManagedObject* const> dynamic, std::span<::REManagedObject* const> statics, uint32_t index) {
     if (_bittest((const long*)&index, 30)) {
         const auto new_idx = index & 0xFFFFFFF;
-        auto& sc = data->get_static_conditions();
-        if (new_idx >= sc.size() || sc.elements == nullptr) {
-            return nullptr;
-        }
+        return new_idx < statics.size() ? statics[new_idx] : nullptr;
+    }
 
-        return (::REManagedObject*)sc[new_idx];
-    } else {
-        if (sdk::GameIdentity::get().tdb_ver() >= 69) {
-            if (is_delay_setup_objects) {
-                auto& dc = get_delayed_conditions();
-                if (index >= (int32_t)dc.size() || dc.elements == nullptr) {
-                    return nullptr;
-                }
+    return index < dynamic.size() ? dynamic[index] : nullptr;
+}
+}
 
-                return (::REManagedObject*)dc[index];
-            } else {
-                auto& c = get_condition_array();
-                if (index >= (int32_t)c.size() || c.elements == nullptr) {
-                    return nullptr;
-                }
+ResolvedTreeObject::ResolvedTreeObject(const TreeObject* tree)
+    : m_tree{tree}
+{
+    if (tree == nullptr) {
+        return;
+    }
 
-                return (::REManagedObject*)c[index];
-            }
-        } else {
-            auto& c = get_condition_array();
-            if (index >= (int32_t)c.size() || c.elements == nullptr) {
-                return nullptr;
-            }
+    const auto data = tree->get_data();
 
-            return (::REManagedObject*)c[index];
-        }
+    // Every lookup fails without data, same as the TreeObject accessors.
+    if (data == nullptr) {
+        return;
     }
 
-    return nullptr;
+    m_delayed = tree->is_delayed();
+
+    m_actions = as_span(m_delayed ? tree->get_delayed_actions() : tree->get_action_array());
+    m_conditions = as_span(m_delayed ? tree->get_delayed_conditions() : tree->get_condition_array());
+    m_transitions = as_span(m_delayed ? tree->get_delayed_transitions() : tree->get_transition_array());
+
+    m_static_actions = as_span(data->get_static_actions());
+    m_static_conditions = as_span(data->get_static_conditions());
+    m_static_transitions = as_span(data->get_static_transitions());
 }
 
-::REManagedObject* TreeObject::get_transition(int32_t index) const {
-    const auto is_delay_setup_objects = is_delayed();
-    const auto data = get_data();
+::REManagedObject* ResolvedTreeObject::get_action(uint32_t index) const {
+    return lookup(m_actions, m_static_actions, index);
+}
 
-    if (data == nullptr) {
+::REManagedObject* ResolvedTreeObject::get_condition(int32_t index) const {
+    if (index == -1) {
         return nullptr;
     }
 
-    if (_bittest((const long*)&index, 30)) {
-        const auto new_idx = index & 0xFFFFFFF;
-        auto& st = data->get_static_transitions();
-        if (new_idx >= st.size() || st.elements == nullptr) {
-            return nullptr;
-        }
+    return lookup(m_conditions, m_static_conditions, (uint32_t)index);
+}
 
-        return (::REManagedObject*)st[new_idx];
-    } else {
-        if (sdk::GameIdentity::get().tdb_ver() >= 69) {
-            if (is_delay_setup_objects) {
-                auto& dt = get_delayed_transitions();
-                if (index >= (int32_t)dt.size() || dt.elements == nullptr) {
-                    return nullptr;
-                }
+::REManagedObject* ResolvedTreeObject::get_transition(int32_t index) const {
+    return lookup(m_transitions, m_static_transitions, (uint32_t)index);
+}
 
-                return (::REManagedObject*)dt[index];
-            } else {
-                auto& t = get_transition_array();
-                if (index >= (int32_t)t.size() || t.elements == nullptr) {
-                    return nullptr;
-                }
+void ResolvedTreeObject::collect_actions(const TreeNode* node, std::vector<::REManagedObject*>& out) const {
+    const auto tree_data = node->get_data();
 
-                return (::REManagedObject*)t[index];
-            }
-        } else {
-            auto& t = get_transition_array();
-            if (index >= (int32_t)t.size() || t.elements == nullptr) {
-                return nullptr;
-            }
+    if (tree_data == nullptr) {
+        return;
+    }
 
-            return (::REManagedObject*)t[index];
-        }
+    auto& actions = tree_data->get_actions();
+    out.reserve(out.size() + actions.size());
+
+    for (uint64_t i = 0; i < actions.size(); ++i) {
+        // Push it back even if it's null, because the action may not be loaded
+        // and we may want to compare indices, or just want to know what the action is before it's loaded.
+        out.push_back(get_action(actions[i]));
     }
+}
 
-    return nullptr;
+void ResolvedTreeObject::collect_conditions(const TreeNode* node, std::vector<::REManagedObject*>& out) const {
+    const auto tree_data = node->get_data();
+
+    if (tree_data == nullptr) {
+        return;
+    }
+
+    auto& conds = tree_data->get_conditions();
+    out.reserve(out.size() + conds.size());
+
+    for (uint64_t i = 0; i < conds.size(); ++i) {
+        out.push_back(get_condition(conds[i]));
+    }
 }
 
-uint32_t TreeObject::get_action_count() const {
-    const auto is_delay_setup_objects = is_delayed();
-    return is_delay_setup_objects ? get_delayed_actions().size() : get_action_array().size();
+void ResolvedTreeObject::collect_transition_conditions(const TreeNode* node, std::vector<::REManagedObject*>& out) const {
+    const auto tree_data = node->get_data();
+
+    if (tree_data == nullptr) {
+        return;
+    }
+
+    auto& tc = tree_data->get_transition_conditions();
+    out.reserve(out.size() + tc.size());
+
+    for (uint64_t i = 0; i < tc.size(); ++i) {
+        out.push_back(get_condition(tc[i]));
+    }
 }
 
-uint32_t TreeObject::get_condition_count() const {
-    const auto is_delay_setup_objects = is_delayed();
-    return is_delay_setup_objects ? get_delayed_conditions().size() : get_condition_array().size();
+void ResolvedTreeObject::collect_transition_events(const TreeNode* node, std::vector<::REManagedObject*>& out) const {
+    const auto tree_data = node->get_data();
+
+    if (tree_data == nullptr) {
+        return;
+    }
+
+    auto& st = tree_data->get_start_transitions();
+    out.reserve(out.size() + st.size());
+
+    for (uint64_t i = 0; i < st.size(); ++i) {
+        out.push_back(get_transition(st[i]));
+    }
 }
 
-uint32_t TreeObject::get_transition_count() const {
-    const auto is_delay_setup_objects = is_delayed();
-    return is_delay_setup_objects ? get_delayed_transitions().size() : get_transition_array().size();
+namespace {
+template<typename T>
+void detach(sdk::NativeArrayNoCapacity<T>& arr) {
+    arr.elements = nullptr;
+    arr.num = 0;
+}
+
+// A copied node data must not share (and later free) the source's index arrays.
+void detach_node_arrays(TreeNodeData* data) {
+    detach(data->get_children());
+    detach(data->get_actions());
+    detach(data->get_states());
+    detach(data->get_states_2());
+    detach(data->get_start_transitions());
+    detach(data->get_start_states());
+    detach(data->get_conditions());
+    detach(data->get_transition_conditions());
+    detach(data->get_transition_ids());
+    detach(data->get_transition_attributes());
+    detach(data->get_transition_events());
+}
+}
+
+TreeTransaction::TreeTransaction(TreeObject* tree, CoreHandle* handle)
+    : m_tree{tree},
+    m_handle{handle}
+{
+    if (tree == nullptr) {
+        return;
+    }
+
+    const auto resolved = tree->resolve();
+
+    m_delayed = resolved.is_delayed();
+    m_base_node_count = tree->get_node_count();
+    m_base_action_count = (uint32_t)resolved.get_actions().size();
+    m_base_condition_count = (uint32_t)resolved.get_conditions().size();
+    m_base_transition_count = (uint32_t)resolved.get_transitions().size();
+}
+
+uint32_t TreeTransaction::add_action(::REManagedObject* action) {
+    m_new_actions.push_back(action);
+    return m_base_action_count + (uint32_t)m_new_actions.size() - 1;
+}
+
+int32_t TreeTransaction::add_condition(::REManagedObject* condition) {
+    m_new_conditions.push_back(condition);
+    return (int32_t)(m_base_condition_count + m_new_conditions.size() - 1);
+}
+
+int32_t TreeTransaction::add_transition(::REManagedObject* transition) {
+    m_new_transitions.push_back(transition);
+    return (int32_t)(m_base_transition_count + m_new_transitions.size() - 1);
+}
+
+std::optional<uint32_t> TreeTransaction::add_node(uint32_t source_index) {
+    if (m_tree == nullptr || source_index >= m_base_node_count) {
+        return std::nullopt;
+    }
+
+    m_new_node_sources.push_back(source_index);
+    return m_base_node_count + (uint32_t)m_new_node_sources.size() - 1;
+}
+
+void TreeTransaction::append_node_action(uint32_t node_index, uint32_t action_index) {
+    m_node_edits[node_index].actions.appended.push_back(action_index);
+}
+
+void TreeTransaction::remove_node_action(uint32_t node_index, uint32_t position) {
+    m_node_edits[node_index].actions.removed.push_back(position);
+}
+
+void TreeTransaction::append_node_condition(uint32_t node_index, int32_t condition_index) {
+    m_node_edits[node_index].conditions.appended.push_back(condition_index);
+}
+
+void TreeTransaction::remove_node_condition(uint32_t node_index, uint32_t position) {
+    m_node_edits[node_index].conditions.removed.push_back(position);
+}
+
+bool TreeTransaction::empty() const {
+    return m_new_node_sources.empty() && m_new_actions.empty() && m_new_conditions.empty() && m_new_transitions.empty() && m_node_edits.empty();
+}
+
+bool TreeTransaction::commit() {
+    if (m_tree == nullptr) {
+        return false;
+    }
+
+    // Nodes first, the node edits below may refer to the new ones.
+    const auto nodes_ok = commit_nodes();
+
+    if (nodes_ok) {
+        append_all(m_delayed ? m_tree->get_delayed_actions() : m_tree->get_action_array(), m_new_actions);
+        append_all(m_delayed ? m_tree->get_delayed_conditions() : m_tree->get_condition_array(), m_new_conditions);
+        append_all(m_delayed ? m_tree->get_delayed_transitions() : m_tree->get_transition_array(), m_new_transitions);
+
+        commit_node_edits();
+    }
+
+    // Clears what was staged, later stages index from what is there now.
+    *this = TreeTransaction{m_tree, m_handle};
+
+    return nodes_ok;
+}
+
+bool TreeTransaction::commit_nodes() {
+    if (m_new_node_sources.empty()) {
+        return true;
+    }
+
+    const auto tree_data = m_tree->get_data();
+    auto old_nodes = (uint8_t*)m_tree->get_nodes_ptr();
+
+    if (tree_data == nullptr || old_nodes == nullptr || tree_data->get_nodes_ptr() == nullptr) {
+        spdlog::error("[TreeTransaction] Tree has no nodes to copy from");
+        return false;
+    }
+
+    auto old_datas = (uint8_t*)tree_data->get_nodes_ptr();
+
+    const auto node_stride = tree_node_stride();
+    const auto data_stride = tree_node_data_stride();
+    const auto old_node_count = m_tree->get_node_count();
+    const auto old_data_count = tree_data->get_node_count();
+    const auto num_added = (uint32_t)m_new_node_sources.size();
+
+    // Only copies of nodes that have data get a data slot, so every published slot is written.
+    uint32_t num_added_datas = 0;
+
+    for (const auto source_index : m_new_node_sources) {
+        num_added_datas += tree_node_at(old_nodes, source_index)->get_data() != nullptr ? 1 : 0;
+    }
+
+    auto new_nodes = (uint8_t*)sdk::memory::allocate(node_stride * (old_node_count + num_added));
+    auto new_datas = (uint8_t*)sdk::memory::allocate(data_stride * (old_data_count + num_added_datas));
+
+    if (new_nodes == nullptr || new_datas == nullptr) {
+        spdlog::error("[TreeTransaction] Failed to allocate {} nodes", old_node_count + num_added);
+
+        if (new_nodes != nullptr) {
+            sdk::memory::deallocate(new_nodes);
+        }
+
+        if (new_datas != nullptr) {
+            sdk::memory::deallocate(new_datas);
+        }
+
+        return false;
+    }
+
+    memcpy(new_nodes, old_nodes, node_stride * old_node_count);
+    memcpy(new_datas, old_datas, data_stride * old_data_count);
+
+    // Index of each added node's data in new_datas, UINT32_MAX if it has none.
+    std::vector<uint32_t> added_data_indices(num_added, UINT32_MAX);
+
+    for (uint32_t i = 0, data_index = old_data_count; i < num_added; ++i) {
+        const auto source = tree_node_at(old_nodes, m_new_node_sources[i]);
+        const auto source_data = source->get_data();
+
+        memcpy(tree_node_at(new_nodes, old_node_count + i), source, node_stride);
+
+        if (source_data != nullptr) {
+            auto data = tree_node_data_at(new_datas, data_index);
+
+            memcpy(data, source_data, data_stride);
+            detach_node_arrays(data);
+            added_data_indices[i] = data_index++;
+        }
+    }
+
+    // One pass fixes both moves, including the pointers the copies carried over from their sources.
+    const utility::RelocationRange ranges[]{
+        {(uintptr_t)old_nodes, (uintptr_t)old_nodes + node_stride * old_node_count, (uintptr_t)new_nodes},
+        {(uintptr_t)old_datas, (uintptr_t)old_datas + data_stride * old_data_count, (uintptr_t)new_datas},
+    };
+
+    utility::PointerRelocator relocator{ranges};
+
+    for (uint32_t i = 0; i < old_node_count + num_added; ++i) {
+        relocate_node(tree_node_at(new_nodes, i), relocator);
+    }
+
+    // TreeObject is 0xD8 in both layouts
+    relocator.scan((uint8_t*)m_tree, 1, 0xD8);
+
+    if (m_handle != nullptr) {
+        relocator.scan((uint8_t*)m_handle, 1, sizeof(CoreHandle));
+    }
+
+    relocator.log_summary("TreeTransaction");
+
+    for (uint32_t i = 0; i < num_added; ++i) {
+        if (added_data_indices[i] != UINT32_MAX) {
+            tree_node_at(new_nodes, old_node_count + i)->set_data(tree_node_data_at(new_datas, added_data_indices[i]));
+        }
+    }
+
+    // The old arrays are left allocated, the engine may still hold pointers into them outside of what was scanned.
+    auto& node_array = m_tree->get_node_array();
+    node_array.elements = (TreeNode*)new_nodes;
+    node_array.num = old_node_count + num_added;
+
+    auto& data_array = tree_data->get_nodes();
+    data_array.elements = (TreeNodeData*)new_datas;
+    data_array.num = old_data_count + num_added_datas;
+
+    return true;
+}
+
+void TreeTransaction::commit_node_edits() {
+    for (auto& [index, edit] : m_node_edits) {
+        const auto node = m_tree->get_node(index);
+        const auto data = node != nullptr ? node->get_data() : nullptr;
+
+        if (data == nullptr) {
+            spdlog::warn("[TreeTransaction] Skipping edits to missing node {}", index);
+            continue;
+        }
+
+        if (!rebuild_array(data->get_actions(), edit.actions.removed, edit.actions.appended) ||
+            !rebuild_array(data->get_conditions(), edit.conditions.removed, edit.conditions.appended))
+        {
+            spdlog::error("[TreeTransaction] Failed to edit node {}", index);
+        }
+    }
 }
 }
 }
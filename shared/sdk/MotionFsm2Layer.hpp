@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "REString.hpp"
@@ -155,6 +158,10 @@ public:
         return *(sdk::behaviortree::TreeNodeData**)((uintptr_t)this + 0x8);
     }
 
+    void set_data(sdk::behaviortree::TreeNodeData* data) {
+        *(sdk::behaviortree::TreeNodeData**)((uintptr_t)this + 0x8) = data;
+    }
+
     sdk::behaviortree::TreeObject* get_owner() const {
         return *(sdk::behaviortree::TreeObject**)((uintptr_t)this + 0x10);
     }
@@ -325,9 +332,14 @@ private:
 // Size is 0xD8 in both layouts. Differences:
 //   selectors: re3=0x24, tdb71=0x20
 //   root_node: re3=0xA0, tdb71=0xC0
+class ResolvedTreeObject;
+
 class TreeObject {
 public:
     bool is_delayed() const;
+
+    // Evaluates the delay state once. Prefer this over get_action/get_condition/get_transition when looking up many objects.
+    ResolvedTreeObject resolve() const;
     void relocate(uintptr_t old_start, uintptr_t old_end, sdk::NativeArrayNoCapacity<TreeNode>& new_nodes);
     void relocate_datas(uintptr_t old_start, uintptr_t old_end, sdk::NativeArrayNoCapacity<TreeNodeData>& new_nodes);
 
@@ -517,6 +529,43 @@ private:
     TreeObject& operator=(const TreeObject&) = delete;
 };
 
+// A TreeObject's action, condition and transition arrays with the delay state already evaluated.
+// Lookups are plain bounds checked array reads. Resolve again after the tree's arrays are edited.
+class ResolvedTreeObject {
+public:
+    ResolvedTreeObject(const TreeObject* tree);
+
+    const TreeObject* get_tree() const { return m_tree; }
+    bool is_delayed() const { return m_delayed; }
+
+    // The arrays indices without bit 30 set refer to.
+    std::span<::REManagedObject* const> get_actions() const { return m_actions; }
+    std::span<::REManagedObject* const> get_conditions() const { return m_conditions; }
+    std::span<::REManagedObject* const> get_transitions() const { return m_transitions; }
+
+    ::REManagedObject* get_action(uint32_t index) const;
+    ::REManagedObject* get_condition(int32_t index) const;
+    ::REManagedObject* get_transition(int32_t index) const;
+
+    // Append to out so callers walking many nodes can reuse one vector.
+    void collect_actions(const TreeNode* node, std::vector<::REManagedObject*>& out) const;
+    void collect_conditions(const TreeNode* node, std::vector<::REManagedObject*>& out) const;
+    void collect_transition_conditions(const TreeNode* node, std::vector<::REManagedObject*>& out) const;
+    void collect_transition_events(const TreeNode* node, std::vector<::REManagedObject*>& out) const;
+
+private:
+    const TreeObject* m_tree{};
+    bool m_delayed{false};
+
+    std::span<::REManagedObject* const> m_actions{};
+    std::span<::REManagedObject* const> m_conditions{};
+    std::span<::REManagedObject* const> m_transitions{};
+
+    std::span<::REManagedObject* const> m_static_actions{};
+    std::span<::REManagedObject* const> m_static_conditions{};
+    std::span<::REManagedObject* const> m_static_transitions{};
+};
+
 class CoreHandle : public regenny::via::behaviortree::CoreHandle {
 public:
     sdk::behaviortree::TreeObject* get_tree_object() const {
@@ -527,6 +576,66 @@ public:
     void relocate_datas(uintptr_t old_start, uintptr_t old_end, sdk::NativeArrayNoCapacity<TreeNodeData>& new_nodes);
 };
 
+// Stages edits to a tree and applies them in one go. Every array that grows is reallocated once,
+// and moving the node and node data arrays is followed by a single relocation pass over both.
+// Nodes are referred to by index, since commit() moves them.
+class TreeTransaction {
+public:
+    TreeTransaction(TreeObject* tree, CoreHandle* handle = nullptr);
+
+    // Appended to the active (delayed or not) array. The returned index is valid in node edits of the same transaction.
+    // The objects are not add_ref'd, the caller is responsible for keeping them alive.
+    uint32_t add_action(::REManagedObject* action);
+    int32_t add_condition(::REManagedObject* condition);
+    int32_t add_transition(::REManagedObject* transition);
+
+    // Appends a copy of an existing node, returns the new node's index. The copy keeps the source's ID, name and parent.
+    // If the source has node data, the copy gets its own copy of it with every index array emptied (children, actions,
+    // conditions, states, start states and transitions, transition arrays). Only the tags array is shared with the source.
+    std::optional<uint32_t> add_node(uint32_t source_index);
+
+    // Positions refer to the node's arrays as they were before the transaction.
+    void append_node_action(uint32_t node_index, uint32_t action_index);
+    void remove_node_action(uint32_t node_index, uint32_t position);
+    void append_node_condition(uint32_t node_index, int32_t condition_index);
+    void remove_node_condition(uint32_t node_index, uint32_t position);
+
+    bool empty() const;
+
+    // Applies everything staged and clears it. If the new nodes can't be allocated nothing is applied and false is returned.
+    bool commit();
+
+private:
+    template<typename T>
+    struct ArrayEdit {
+        std::vector<T> appended{};
+        std::vector<uint32_t> removed{};
+    };
+
+    struct NodeEdit {
+        ArrayEdit<uint32_t> actions{};
+        ArrayEdit<int32_t> conditions{};
+    };
+
+    bool commit_nodes();
+    void commit_node_edits();
+
+    TreeObject* m_tree{};
+    CoreHandle* m_handle{};
+    bool m_delayed{false};
+
+    uint32_t m_base_node_count{0};
+    uint32_t m_base_action_count{0};
+    uint32_t m_base_condition_count{0};
+    uint32_t m_base_transition_count{0};
+
+    std::vector<uint32_t> m_new_node_sources{};
+    std::vector<::REManagedObject*> m_new_actions{};
+    std::vector<::REManagedObject*> m_new_conditions{};
+    std::vector<::REManagedObject*> m_new_transitions{};
+    std::map<uint32_t, NodeEdit> m_node_edits{};
+};
+
 class BehaviorTree : public regenny::via::behaviortree::BehaviorTree {
 public:
     // Called by vtable index 11 or 12?
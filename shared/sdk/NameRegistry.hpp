@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <utility/Fnv1a.hpp>
+
+namespace sdk {
+// Name -> value lookup table for registries that are read far more often than they change
+// (singleton maps, native singleton lists).
+//
+// The table is an immutable snapshot published through an atomic pointer, so readers never lock:
+// a lookup is a hash plus a short linear probe. Writers build a new snapshot and only publish it
+// if the contents changed. Readers pin the snapshot they loaded by bumping a reader count, replaced snapshots
+// are freed by the next writer (or collect()) that sees no active readers.
+//
+// Misses can be remembered in a small direct-mapped negative cache so callers asking for names that
+// don't exist yet don't trigger a full refresh on every call.
+template <typename T>
+class NameRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t NEGATIVE_CACHE_SIZE = 256;
+
+    static constexpr uint64_t hash(std::string_view name) {
+        return utility::fnv1a::hash64(name);
+    }
+
+    class Snapshot {
+    public:
+        const T* find(std::string_view name) const {
+            return find(name, hash(name));
+        }
+
+        const T* find(std::string_view name, uint64_t h) const {
+            if (m_slots.empty()) {
+                return nullptr;
+            }
+
+            const auto mask = m_slots.size() - 1;
+
+            for (auto i = (size_t)h & mask;; i = (i + 1) & mask) {
+                const auto& slot = m_slots[i];
+
+                if (slot.index == EMPTY) {
+                    return nullptr;
+                }
+
+                if (slot.hash == h && m_names[slot.index] == name) {
+                    return &m_values[slot.index];
+                }
+            }
+        }
+
+        bool empty() const {
+            return m_values.empty();
+        }
+
+        size_t size() const {
+            return m_values.size();
+        }
+
+        // In publish order, including duplicate names.
+        const std::vector<T>& values() const {
+            return m_values;
+        }
+
+        const std::vector<std::string>& names() const {
+            return m_names;
+        }
+
+        uint64_t generation() const {
+            return m_generation;
+        }
+
+    private:
+        friend class NameRegistry;
+
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+
+        struct Slot {
+            uint64_t hash{};
+            uint32_t index{EMPTY};
+        };
+
+        void build_index() {
+            size_t capacity = 16;
+
+            while (capacity < m_names.size() * 2) {
+                capacity *= 2;
+            }
+
+            m_slots.assign(capacity, Slot{});
+
+            const auto mask = capacity - 1;
+
+            for (uint32_t index = 0; index < m_names.size(); ++index) {
+                const auto h = hash(m_names[index]);
+
+                for (auto i = (size_t)h & mask;; i = (i + 1) & mask) {
+                    auto& slot = m_slots[i];
+
+                    if (slot.index == EMPTY) {
+                        slot = {h, index};
+                        break;
+                    }
+
+                    // Later entries with the same name win, same as map assignment.
+                    if (slot.hash == h && m_names[slot.index] == m_names[index]) {
+                        slot.index = index;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<std::string> m_names{};
+        std::vector<T> m_values{};
+        std::vector<Slot> m_slots{};
+        uint64_t m_generation{0};
+    };
+
+    // Keeps the snapshot that was current when it was taken alive until it goes out of scope.
+    class Reader {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        ~Reader() {
+            m_owner->m_active_readers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        const Snapshot& operator*() const {
+            return *m_snapshot;
+        }
+
+        const Snapshot* operator->() const {
+            return m_snapshot;
+        }
+
+    private:
+        friend class NameRegistry;
+
+        Reader(const NameRegistry* owner, const Snapshot* snapshot) : m_owner{owner}, m_snapshot{snapshot} {}
+
+        const NameRegistry* m_owner;
+        const Snapshot* m_snapshot;
+    };
+
+    NameRegistry() {
+        m_current.store(new Snapshot{}, std::memory_order_release);
+    }
+
+    NameRegistry(const NameRegistry&) = delete;
+    NameRegistry& operator=(const NameRegistry&) = delete;
+
+    ~NameRegistry() {
+        delete m_current.load(std::memory_order_acquire);
+    }
+
+    // Don't hold on to the reader longer than needed, nothing retired after it was taken can be freed until it's gone.
+    Reader snapshot() const {
+        // The reader count has to be visible before the snapshot is loaded, see try_reclaim_locked.
+        m_active_readers.fetch_add(1, std::memory_order_seq_cst);
+        return Reader{this, m_current.load(std::memory_order_seq_cst)};
+    }
+
+    std::optional<T> find(std::string_view name) const {
+        return find(name, hash(name));
+    }
+
+    std::optional<T> find(std::string_view name, uint64_t h) const {
+        const auto reader = snapshot();
+
+        if (const auto value = reader->find(name, h); value != nullptr) {
+            return *value;
+        }
+
+        return std::nullopt;
+    }
+
+    bool empty() const {
+        return snapshot()->empty();
+    }
+
+    std::vector<T> values() const {
+        return snapshot()->values();
+    }
+
+    uint64_t generation() const {
+        return snapshot()->generation();
+    }
+
+    // Publishes a new snapshot if it differs from the current one. Returns true if it did.
+    bool publish(std::vector<std::pair<std::string, T>>&& entries) {
+        std::scoped_lock _{m_write_mutex};
+
+        const auto& current = *m_current.load(std::memory_order_relaxed);
+
+        if (current.m_names.size() == entries.size()) {
+            bool same = true;
+
+            for (size_t i = 0; i < entries.size() && same; ++i) {
+                same = current.m_names[i] == entries[i].first && current.m_values[i] == entries[i].second;
+            }
+
+            if (same) {
+                try_reclaim_locked();
+                return false;
+            }
+        }
+
+        auto next = new Snapshot{};
+        next->m_names.reserve(entries.size());
+        next->m_values.reserve(entries.size());
+
+        for (auto& [name, value] : entries) {
+            next->m_names.push_back(std::move(name));
+            next->m_values.push_back(std::move(value));
+        }
+
+        next->build_index();
+        next->m_generation = current.m_generation + 1;
+
+        m_retired.emplace_back(m_current.exchange(next, std::memory_order_seq_cst));
+        try_reclaim_locked();
+
+        clear_missing();
+
+        return true;
+    }
+
+    bool is_known_missing(uint64_t h, Clock::time_point now = Clock::now()) const {
+        const auto& entry = m_missing[h % NEGATIVE_CACHE_SIZE];
+
+        return entry.hash.load(std::memory_order_acquire) == h &&
+               now.time_since_epoch().count() < entry.until.load(std::memory_order_relaxed);
+    }
+
+    void mark_missing(uint64_t h, Clock::duration ttl, Clock::time_point now = Clock::now()) {
+        auto& entry = m_missing[h % NEGATIVE_CACHE_SIZE];
+
+        entry.until.store((now + ttl).time_since_epoch().count(), std::memory_order_relaxed);
+        entry.hash.store(h, std::memory_order_release);
+    }
+
+    void clear_missing() {
+        for (auto& entry : m_missing) {
+            entry.hash.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Frees retired snapshots if no reader is active. publish() already does this.
+    void collect() {
+        std::scoped_lock _{m_write_mutex};
+        try_reclaim_locked();
+    }
+
+    size_t get_num_retired() {
+        std::scoped_lock _{m_write_mutex};
+        return m_retired.size();
+    }
+
+private:
+    void try_reclaim_locked() {
+        // A reader that could still see a retired snapshot incremented m_active_readers before the snapshot
+        // was replaced. Readers that start after this check can only load the current one.
+        if (!m_retired.empty() && m_active_readers.load(std::memory_order_seq_cst) == 0) {
+            m_retired.clear();
+        }
+    }
+
+    struct MissingEntry {
+        std::atomic<uint64_t> hash{0};
+        std::atomic<Clock::rep> until{0};
+    };
+
+    std::atomic<const Snapshot*> m_current{nullptr};
+    mutable std::atomic<uint32_t> m_active_readers{0};
+
+    std::mutex m_write_mutex{};
+    std::vector<std::unique_ptr<const Snapshot>> m_retired{};
+
+    std::array<MissingEntry, NEGATIVE_CACHE_SIZE> m_missing{};
+};
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "RENativeArray.hpp"
+
+// Batched edits to engine arrays, each growing the array with at most one allocation.
+// NativeArrayNoCapacity::push_back reallocates on every call, so edits that add many elements go through these.
+namespace sdk {
+// Removes the given positions and appends the new elements. removed is sorted and deduplicated in place.
+template<typename T>
+bool rebuild_array(NativeArrayNoCapacity<T>& arr, std::vector<uint32_t>& removed, const std::vector<T>& appended) {
+    std::sort(removed.begin(), removed.end());
+    removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+    const auto old_size = arr.elements != nullptr ? (uint32_t)arr.size() : 0;
+    const auto num_removed = (uint32_t)(std::lower_bound(removed.begin(), removed.end(), old_size) - removed.begin());
+    const auto new_size = old_size - num_removed + (uint32_t)appended.size();
+
+    if (num_removed == 0 && appended.empty()) {
+        return true;
+    }
+
+    // Shrinking only, compact in place.
+    auto new_elements = appended.empty() ? arr.elements : (T*)sdk::memory::allocate(sizeof(T) * new_size);
+
+    if (new_elements == nullptr) {
+        return false;
+    }
+
+    uint32_t j = 0;
+    auto next_removed = removed.begin();
+
+    for (uint32_t i = 0; i < old_size; ++i) {
+        if (next_removed != removed.end() && *next_removed == i) {
+            ++next_removed;
+            continue;
+        }
+
+        new_elements[j++] = arr.elements[i];
+    }
+
+    for (const auto& value : appended) {
+        new_elements[j++] = value;
+    }
+
+    if (new_elements != arr.elements && arr.elements != nullptr) {
+        sdk::memory::deallocate(arr.elements);
+    }
+
+    arr.elements = new_elements;
+    arr.num = new_size;
+
+    return true;
+}
+
+// Appends to an array with a capacity, reallocating only if it doesn't fit.
+template<typename T>
+bool append_all(NativeArray<T>& arr, const std::vector<T>& appended) {
+    if (appended.empty()) {
+        return true;
+    }
+
+    const auto new_size = arr.num + (uint32_t)appended.size();
+
+    if (arr.elements == nullptr || new_size > arr.num_allocated) {
+        auto new_elements = (T*)sdk::memory::allocate(sizeof(T) * new_size);
+
+        if (new_elements == nullptr) {
+            return false;
+        }
+
+        if (arr.elements != nullptr) {
+            std::copy_n(arr.elements, arr.num, new_elements);
+            sdk::memory::deallocate(arr.elements);
+        }
+
+        arr.elements = new_elements;
+        arr.num_allocated = new_size;
+    }
+
+    std::copy(appended.begin(), appended.end(), arr.elements + arr.num);
+    arr.num = new_size;
+
+    return true;
+}
+}
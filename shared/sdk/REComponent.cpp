@@ -0,0 +1,77 @@
+#include <vector>
+
+#include "RETypeDB.hpp"
+
+#include "REComponent.hpp"
+
+REComponent* REComponent::find_component(std::string_view name) const {
+    if (auto t = sdk::find_type_definition(name); t != nullptr) {
+        return find_component(t);
+    }
+
+    // Not in the TDB (native-only type names), compare the REType names instead.
+    for (auto child = get_child_component(); child != nullptr && child != this; child = child->get_child_component()) {
+        if (child->is_a(name)) {
+            return child;
+        }
+    }
+
+    return nullptr;
+}
+
+REComponent* REComponent::find_component(const sdk::RETypeDefinition* t) const {
+    if (t == nullptr) {
+        return nullptr;
+    }
+
+    for (auto child = get_child_component(); child != nullptr && child != this; child = child->get_child_component()) {
+        const auto child_t = child->get_type_definition();
+
+        if (child_t != nullptr && child_t->is_a(t)) {
+            return child;
+        }
+    }
+
+    return nullptr;
+}
+
+void REComponent::find_components(std::span<REGameObject* const> game_objects, const sdk::RETypeDefinition* t, std::span<REComponent*> out) {
+    // Most objects in a batch share a handful of component types, remember which ones matched.
+    std::vector<std::pair<const sdk::RETypeDefinition*, bool>> checked{};
+
+    auto matches = [&](const sdk::RETypeDefinition* child_t) {
+        for (const auto& [checked_t, result] : checked) {
+            if (checked_t == child_t) {
+                return result;
+            }
+        }
+
+        const auto result = child_t != nullptr && child_t->is_a(t);
+        checked.emplace_back(child_t, result);
+
+        return result;
+    };
+
+    for (size_t i = 0; i < game_objects.size() && i < out.size(); ++i) {
+        out[i] = nullptr;
+
+        const auto game_object = game_objects[i];
+
+        if (game_object == nullptr || t == nullptr) {
+            continue;
+        }
+
+        const auto transform = (REComponent*)game_object->get_transform();
+
+        if (transform == nullptr) {
+            continue;
+        }
+
+        for (auto child = transform->get_child_component(); child != nullptr && child != transform; child = child->get_child_component()) {
+            if (matches(child->get_type_definition())) {
+                out[i] = child;
+                break;
+            }
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include "RETypeDB.hpp"
 
 #include "REGameObject.hpp"
+#include "GameObjectNames.hpp"
 
 #include "GameIdentity.hpp"
 
@@ -58,13 +59,21 @@ SystemString* REGameObject::get_name_field() const {
     return *(SystemString**)((uintptr_t)this + go_transform_offset() + sizeof(void*) * 2);
 }
 
-std::string REGameObject::get_name() const {
-    if (this == nullptr) {
-        return {};
+// TDB 69+ games store the name as a SystemString* after the folder, older ones embed an REString there.
+static bool go_name_field_known() {
+    static const auto known = sdk::GameIdentity::get().tdb_ver() >= 69;
+    return known;
+}
+
+SystemString* REGameObject::get_name_string() const {
+    // Read the field directly where the layout is known, this is called for every object
+    // name lookup and a VM call costs far more than the load.
+    if (go_name_field_known()) {
+        if (auto str = get_name_field(); str != nullptr) {
+            return str;
+        }
     }
 
-    // Only doing this on newer versions where we know it works
-    // Haven't tested it on older versions so just to be safe.
     static const auto game_object_t = sdk::find_type_definition("via.GameObject");
     static const auto get_name_fn = game_object_t != nullptr ? game_object_t->get_method("get_Name") : nullptr;
 
@@ -72,11 +81,22 @@ std::string REGameObject::get_name() const {
         auto str = get_name_fn->call<::SystemString*>(sdk::get_thread_context(), const_cast<REGameObject*>(this));
 
         if (str != nullptr) {
-            return utility::re_string::get_string(str);
+            return str;
         }
     }
 
-    // We rely on the reflected function first because
-    // this offset might change between versions.
-    return utility::re_string::get_string(get_name_field());
-}
\ No newline at end of file
+    // Older versions only fall back to the field, the offset hasn't been verified there.
+    return get_name_field();
+}
+
+std::string REGameObject::get_name() const {
+    if (this == nullptr) {
+        return {};
+    }
+
+    return sdk::GameObjectNames::get().get_name(this);
+}
+
+size_t REGameObject::get_name_hash() const {
+    return sdk::GameObjectNames::get().get_name_hash(this);
+}
@@ -171,6 +171,17 @@ REGlobals::REGlobals() {
         }
     }
 
+    {
+        std::vector<std::pair<std::string, Getter>> getters{};
+        getters.reserve(m_getters.size());
+
+        for (const auto& [name, getter] : m_getters) {
+            getters.emplace_back(name, getter);
+        }
+
+        m_getter_registry.publish(std::move(getters));
+    }
+
     spdlog::info("Found {} REGlobals", m_object_list.size());
     spdlog::info("Found {} getters", m_getters.size());
 
@@ -200,64 +211,78 @@ std::unordered_set<REManagedObject*> REGlobals::get_objects() {
 }
 
 REType* REGlobals::get_native(std::string_view name) {
-    std::lock_guard _{ m_map_mutex };
-
-    if (m_native_singleton_types.empty()) {
-        refresh_natives();
+    if (m_native_registry.empty()) {
+        safe_refresh_native();
     }
 
-    auto it = m_native_singleton_map.find(name.data());
-
-    if (it == m_native_singleton_map.end()) {
-        refresh_natives();
+    const auto hash = decltype(m_native_registry)::hash(name);
 
-        it = m_native_singleton_map.find(name.data());
+    if (auto t = m_native_registry.find(name, hash)) {
+        return *t;
     }
 
-    if (it == m_native_singleton_map.end()) {
+    if (m_native_registry.is_known_missing(hash)) {
         return nullptr;
     }
 
-    return it->second;
+    safe_refresh_native();
+
+    if (auto t = m_native_registry.find(name, hash)) {
+        return *t;
+    }
+
+    m_native_registry.mark_missing(hash, MISSING_TTL);
+    return nullptr;
 }
 
-std::vector<::REType*>& REGlobals::get_native_singleton_types() {
-    if (m_native_singleton_types.empty()) {
-        refresh_natives();
+std::vector<::REType*> REGlobals::get_native_singleton_types() {
+    if (m_native_registry.empty()) {
+        safe_refresh_native();
     }
 
-    return m_native_singleton_types;
+    return m_native_registry.values();
 }
 
 REManagedObject* REGlobals::get(std::string_view name) {
-    std::lock_guard _{ m_map_mutex };
+    const auto hash = decltype(m_object_registry)::hash(name);
 
     auto get_obj = [&]() -> REManagedObject* {
-        if (m_object_map.empty()) {
-            auto getter = m_getters.find(name.data());
+        const auto objects = m_object_registry.snapshot();
 
-            if (getter != m_getters.end()) {
-                return getter->second();
+        if (objects->empty()) {
+            if (auto getter = m_getter_registry.find(name, hash)) {
+                return (*getter)();
             }
         }
 
-        if (auto it = m_object_map.find(name.data()); it != m_object_map.end()) {
-            return *it->second;
+        if (auto obj_ptr = objects->find(name, hash); obj_ptr != nullptr) {
+            return **obj_ptr;
         }
 
         return nullptr;
     };
 
-    auto obj = get_obj();
+    if (auto obj = get_obj(); obj != nullptr) {
+        return obj;
+    }
+
+    // Don't walk every global again if we just failed to find this one.
+    if (m_object_registry.is_known_missing(hash)) {
+        return nullptr;
+    }
 
     // try to refresh the map if the object doesnt exist.
     // assume the user knows this object exists.
+    safe_refresh();
+
+    // try again after refreshing the map
+    auto obj = get_obj();
+
     if (obj == nullptr) {
-        refresh_map();
+        m_object_registry.mark_missing(hash, MISSING_TTL);
     }
 
-    // try again after refreshing the map
-    return obj == nullptr ? get_obj() : obj;
+    return obj;
 }
 
 REManagedObject* REGlobals::operator[](std::string_view name) {
@@ -277,7 +302,7 @@ void REGlobals::safe_refresh_native() {
 void REGlobals::refresh_natives() {
     auto& types = reframework::get_types()->get_types();
 
-    m_native_singleton_types.clear();
+    std::vector<std::pair<std::string, ::REType*>> native_singletons{};
 
     for (auto t : types) {
         if (t == nullptr) {
@@ -288,13 +313,14 @@ void REGlobals::refresh_natives() {
             continue;
         }
 
-        m_native_singleton_types.push_back(t);
-        m_native_singleton_map[t->get_type_name()] = t;
+        native_singletons.emplace_back(t->get_type_name(), t);
     }
 
-    std::sort(m_native_singleton_types.begin(), m_native_singleton_types.end(), [](auto a, auto b) {
-        return std::string{ a->get_type_name() } < std::string{ b->get_type_name() };
+    std::stable_sort(native_singletons.begin(), native_singletons.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
     });
+
+    m_native_registry.publish(std::move(native_singletons));
 }
 
 void REGlobals::refresh_map() {
@@ -325,4 +351,11 @@ void REGlobals::refresh_map() {
 
         m_object_map[t->get_type_name()] = obj_ptr;
     }
+
+    std::vector<std::pair<std::string, REManagedObject**>> objects{m_object_map.begin(), m_object_map.end()};
+
+    // Keep the order stable so an unchanged map doesn't publish a new snapshot.
+    std::sort(objects.begin(), objects.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    m_object_registry.publish(std::move(objects));
 }
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "ReClass.hpp"
+#include "NameRegistry.hpp"
 
 // A list of globals in the RE engine (singletons?)
 class REGlobals {
@@ -21,7 +22,7 @@ public:
     std::unordered_set<REManagedObject*> get_objects();
 
     REType* get_native(std::string_view name);
-    std::vector<::REType*>& get_native_singleton_types();
+    std::vector<::REType*> get_native_singleton_types();
 
     // Equivalent
     REManagedObject* get(std::string_view name);
@@ -37,22 +38,30 @@ public:
     void safe_refresh_native();
 
 private:
+    using Getter = REManagedObject* (*)();
+
+    // How long a failed lookup is remembered before it's allowed to trigger another refresh.
+    static constexpr auto MISSING_TTL = std::chrono::milliseconds{500};
+
     void refresh_natives();
     void refresh_map();
 
     // Class name to object like "app.foo.bar" -> 0xDEADBEEF
+    // Only touched by writers under m_map_mutex, readers go through m_object_registry.
     std::unordered_map<std::string, REManagedObject**> m_object_map;
 
     // Raw list of objects (for if the type hasn't been fully initialized, we need to refresh the map)
     std::unordered_set<REManagedObject**> m_objects;
     std::unordered_set<REManagedObject**> m_object_list;
-    std::unordered_map<std::string, std::function<REManagedObject* ()>> m_getters;
+    std::unordered_map<std::string, Getter> m_getters;
 
     // List of objects we've already logged
     std::unordered_set<REManagedObject**> m_acknowledged_objects;
 
-    std::vector<::REType*> m_native_singleton_types{};
-    std::unordered_map<std::string, ::REType*> m_native_singleton_map{};
+    // Lock-free read side, republished whenever a refresh changes anything.
+    sdk::NameRegistry<REManagedObject**> m_object_registry{};
+    sdk::NameRegistry<Getter> m_getter_registry{};
+    sdk::NameRegistry<::REType*> m_native_registry{};
 
     std::mutex m_map_mutex{};
 };
@@ -1,3 +1,7 @@
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <spdlog/spdlog.h>
 
 #include "utility/Scan.hpp"
@@ -6,6 +10,8 @@
 #include "ReClass.hpp"
 
 #include "REManagedObject.hpp"
+#include "RETypeCLR.hpp"
+#include "RSZLayout.hpp"
 #include "GameIdentity.hpp"
 
 #include "RETypeDefDispatch.hpp"
@@ -175,51 +181,193 @@ std::vector<::REManagedObject*> REManagedObject::deserialize(const uint8_t* data
     return result;
 }
 
-void REManagedObject::deserialize_native(const uint8_t* data, size_t size, const std::vector<::REManagedObject*>& objects) {
-    if (!is_managed_object(this)) {
-        return;
+namespace {
+struct DeserializeStream {
+    uint8_t* head{nullptr};
+    uint8_t* cur{nullptr};
+    uint8_t* tail{nullptr};
+    uintptr_t stackptr{0};
+    uint8_t* stack[32]{0};
+}; static_assert(sizeof(DeserializeStream) == 0x120, "DeserializeStream is not the correct size");
+
+using NativeDeserializer = void (*)(::REManagedObject*, DeserializeStream*, sdk::NativeArray<::REManagedObject*>* objects);
+
+NativeDeserializer get_native_deserializer(::REManagedObject* obj) {
+    if (!REManagedObject::is_managed_object(obj)) {
+        return nullptr;
     }
 
-    const auto tdef = get_type_definition();
+    const auto tdef = obj->get_type_definition();
 
     if (tdef == nullptr) {
-        return;
+        return nullptr;
     }
 
     const auto t = tdef->get_type();
 
     if (t == nullptr || get_fields(t) == nullptr || get_fields(t)->get_deserializer() == nullptr) {
-        return;
+        return nullptr;
     }
 
-    struct DeserializeStream {
-        uint8_t* head{nullptr};
-        uint8_t* cur{nullptr};
-        uint8_t* tail{nullptr};
-        uintptr_t stackptr{0};
-        uint8_t* stack[32]{0};
-    }; static_assert(sizeof(DeserializeStream) == 0x120, "DeserializeStream is not the correct size");
+    return (NativeDeserializer)get_fields(t)->get_deserializer();
+}
+
+// Runs the engine deserializer on data + pos, returns the stream position it stopped at.
+std::optional<size_t> run_native_deserializer(::REManagedObject* obj, const uint8_t* data, size_t size, size_t pos, sdk::NativeArray<::REManagedObject*>& objects) {
+    const auto deserializer = get_native_deserializer(obj);
 
-    const auto deserializer = (void (*)(::REManagedObject*, DeserializeStream*, sdk::NativeArray<REManagedObject*>* objects))get_fields(t)->get_deserializer();
+    if (deserializer == nullptr) {
+        return std::nullopt;
+    }
 
     std::array<uint8_t, 1024 * 8> stack_buffer{};
 
     DeserializeStream stream{
         .head = (uint8_t*)data,
-        .cur = (uint8_t*)data,
+        .cur = (uint8_t*)data + pos,
         .tail = (uint8_t*)data + size,
         .stackptr = (uintptr_t)stack_buffer.data() // No need to set the "stack" variable, it seems to get filled by the stackptr
     };
 
+    deserializer(obj, &stream, &objects);
+
+    return (size_t)(stream.cur - stream.head);
+}
+
+// Layout plans are per type and never change, nullptr means the type needs the engine deserializer.
+std::shared_mutex g_rsz_layout_mtx{};
+std::unordered_map<const sdk::RETypeDefinition*, std::unique_ptr<sdk::RSZLayout>> g_rsz_layouts{};
+
+std::unique_ptr<sdk::RSZLayout> compile_rsz_layout(const sdk::RETypeDefinition* tdef) {
+#if TDB_VER <= 49
+    return nullptr; // No size/align in the sequences, and the typecode tables don't cover structs.
+#else
+    // Same for RE7 in the universal build, where this is compiled in regardless.
+    if (sdk::GameIdentity::get().tdb_ver() <= 49) {
+        return nullptr;
+    }
+
+    const auto t = tdef->get_type();
+
+    if (t == nullptr || !utility::re_type::is_clr_type(t)) {
+        return nullptr;
+    }
+
+    const auto& sequences = ((sdk::RETypeCLR*)t)->get_deserializers();
+
+    if (sequences.empty()) {
+        return nullptr;
+    }
+
+    std::vector<sdk::RSZLayout::Sequence> plan_sequences{};
+
+    for (const auto& sequence : sequences) {
+        if (sequence.is_array() || sequence.is_static()) {
+            return nullptr;
+        }
+
+        // Strings, objects and resources are indirections the engine has to resolve.
+        const auto native_type = sequence.get_native_type();
+
+        if (native_type == nullptr || native_type->get_vm_obj_type() != via::clr::VMObjType::ValType) {
+            return nullptr;
+        }
+
+        plan_sequences.push_back({
+            (uint8_t)sequence.get_code(),
+            (uint8_t)sequence.get_depth(),
+            sequence.get_offset(),
+            sequence.get_size(),
+            sequence.get_align()
+        });
+    }
+
+    if (auto layout = sdk::RSZLayout::compile_sequences(plan_sequences); layout) {
+        return std::make_unique<sdk::RSZLayout>(std::move(*layout));
+    }
+
+    return nullptr;
+#endif
+}
+
+const sdk::RSZLayout* get_rsz_layout(const sdk::RETypeDefinition* tdef) {
+    if (tdef == nullptr) {
+        return nullptr;
+    }
+
+    {
+        std::shared_lock _{g_rsz_layout_mtx};
+
+        if (auto it = g_rsz_layouts.find(tdef); it != g_rsz_layouts.end()) {
+            return it->second.get();
+        }
+    }
+
+    auto layout = compile_rsz_layout(tdef);
+
+    std::unique_lock _{g_rsz_layout_mtx};
+    return g_rsz_layouts.try_emplace(tdef, std::move(layout)).first->second.get();
+}
+}
+
+void REManagedObject::deserialize_native(const uint8_t* data, size_t size, const std::vector<::REManagedObject*>& objects) {
     sdk::NativeArray<::REManagedObject*> objects_array;
 
-    if (!objects.empty()) {
-        for (auto object : objects) {
-            objects_array.push_back(object);
+    for (auto object : objects) {
+        objects_array.push_back(object);
+    }
+
+    run_native_deserializer(this, data, size, 0, objects_array);
+}
+
+size_t REManagedObject::deserialize_batch(const uint8_t* data, size_t size, std::span<::REManagedObject* const> objects, const std::vector<::REManagedObject*>& references) {
+    sdk::NativeArray<::REManagedObject*> references_array;
+
+    for (auto object : references) {
+        references_array.push_back(object);
+    }
+
+    std::vector<uint8_t*> dsts{};
+    size_t pos = 0;
+
+    for (size_t i = 0; i < objects.size();) {
+        const auto object = objects[i];
+
+        if (!is_managed_object(object)) {
+            return pos;
+        }
+
+        const auto tdef = object->get_type_definition();
+
+        if (const auto layout = get_rsz_layout(tdef); layout != nullptr) {
+            // Decode the whole run of same-typed objects at once.
+            dsts.clear();
+
+            for (; i < objects.size() && is_managed_object(objects[i]) && objects[i]->get_type_definition() == tdef; ++i) {
+                dsts.push_back((uint8_t*)objects[i]->get_field_ptr());
+            }
+
+            const auto next = layout->decode_batch(data, size, pos, dsts);
+
+            if (!next) {
+                return pos;
+            }
+
+            pos = *next;
+            continue;
+        }
+
+        const auto next = run_native_deserializer(object, data, size, pos, references_array);
+
+        if (!next || *next > size) {
+            return pos;
         }
+
+        pos = *next;
+        ++i;
     }
 
-    deserializer(this, &stream, &objects_array);
+    return pos;
 }
 
 bool REManagedObject::is_managed_object(void* address) {
@@ -344,6 +492,13 @@ std::string REManagedObject::get_type_name() const {
 }
 
 bool REManagedObject::is_a(std::string_view name) const {
+    // Resolve the name once and compare type definitions (constant time) when possible.
+    if (const auto tdef = get_type_definition(); tdef != nullptr) {
+        if (const auto cmp = sdk::find_type_definition(name); cmp != nullptr) {
+            return tdef->is_a(cmp);
+        }
+    }
+
     for (auto t = get_type(); t != nullptr && t->get_type_name() != nullptr; t = get_super(t)) {
         if (name == t->get_type_name()) {
             return true;
@@ -354,6 +509,12 @@ bool REManagedObject::is_a(std::string_view name) const {
 }
 
 bool REManagedObject::is_a(REType* cmp) const {
+    if (const auto tdef = get_type_definition(); tdef != nullptr) {
+        if (const auto cmp_tdef = utility::re_type::get_type_definition(cmp); cmp_tdef != nullptr) {
+            return tdef->is_a(cmp_tdef);
+        }
+    }
+
     for (auto t = get_type(); t != nullptr && t->get_type_name() != nullptr; t = get_super(t)) {
         if (cmp == t) {
             return true;
@@ -1,3 +1,7 @@
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <spdlog/spdlog.h>
 #include <utility/Scan.hpp>
 #include <utility/Module.hpp>
@@ -18,8 +22,53 @@ RETypeDB* RETypeDB::get() {
     return vm->get_type_db();
 }
 
+struct TypeNameHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view name) const {
+        return std::hash<std::string_view>{}(name);
+    }
+};
+
 static std::shared_mutex g_tdb_type_mtx{};
-static std::unordered_map<std::string, sdk::RETypeDefinition*> g_tdb_type_map{};
+// Keys point into the interned full name pool, see RETypeDefinition::get_full_name_view.
+static std::unordered_map<std::string_view, sdk::RETypeDefinition*, TypeNameHash, std::equal_to<>> g_tdb_type_map{};
+static std::atomic<bool> g_tdb_type_map_populated{false};
+
+static std::shared_mutex g_tdb_generic_mtx{};
+// Hash of (definition index, argument indices) -> instantiation, collisions are resolved against the generic data.
+static std::unordered_multimap<uint64_t, sdk::RETypeDefinition*> g_tdb_generic_map{};
+static std::atomic<bool> g_tdb_generic_map_populated{false};
+
+static uint64_t hash_generic_instance(uint32_t definition_index, std::span<const uint32_t> argument_indices) {
+    uint64_t hash = (uint64_t)definition_index * 0x9E3779B97F4A7C15;
+
+    for (const auto index : argument_indices) {
+        hash = (hash ^ index) * 0x100000001B3;
+    }
+
+    return hash ^ (hash >> 29);
+}
+
+static bool is_generic_instance_of(sdk::RETypeDefinition* t, uint32_t definition_index, std::span<const uint32_t> argument_indices) {
+    const auto generics = t->get_generic_data();
+
+    if (generics == nullptr || sdk::generic_list_accessor::get_definition_typeid(generics) != definition_index) {
+        return false;
+    }
+
+    if (sdk::generic_list_accessor::get_num(generics) != argument_indices.size()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < argument_indices.size(); ++i) {
+        if (sdk::generic_list_accessor::get_type_at(generics, i) != argument_indices[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
 
 reframework::InvokeRet invoke_object_func(void* obj, sdk::RETypeDefinition* t, std::string_view name, std::vector<void*>& args) {
     const auto method = t->get_method(name);
@@ -57,39 +106,99 @@ sdk::REModule* RETypeDB::get_module(uint32_t index) const {
 }
 
 sdk::RETypeDefinition* RETypeDB::find_type(std::string_view name) const {
-    static bool map_populated = false;
-
-    {
-        std::shared_lock _{ g_tdb_type_mtx };
-
-        if (auto it = g_tdb_type_map.find(name.data()); it != g_tdb_type_map.end()) {
+    // The map is never written again once populated, so lookups after that don't need the lock
+    // and don't allocate (heterogeneous lookup by string_view).
+    if (g_tdb_type_map_populated.load(std::memory_order_acquire)) {
+        if (auto it = g_tdb_type_map.find(name); it != g_tdb_type_map.end()) {
             return it->second;
         }
 
-        if (map_populated) {
-            return nullptr;
-        }
+        return nullptr;
     }
 
     {
         std::unique_lock _{ g_tdb_type_mtx };
 
+        if (g_tdb_type_map_populated.load(std::memory_order_relaxed)) {
+            return this->find_type(name);
+        }
+
         for (uint32_t i = 0; i < this->get_num_types(); ++i) {
             try {
                 auto t = get_type(i);
-                g_tdb_type_map[t->get_full_name()] = t;
+                g_tdb_type_map[t->get_full_name_view()] = t;
             } catch (...) {
                 // TDB < 69: some type indices have corrupt/unresolvable names.
                 // Skip them — important types (via.Application etc.) still populate.
             }
         }
 
-        map_populated = true;
+        g_tdb_type_map_populated.store(true, std::memory_order_release);
     }
 
     return this->find_type(name);
 }
 
+sdk::RETypeDefinition* RETypeDB::find_generic_instance(uint32_t definition_index, std::span<const uint32_t> argument_indices) const {
+    // Same as find_type, built once on first use and read without the lock after that.
+    if (g_tdb_generic_map_populated.load(std::memory_order_acquire)) {
+        const auto [begin, end] = g_tdb_generic_map.equal_range(hash_generic_instance(definition_index, argument_indices));
+
+        for (auto it = begin; it != end; ++it) {
+            if (is_generic_instance_of(it->second, definition_index, argument_indices)) {
+                return it->second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    {
+        std::unique_lock _{ g_tdb_generic_mtx };
+
+        if (g_tdb_generic_map_populated.load(std::memory_order_relaxed)) {
+            return this->find_generic_instance(definition_index, argument_indices);
+        }
+
+        std::vector<uint32_t> arguments{};
+
+        for (uint32_t i = 0; i < this->get_num_types(); ++i) {
+            try {
+                auto t = get_type(i);
+                const auto generics = t->get_generic_data();
+
+                if (generics == nullptr) {
+                    continue;
+                }
+
+                const auto definition = sdk::generic_list_accessor::get_definition_typeid(generics);
+                const auto num = sdk::generic_list_accessor::get_num(generics);
+
+                // The definition itself has its generic parameters as arguments, there's nothing to instantiate.
+                if (num == 0 || definition == i) {
+                    continue;
+                }
+
+                arguments.clear();
+
+                for (uint32_t f = 0; f < num; ++f) {
+                    arguments.push_back(sdk::generic_list_accessor::get_type_at(generics, f));
+                }
+
+                g_tdb_generic_map.emplace(hash_generic_instance(definition, arguments), t);
+            } catch (...) {
+                // Same corrupt entries find_type skips.
+            }
+        }
+
+        spdlog::info("[RETypeDB] Indexed {} generic instantiations", g_tdb_generic_map.size());
+
+        g_tdb_generic_map_populated.store(true, std::memory_order_release);
+    }
+
+    return this->find_generic_instance(definition_index, argument_indices);
+}
+
 sdk::RETypeDefinition* RETypeDB::find_type_by_fqn(uint32_t fqn) const {
     for (uint32_t i = 0; i< this->get_num_types(); ++i) {
         auto t = get_type(i);
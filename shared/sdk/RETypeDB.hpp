@@ -1883,6 +1883,8 @@ struct RETypeDB {
 
     sdk::RETypeDefinition* find_type(std::string_view name) const;
     sdk::RETypeDefinition* find_type_by_fqn(uint32_t fqn) const;
+    // The TDB only has the instantiations the game was built with, nullptr for anything else.
+    sdk::RETypeDefinition* find_generic_instance(uint32_t definition_index, std::span<const uint32_t> argument_indices) const;
     sdk::RETypeDefinition* get_type(uint32_t index) const;
     sdk::REMethodDefinition* get_method(uint32_t index) const;
     sdk::REField* get_field(uint32_t index) const;
@@ -1,16 +1,21 @@
+#include <atomic>
+#include <cstring>
 #include <deque>
 #include <mutex>
 #include <shared_mutex>
 #include <execution>
+#include <span>
 #include <sstream>
 
 #include <spdlog/spdlog.h>
+#include <utility/ScopeGuard.hpp>
 
 
 #include <reframework/API.hpp>
 
 #include "RETypeDB.hpp"
 #include "RETypeDefinition.hpp"
+#include "TypeHierarchy.hpp"
 
 // SEH wrapper for calling game's managed get_FullName. Debug builds of some
 // RE Engine games (e.g. Pragmata Sketchbook) fire DebugBreak() assertions
@@ -152,24 +157,118 @@ const char* RETypeDefinition::get_name() const {
     return tdb->get_string(name_index);
 }
 
-// because who knows where this is going to be called from.
-static std::unordered_map<uint32_t, std::string> g_full_names{};
-static std::shared_mutex g_full_name_mtx{};
+namespace {
+// Append-only storage for full names. Strings are never moved or freed,
+// so views into it stay valid for the lifetime of the process.
+class FullNameArena {
+public:
+    std::string_view store(std::string_view name) {
+        std::scoped_lock _{m_mtx};
+
+        if (m_used + name.size() + 1 > m_capacity) {
+            m_capacity = std::max<size_t>(BLOCK_SIZE, name.size() + 1);
+            m_used = 0;
+            m_blocks.emplace_back(std::make_unique<char[]>(m_capacity));
+        }
+
+        auto out = m_blocks.back().get() + m_used;
+        std::memcpy(out, name.data(), name.size());
+        out[name.size()] = '\0';
+        m_used += name.size() + 1;
+
+        return std::string_view{out, name.size()};
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    std::mutex m_mtx{};
+    std::vector<std::unique_ptr<char[]>> m_blocks{};
+    size_t m_used{0};
+    size_t m_capacity{0};
+};
+
+// Per type index slot, published once with release semantics and read without locking.
+struct FullNameEntry {
+    std::string_view name{};
+};
+
+FullNameArena g_full_name_arena{};
+std::mutex g_full_name_publish_mtx{};
+
+std::span<std::atomic<const FullNameEntry*>> get_full_name_slots() {
+    static auto slots = []() {
+        auto tdb = RETypeDB::get();
+        const auto count = tdb != nullptr ? tdb->get_num_types() : 0;
+
+        return std::span<std::atomic<const FullNameEntry*>>{new std::atomic<const FullNameEntry*>[count]{}, count};
+    }();
+
+    return slots;
+}
+
+// Names of types whose full name is still being built on this thread, so recursive lookups
+// (generic arguments that refer back to the type) see the partial name without publishing it.
+thread_local std::unordered_map<uint32_t, std::string> t_full_names_in_progress{};
+}
 
 std::string RETypeDefinition::get_full_name() const {
-    auto tdb = RETypeDB::get();
+    // Recursive lookup from build_full_name, the partial name is copied straight out of the map.
+    if (auto it = t_full_names_in_progress.find(this->get_index()); it != t_full_names_in_progress.end()) {
+        return it->second;
+    }
 
-#if TDB_VER <= 49
-    return tdb->get_string(this->full_name_offset); // uhh thanks?
-#else
-    {
-        std::shared_lock _{ g_full_name_mtx };
+    return std::string{get_full_name_view()};
+}
 
-        if (auto it = g_full_names.find(this->get_index()); it != g_full_names.end()) {
-            return it->second;
+std::string_view RETypeDefinition::get_full_name_view() const {
+    const auto index = this->get_index();
+    const auto slots = get_full_name_slots();
+
+    if (index < slots.size()) {
+        if (const auto entry = slots[index].load(std::memory_order_acquire); entry != nullptr) {
+            return entry->name;
         }
     }
 
+    // Recursive lookup from build_full_name. The map entry goes away when the outer build finishes,
+    // so the partial name gets its own copy in the arena. It isn't published, the finished name will be.
+    if (auto it = t_full_names_in_progress.find(index); it != t_full_names_in_progress.end()) {
+        return g_full_name_arena.store(it->second);
+    }
+
+    auto full_name = build_full_name();
+
+    std::scoped_lock _{g_full_name_publish_mtx};
+
+    if (index < slots.size()) {
+        // Another thread may have published it while we were building it.
+        if (const auto entry = slots[index].load(std::memory_order_relaxed); entry != nullptr) {
+            return entry->name;
+        }
+
+        const auto entry = new FullNameEntry{g_full_name_arena.store(full_name)};
+        slots[index].store(entry, std::memory_order_release);
+
+        return entry->name;
+    }
+
+    // Out of range index (corrupt TDB entry), still hand out a stable view.
+    static std::unordered_map<uint32_t, std::string_view> out_of_range_names{};
+
+    if (auto it = out_of_range_names.find(index); it != out_of_range_names.end()) {
+        return it->second;
+    }
+
+    return out_of_range_names[index] = g_full_name_arena.store(full_name);
+}
+
+std::string RETypeDefinition::build_full_name() const {
+    auto tdb = RETypeDB::get();
+
+#if TDB_VER <= 49
+    return tdb->get_string(this->full_name_offset); // uhh thanks?
+#else
     std::deque<std::string> names{};
     std::string full_name{};
 
@@ -216,10 +315,8 @@ std::string RETypeDefinition::get_full_name() const {
     }
 
     // Set this here at this point in-case get_full_name runs into it
-    {
-        std::unique_lock _{g_full_name_mtx};
-        g_full_names[this->get_index()] = full_name;
-    }
+    t_full_names_in_progress[this->get_index()] = full_name;
+    utility::ScopeGuard _{[index = this->get_index()]() { t_full_names_in_progress.erase(index); }};
 
     auto generate_full_name_via_reflection = [&]() {
         // system_runtime_type may be null on older TDB versions (e.g. DMC5/TDB67)
@@ -294,11 +391,6 @@ std::string RETypeDefinition::get_full_name() const {
         generate_full_name_via_reflection();
     }
 
-    {
-        std::unique_lock _{g_full_name_mtx};
-        g_full_names[this->get_index()] = full_name;
-    }
-
     return full_name;
 #endif
 }
@@ -618,6 +710,28 @@ std::vector<sdk::RETypeDefinition*> RETypeDefinition::get_generic_argument_types
     return out;
 }
 
+sdk::RETypeDefinition* RETypeDefinition::instantiate(std::span<sdk::RETypeDefinition* const> arguments) const {
+    constexpr size_t MAX_GENERIC_ARGUMENTS = 16;
+
+    const auto definition = get_generic_type_definition();
+
+    if (definition == nullptr || arguments.empty() || arguments.size() > MAX_GENERIC_ARGUMENTS) {
+        return nullptr;
+    }
+
+    uint32_t argument_indices[MAX_GENERIC_ARGUMENTS]{};
+
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == nullptr) {
+            return nullptr;
+        }
+
+        argument_indices[i] = arguments[i]->get_index();
+    }
+
+    return sdk::RETypeDB::get()->find_generic_instance(definition->get_index(), std::span{argument_indices, arguments.size()});
+}
+
 sdk::GenericListData* RETypeDefinition::get_generic_data() const {
     if (TDEF_FIELD(this, generics) > 0) {
         const auto tdb = sdk::RETypeDB::get();
@@ -654,11 +768,47 @@ bool RETypeDefinition::has_fieldptr_offset() const {
     }
 }
 
+// Numbered once, the first time a hierarchy check is made after the TDB is available.
+static const sdk::TypeHierarchy& get_type_hierarchy() {
+    static const auto hierarchy = []() {
+        sdk::TypeHierarchy out{};
+        auto tdb = RETypeDB::get();
+
+        if (tdb == nullptr) {
+            return out;
+        }
+
+        const auto num_types = tdb->get_num_types();
+        std::vector<uint32_t> parents(num_types, sdk::TypeHierarchy::INVALID);
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            if (auto t = tdb->get_type(i); t != nullptr) {
+                parents[i] = sdk::TypeHierarchy::parent_from_tdb(TDEF_FIELD(t, parent_typeid));
+            }
+        }
+
+        out.build(parents);
+        spdlog::info("[RETypeDefinition] Numbered type hierarchy ({} types)", out.size());
+
+        return out;
+    }();
+
+    return hierarchy;
+}
+
 bool RETypeDefinition::is_a(const sdk::RETypeDefinition* other) const {
     if (other == nullptr) {
         return false;
     }
 
+    if (this == other) {
+        return true;
+    }
+
+    if (const auto result = get_type_hierarchy().is_a(this->get_index(), other->get_index())) {
+        return *result;
+    }
+
     for (auto super = this; super != nullptr; super = super->get_parent_type()) {
         if (super == other) {
             return true;
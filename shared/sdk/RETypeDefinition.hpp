@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -584,6 +585,8 @@ struct RETypeDefinition {
     const char* get_name() const;
 
     std::string get_full_name() const;
+    // Interned, valid for the lifetime of the process. Prefer this over get_full_name in hot paths.
+    std::string_view get_full_name_view() const;
     std::vector<std::string> get_name_hierarchy() const;
 
     sdk::RETypeDefinition* get_declaring_type() const;
@@ -594,6 +597,8 @@ struct RETypeDefinition {
     sdk::REMethodDefinition* get_method(std::string_view name) const;
     std::vector<sdk::REMethodDefinition*> get_methods(std::string_view name) const;
     std::vector<sdk::RETypeDefinition*> get_generic_argument_types() const;
+    // Works on the definition or any instantiation of it, e.g. List`1<A> with {B} gives List`1<B>.
+    sdk::RETypeDefinition* instantiate(std::span<sdk::RETypeDefinition* const> arguments) const;
     sdk::GenericListData* get_generic_data() const;
 
     uint32_t get_element_typeid() const;
@@ -633,5 +638,6 @@ struct RETypeDefinition {
 
 private:    
     void set_vm_obj_type(::via::clr::VMObjType type); // for REFramework shenanigans only!
+    std::string build_full_name() const;
 };
 } // namespace sdk
\ No newline at end of file
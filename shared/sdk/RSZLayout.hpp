@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sdk {
+// Precompiled RSZ layout for types whose serialized fields are all plain value types
+// (no strings, object references, resources or arrays).
+//
+// RSZ aligns every field relative to the start of the stream, so as long as an instance
+// starts on the plan's max alignment the stream offset of every field is fixed. Fields that are
+// contiguous both in the stream and in the object are merged into a single copy.
+//
+// Doesn't touch the TDB, the plan is compiled from (offset, size, align) triples, or from the
+// type's deserializer sequences, which are checked against a whitelist of plain typecodes first.
+class RSZLayout {
+public:
+    struct Field {
+        uint32_t offset{}; // destination offset, relative to the object's field pointer
+        uint16_t size{};
+        uint16_t align{};
+    };
+
+    // One entry of a type's deserializer sequence list.
+    struct Sequence {
+        uint8_t code{};
+        uint8_t depth{};
+        uint32_t offset{};
+        uint16_t size{};
+        uint16_t align{};
+    };
+
+    // Sequence typecodes that are the same bytes in the stream and in the object.
+    // Anything else (objects, strings, resources, nested structs, geometry with its own rules) goes to the engine.
+    static constexpr bool is_plain_code(uint8_t code) {
+        constexpr uint8_t BOOL = 7;
+        constexpr uint8_t F64 = 19;        // C8, C16, S8 ... U64, F32 in between
+        constexpr uint8_t ENUM = 22;
+        constexpr uint8_t UINT2 = 23;
+        constexpr uint8_t FLOAT4 = 31;     // Uint2 ... Float4
+        constexpr uint8_t HALF2 = 36;
+        constexpr uint8_t DATETIME = 47;   // Half2, Half4, Mat3, Mat4, Vec2 ... Vec4, VecU4, Quaternion, Guid, Color
+
+        return (code >= BOOL && code <= F64) || code == ENUM || (code >= UINT2 && code <= FLOAT4) || (code >= HALF2 && code <= DATETIME);
+    }
+
+    // Only flat types: every sequence at depth 0 with a plain typecode.
+    static std::optional<RSZLayout> compile_sequences(std::span<const Sequence> sequences) {
+        if (sequences.empty()) {
+            return std::nullopt;
+        }
+
+        std::vector<Field> fields{};
+        fields.reserve(sequences.size());
+
+        for (const auto& sequence : sequences) {
+            if (sequence.depth != 0 || !is_plain_code(sequence.code)) {
+                return std::nullopt;
+            }
+
+            fields.push_back({sequence.offset, sequence.size, sequence.align});
+        }
+
+        return compile(fields);
+    }
+
+    static std::optional<RSZLayout> compile(std::span<const Field> fields) {
+        RSZLayout layout{};
+        layout.m_fields.reserve(fields.size());
+
+        uint32_t cursor = 0;
+
+        for (auto field : fields) {
+            if (field.align == 0) {
+                field.align = 1;
+            }
+
+            if ((field.align & (field.align - 1)) != 0) {
+                return std::nullopt;
+            }
+
+            const auto src = align_up(cursor, field.align);
+
+            if (field.size > 0) {
+                auto& runs = layout.m_runs;
+
+                if (!runs.empty() && runs.back().src + runs.back().size == src && runs.back().dst + runs.back().size == field.offset) {
+                    runs.back().size += field.size;
+                } else {
+                    runs.push_back({src, field.offset, field.size});
+                }
+            }
+
+            layout.m_fields.push_back(field);
+            layout.m_max_align = std::max<uint32_t>(layout.m_max_align, field.align);
+            cursor = src + field.size;
+        }
+
+        layout.m_stream_size = cursor;
+
+        return layout;
+    }
+
+    // Number of stream bytes one instance takes when it starts on max_align().
+    uint32_t stream_size() const {
+        return m_stream_size;
+    }
+
+    uint32_t max_align() const {
+        return m_max_align;
+    }
+
+    size_t num_copies() const {
+        return m_runs.size();
+    }
+
+    // Decodes one instance starting at head + pos into dst.
+    // Returns the stream position after the instance, or nullopt if the buffer is too small.
+    std::optional<size_t> decode(const uint8_t* head, size_t size, size_t pos, uint8_t* dst) const {
+        if (pos % m_max_align == 0) {
+            if (pos > size || size - pos < m_stream_size) {
+                return std::nullopt;
+            }
+
+            copy_runs(head + pos, dst);
+
+            return pos + m_stream_size;
+        }
+
+        // Misaligned start, the padding differs from the precompiled one.
+        for (const auto& field : m_fields) {
+            pos = align_up(pos, field.align);
+
+            if (pos > size || size - pos < field.size) {
+                return std::nullopt;
+            }
+
+            std::memcpy(dst + field.offset, head + pos, field.size);
+            pos += field.size;
+        }
+
+        return pos;
+    }
+
+    // Decodes dsts.size() consecutive instances in one pass.
+    // Returns the stream position after the last instance, or nullopt if the buffer is too small.
+    // Nothing is written if the size check up front fails.
+    std::optional<size_t> decode_batch(const uint8_t* head, size_t size, size_t pos, std::span<uint8_t* const> dsts) const {
+        if (dsts.empty()) {
+            return pos;
+        }
+
+        // Every instance stays aligned, so the whole batch is a fixed stride.
+        if (pos % m_max_align == 0 && m_stream_size % m_max_align == 0) {
+            const auto total = (size_t)m_stream_size * dsts.size();
+
+            if (pos > size || size - pos < total) {
+                return std::nullopt;
+            }
+
+            auto src = head + pos;
+
+            for (auto dst : dsts) {
+                copy_runs(src, dst);
+                src += m_stream_size;
+            }
+
+            return pos + total;
+        }
+
+        for (auto dst : dsts) {
+            const auto next = decode(head, size, pos, dst);
+
+            if (!next) {
+                return std::nullopt;
+            }
+
+            pos = *next;
+        }
+
+        return pos;
+    }
+
+private:
+    struct Run {
+        uint32_t src{};
+        uint32_t dst{};
+        uint32_t size{};
+    };
+
+    template <typename T>
+    static constexpr T align_up(T value, uint32_t align) {
+        return (value + align - 1) & ~(T)(align - 1);
+    }
+
+    void copy_runs(const uint8_t* src, uint8_t* dst) const {
+        for (const auto& run : m_runs) {
+            std::memcpy(dst + run.dst, src + run.src, run.size);
+        }
+    }
+
+    std::vector<Field> m_fields{};
+    std::vector<Run> m_runs{};
+    uint32_t m_max_align{1};
+    uint32_t m_stream_size{0};
+};
+}
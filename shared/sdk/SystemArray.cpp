@@ -1,8 +1,17 @@
+#include <algorithm>
+#include <stdexcept>
+
 #include "RETypeDB.hpp"
+#include "REArray.hpp"
+#include "ArrayRange.hpp"
 
 #include "SystemArray.hpp"
 
 size_t sdk::SystemArray::get_size() {
+    if (is_single_dimensional()) {
+        return array_range::size_from_header(((::REArrayBase*)this)->numElements);
+    }
+
     static auto system_array_type = sdk::find_type_definition("System.Array");
     static auto get_length_method = system_array_type->get_method("GetLength");
 
@@ -14,6 +23,11 @@ size_t sdk::SystemArray::get_size() {
         return nullptr;
     }
 
+    if (auto objects = get_objects(); !objects.empty()) {
+        return objects[index];
+    }
+
+    // Value types need to be boxed by the VM.
     static auto system_array_type = sdk::find_type_definition("System.Array");
     static auto get_element_method = system_array_type->get_method("GetValue(System.Int32)");
 
@@ -32,13 +46,88 @@ void sdk::SystemArray::set_element(int32_t index, ::REManagedObject* value) {
 }
 
 std::vector<::REManagedObject*> sdk::SystemArray::get_elements() {
-    std::vector<::REManagedObject*> elements{};
+    if (is_single_dimensional() && !has_inline_elements()) {
+        const auto objects = get_objects();
+        return {objects.begin(), objects.end()};
+    }
+
+    static auto system_array_type = sdk::find_type_definition("System.Array");
+    static auto get_element_method = system_array_type->get_method("GetValue(System.Int32)");
+
     const auto size = get_size();
+    const auto context = sdk::get_thread_context();
+
+    std::vector<::REManagedObject*> elements{};
+    elements.reserve(size);
 
     for (size_t i = 0; i < size; i++) {
-        elements.push_back(get_element(i));
+        elements.push_back(get_element_method->call_safe<::REManagedObject*>(context, this, (int32_t)i));
     }
 
     return elements;
 }
 
+sdk::RETypeDefinition* sdk::SystemArray::get_contained_type() {
+    return utility::re_array::get_contained_type((::REArrayBase*)this);
+}
+
+bool sdk::SystemArray::has_inline_elements() {
+    return utility::re_array::has_inline_elements((::REArrayBase*)this);
+}
+
+uint32_t sdk::SystemArray::get_element_size() {
+    return utility::re_array::get_element_size((::REArrayBase*)this);
+}
+
+bool sdk::SystemArray::is_single_dimensional() {
+    return ((::REArrayBase*)this)->num1 <= 1;
+}
+
+void* sdk::SystemArray::get_data() {
+    // Same base as utility::re_array::get_inline_element/get_ptr_element.
+    return (void*)((uintptr_t)((::REArrayBase*)this->get_field_ptr() + 1) - REManagedObject::runtime_size());
+}
+
+std::span<::REManagedObject*> sdk::SystemArray::get_objects() {
+    if (!is_single_dimensional() || has_inline_elements()) {
+        return {};
+    }
+
+    return std::span<::REManagedObject*>{(::REManagedObject**)get_data(), get_size()};
+}
+
+size_t sdk::SystemArray::copy_to(std::span<::REManagedObject*> out, size_t start) {
+    return array_range::copy_out(get_objects(), out, start);
+}
+
+void sdk::SystemArray::set_range(size_t start, std::span<::REManagedObject* const> values) {
+    if (!array_range::fits(get_size(), start, values.size())) {
+        throw std::out_of_range("range out of bounds");
+    }
+
+    // Still goes through SetValue so the VM handles reference counting and type checks,
+    // but only once per element instead of GetLength + SetValue.
+    static auto system_array_type = sdk::find_type_definition("System.Array");
+    static auto set_element_method = system_array_type->get_method("SetValue(System.Object, System.Int32)");
+
+    const auto context = sdk::get_thread_context();
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        set_element_method->call_safe<void>(context, this, values[i], (int32_t)(start + i));
+    }
+}
+
+void sdk::SystemArray::set_range_raw(size_t start, std::span<const uint8_t> bytes) {
+    if (!is_single_dimensional() || !has_inline_elements()) {
+        throw std::runtime_error("set_range_raw requires a single-dimensional value type array");
+    }
+
+    switch (array_range::write_raw((uint8_t*)get_data(), get_size(), get_element_size(), start, bytes)) {
+    case array_range::RawWrite::BAD_BYTE_COUNT:
+        throw std::invalid_argument("byte count is not a multiple of the element size");
+    case array_range::RawWrite::OUT_OF_RANGE:
+        throw std::out_of_range("range out of bounds");
+    default:
+        break;
+    }
+}
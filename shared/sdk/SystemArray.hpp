@@ -4,12 +4,15 @@ struct SystemArray;
 
 #pragma once
 
+#include <span>
+#include <type_traits>
 #include <vector>
 
 #include "REManagedObject.hpp"
 
 namespace sdk {
 struct SystemArray;
+struct RETypeDefinition;
 
 struct SystemArray : public ::REManagedObject {
     size_t get_size();
@@ -17,6 +20,40 @@ struct SystemArray : public ::REManagedObject {
     void set_element(int32_t index, ::REManagedObject* value);
     std::vector<::REManagedObject*> get_elements();
 
+    // Layout-aware bulk access. These read the REArrayBase header and element storage
+    // directly instead of going through System.Array.GetLength/GetValue per element.
+    // Only single-dimensional arrays are supported natively; multi-dimensional arrays
+    // report an empty span and fall back to the VM paths above.
+    ::sdk::RETypeDefinition* get_contained_type();
+    bool has_inline_elements();
+    uint32_t get_element_size();
+    bool is_single_dimensional();
+    void* get_data();
+
+    // View over a reference type array. Empty if the elements are stored inline.
+    std::span<::REManagedObject*> get_objects();
+
+    // View over an array of inline value types, T must match the element size.
+    template <typename T>
+    std::span<T> get_values() {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (!is_single_dimensional() || !has_inline_elements() || get_element_size() != sizeof(T)) {
+            return {};
+        }
+
+        return std::span<T>{(T*)get_data(), get_size()};
+    }
+
+    // Copies up to out.size() references starting at start. Returns the number copied.
+    size_t copy_to(std::span<::REManagedObject*> out, size_t start = 0);
+
+    // Replaces [start, start + values.size()) with one bounds check for the whole range.
+    void set_range(size_t start, std::span<::REManagedObject* const> values);
+
+    // Raw copy into inline value type storage. Only valid for blittable value types.
+    void set_range_raw(size_t start, std::span<const uint8_t> bytes);
+
     using size_type = size_t;
     using value_type = ::REManagedObject*;
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sdk {
+// Pre-order (Euler tour) numbering of the type inheritance forest.
+// Every type gets the interval [enter, exit] of pre-order numbers covered by its subtree,
+// so "a derives from b" becomes two integer comparisons instead of a parent chain walk.
+//
+// Built from a flat parent index table, so it doesn't need the TDB itself.
+class TypeHierarchy {
+public:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    // The TDB stores "no parent" as 0 (see RETypeDefinition::get_parent_type), index 0 is never a real base.
+    static constexpr uint32_t parent_from_tdb(uint32_t parent_typeid) {
+        return parent_typeid != 0 ? parent_typeid : INVALID;
+    }
+
+    // parents[i] is the parent type index of type i, or anything out of range / i itself for roots.
+    void build(std::span<const uint32_t> parents) {
+        const auto n = (uint32_t)parents.size();
+
+        auto parent_of = [&](uint32_t i) -> uint32_t {
+            const auto p = parents[i];
+            return (p < n && p != i) ? p : INVALID;
+        };
+
+        // Children in CSR form so the walk below doesn't allocate per node.
+        std::vector<uint32_t> child_start(n + 1, 0);
+
+        for (uint32_t i = 0; i < n; ++i) {
+            if (const auto p = parent_of(i); p != INVALID) {
+                ++child_start[p + 1];
+            }
+        }
+
+        for (uint32_t i = 0; i < n; ++i) {
+            child_start[i + 1] += child_start[i];
+        }
+
+        std::vector<uint32_t> children(child_start[n]);
+        std::vector<uint32_t> fill{child_start.begin(), child_start.end() - 1};
+
+        for (uint32_t i = 0; i < n; ++i) {
+            if (const auto p = parent_of(i); p != INVALID) {
+                children[fill[p]++] = i;
+            }
+        }
+
+        m_intervals.assign(n, Interval{});
+
+        // Iterative DFS from every root. Types caught in a parent cycle are never reached
+        // and keep an invalid interval, is_a() reports those as unknown.
+        std::vector<std::pair<uint32_t, uint32_t>> stack{}; // (type, next child offset)
+        uint32_t counter = 0;
+
+        for (uint32_t root = 0; root < n; ++root) {
+            if (parent_of(root) != INVALID) {
+                continue;
+            }
+
+            m_intervals[root].enter = counter++;
+            stack.emplace_back(root, child_start[root]);
+
+            while (!stack.empty()) {
+                auto& [node, next] = stack.back();
+
+                if (next < child_start[node + 1]) {
+                    const auto child = children[next++];
+
+                    m_intervals[child].enter = counter++;
+                    stack.emplace_back(child, child_start[child]);
+                } else {
+                    m_intervals[node].exit = counter - 1;
+                    stack.pop_back();
+                }
+            }
+        }
+    }
+
+    bool empty() const {
+        return m_intervals.empty();
+    }
+
+    size_t size() const {
+        return m_intervals.size();
+    }
+
+    // true/false if both types are numbered, nullopt if the caller needs to fall back to a parent walk.
+    std::optional<bool> is_a(uint32_t type, uint32_t base) const {
+        if (type >= m_intervals.size() || base >= m_intervals.size()) {
+            return std::nullopt;
+        }
+
+        const auto& t = m_intervals[type];
+        const auto& b = m_intervals[base];
+
+        if (t.enter == INVALID || b.enter == INVALID) {
+            return std::nullopt;
+        }
+
+        return b.enter <= t.enter && t.enter <= b.exit;
+    }
+
+private:
+    struct Interval {
+        uint32_t enter{INVALID};
+        uint32_t exit{INVALID};
+    };
+
+    std::vector<Interval> m_intervals{};
+};
+}
@@ -1,7 +1,10 @@
 #pragma once
+#include <span>
+
 #include "REManagedObject.hpp"
 
 class REGameObject;
+namespace sdk { struct RETypeDefinition; }
 
 #pragma pack(push, 1)
 class REComponent : public REManagedObject {
@@ -28,15 +31,16 @@ public:
     REComponent* get_chain() const { return get_reflection_property<REComponent*>("Chain"); }
     float get_delta_time() const { return get_reflection_property<float>("DeltaTime"); }
 
-    // Find a child component by type name or REType*
+    // Find a child component by type name, RETypeDefinition* or REType*
+    // The name is resolved to a type definition once, children are then checked by type instead of by name.
     template<typename T = REComponent>
     T* find(std::string_view name) const {
-        for (auto child = get_child_component(); child != nullptr && child != this; child = child->get_child_component()) {
-            if (child->is_a(name)) {
-                return (T*)child;
-            }
-        }
-        return nullptr;
+        return (T*)find_component(name);
+    }
+
+    template<typename T = REComponent>
+    T* find(const sdk::RETypeDefinition* t) const {
+        return (T*)find_component(t);
     }
 
     template<typename T = REComponent>
@@ -58,6 +62,14 @@ public:
         }
         return nullptr;
     }
+
+    REComponent* find_component(std::string_view name) const;
+    REComponent* find_component(const sdk::RETypeDefinition* t) const;
+
+    // For each game object, the first component that is a t (or nullptr), written to out[i].
+    // Type checks are shared across the whole batch, so objects with the same component
+    // types only pay for the hierarchy check once.
+    static void find_components(std::span<REGameObject* const> game_objects, const sdk::RETypeDefinition* t, std::span<REComponent*> out);
 };
 static_assert(sizeof(REComponent) == 0x30);
 
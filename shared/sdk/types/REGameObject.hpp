@@ -21,7 +21,12 @@ public:
     static uintptr_t offset_of_transform();
     static uintptr_t offset_of_folder();
 
+    // The managed name, get_name_field() may not be a SystemString on older games.
+    SystemString* get_name_string() const;
+
+    // Cached, see sdk::GameObjectNames.
     std::string get_name() const;
+    size_t get_name_hash() const;
 #else
     RETransform* get_transform() const { return m_transform; }
     bool get_shouldDraw() const { return m_shouldDraw; }
@@ -34,7 +39,10 @@ public:
     static uintptr_t offset_of_transform() { return offsetof(REGameObject, m_transform); }
     static uintptr_t offset_of_folder()    { return offsetof(REGameObject, m_folder); }
 
+    SystemString* get_name_string() const;
+
     std::string get_name() const;
+    size_t get_name_hash() const;
 #endif
 
 private:
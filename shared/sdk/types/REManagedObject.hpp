@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -60,6 +61,10 @@ public:
     // Serialization
     static std::vector<::REManagedObject*> deserialize(const uint8_t* data, size_t size, bool add_references);
     void deserialize_native(const uint8_t* data, size_t size, const std::vector<::REManagedObject*>& objects);
+    // Deserializes consecutive RSZ instances from one buffer into objects, in order.
+    // Types made only of plain value fields use a precompiled layout, the rest go through the engine deserializer.
+    // Returns the number of bytes consumed, which stops short of the end if an object couldn't be deserialized.
+    static size_t deserialize_batch(const uint8_t* data, size_t size, std::span<::REManagedObject* const> objects, const std::vector<::REManagedObject*>& references);
 
     // ParamWrapper + call_method declared in REManagedObject.hpp (needs ReClass.hpp)
     struct ParamWrapper;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace utility {
+namespace fnv1a {
+constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t PRIME = 0x100000001b3ULL;
+
+// One step, for callers that transform each unit (e.g. case folding) as they go.
+constexpr uint64_t step(uint64_t hash, uint64_t unit) {
+    return (hash ^ unit) * PRIME;
+}
+
+// 64-bit FNV-1a over the code units of a string, so wide strings hash each UTF-16 unit once.
+template <typename CharT>
+constexpr uint64_t hash64(std::basic_string_view<CharT> text, uint64_t hash = OFFSET_BASIS) {
+    for (const auto c : text) {
+        hash = step(hash, (std::make_unsigned_t<CharT>)c);
+    }
+
+    return hash;
+}
+
+constexpr uint64_t hash64(std::string_view text, uint64_t hash = OFFSET_BASIS) {
+    return hash64<char>(text, hash);
+}
+
+constexpr uint64_t hash64(std::wstring_view text, uint64_t hash = OFFSET_BASIS) {
+    return hash64<wchar_t>(text, hash);
+}
+
+inline uint64_t hash64(const void* data, size_t size, uint64_t hash = OFFSET_BASIS) {
+    const auto bytes = (const uint8_t*)data;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash = step(hash, bytes[i]);
+    }
+
+    return hash;
+}
+}
+}
@@ -1,66 +1,283 @@
-#include <optional>
-#include <vector>
-#include <array>
+#include <algorithm>
 #include <stdexcept>
-#include <unordered_set>
 #include <spdlog/spdlog.h>
 
+#ifdef _WIN32
 #include <Windows.h>
+#include <intrin.h>
+#else
+#include <cstdio>
+#endif
+
+#include <immintrin.h>
 
-#include <utility/String.hpp>
 #include "Relocate.hpp"
 
 using namespace std;
 
 namespace utility {
     namespace detail {
-        void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth, uint32_t skip_length, uint32_t scan_size, std::unordered_set<uint8_t*>& seen) {
-            try {
-                if (seen.find(scan_start) != seen.end()) {
-                    return;
+        // Anything outside of this can't be a user mode pointer, no need to ask the OS.
+        constexpr uintptr_t MIN_POINTER = 0x10000;
+        constexpr uintptr_t MAX_POINTER = 0x7FFFFFFFFFFF;
+
+        constexpr size_t MAX_SIMD_RANGES = 8;
+
+#ifdef _MSC_VER
+#define RELOCATE_TARGET_AVX2
+#else
+#define RELOCATE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+        bool has_avx2() {
+#ifndef _WIN32
+            static const bool result = __builtin_cpu_supports("avx2");
+#else
+            static const bool result = [] {
+                int regs[4]{};
+
+                __cpuid(regs, 0);
+
+                if (regs[0] < 7) {
+                    return false;
                 }
 
-                seen.insert(scan_start);
+                __cpuid(regs, 1);
+
+                const bool osxsave = (regs[2] & (1 << 27)) != 0;
+                const bool avx = (regs[2] & (1 << 28)) != 0;
 
-                if (IsBadReadPtr(scan_start, skip_length)) {
-                    return;
+                if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+                    return false;
                 }
 
-                spdlog::info("[relocate_pointers] Scanning {:x} for range <{:x}, {:x}> (size {:x})", (uintptr_t)scan_start, old_start, old_end, scan_size);
+                __cpuidex(regs, 7, 0);
+                return (regs[1] & (1 << 5)) != 0;
+            }();
+#endif
 
-                for (auto i = 0; i < scan_size; i += skip_length) {
-                    if (IsBadReadPtr(scan_start + i, sizeof(void*))) {
-                        break;
-                    }
+            return result;
+        }
+    }
+
+    PointerRelocator::PointerRelocator(std::span<const RelocationRange> ranges, uint32_t skip_length)
+        : m_ranges{ranges.begin(), ranges.end()},
+        m_skip_length{skip_length}
+    {
+        if (skip_length == 0) {
+            throw std::runtime_error("relocate_pointers: skip_length must be greater than 0");
+        }
+    }
+
+    void PointerRelocator::scan(uint8_t* scan_start, int32_t depth, uint32_t scan_size) {
+        scan_block((uintptr_t)scan_start, depth, scan_size);
+    }
+
+    void PointerRelocator::log_summary(std::string_view context) const {
+        spdlog::info("[relocate_pointers] {}: relocated {} pointers in {} blocks ({:x} bytes, {} ranges)",
+            context, m_num_relocated, m_num_blocks, m_bytes_scanned, m_ranges.size());
+    }
+
+    void PointerRelocator::scan_block(uintptr_t start, int32_t depth, size_t size) {
+        try {
+            // A slot starting inside the block may end past it.
+            const auto readable_size = get_readable_size(start, size + sizeof(void*) - 1);
+
+            if (readable_size < m_skip_length) {
+                return;
+            }
+
+            mark_scanned(start, start + std::min(size, readable_size));
+
+            ++m_num_blocks;
+            m_bytes_scanned += std::min(size, readable_size);
 
-                    auto& ptr = *(uintptr_t*)(scan_start + i);
-                    seen.insert(scan_start + i);
+            if (readable_size < sizeof(void*)) {
+                return;
+            }
+
+            const auto last_slot = std::min(size, readable_size - sizeof(void*) + 1);
+
+            // Nothing to follow, so only the slots that match need any work.
+            if (depth <= 0 && m_skip_length == sizeof(void*)) {
+                scan_flat(start, (last_slot + sizeof(void*) - 1) / sizeof(void*));
+                return;
+            }
 
-                    if (ptr >= old_start && ptr < old_end) {
-                        const auto new_ptr = new_start + (ptr - old_start);
-                        spdlog::info("[relocate_pointers] {:x}+{:x}, {:x} -> {:x}", (uintptr_t)scan_start, (uintptr_t)i, (uintptr_t)ptr, (uintptr_t)new_ptr);
-                        const auto prev = ptr;
-                        ptr = new_ptr;
+            for (size_t i = 0; i < last_slot; i += m_skip_length) {
+                const auto slot = start + i;
+                const auto prev = *(uintptr_t*)slot;
+
+                relocate_slot(slot);
+
+                if (depth > 0 && prev >= detail::MIN_POINTER && prev <= detail::MAX_POINTER && !is_scanned(prev) &&
+                    get_readable_size(prev, sizeof(void*)) == sizeof(void*))
+                {
+                    scan_block(prev, depth - 1, 0x1000);
+                }
+            }
+        } catch(...) {
+            // We reached the end of readable memory.
+        }
+    }
+
+    void PointerRelocator::scan_flat(uintptr_t start, size_t num_slots) {
+        size_t i = 0;
+
+        if (detail::has_avx2() && m_ranges.size() <= detail::MAX_SIMD_RANGES) {
+            i = scan_flat_avx2(start, num_slots);
+        }
 
-                        if (depth > 0 && !IsBadReadPtr((void*)prev, sizeof(void*))) {
-                            detail::relocate_pointers((uint8_t*)prev, old_start, old_end, new_start, depth - 1, skip_length, 0x1000, seen);
-                        }
-                    } else if (depth > 0 && !IsBadReadPtr((void*)ptr, sizeof(void*))) {
-                        detail::relocate_pointers((uint8_t*)ptr, old_start, old_end, new_start, depth - 1, skip_length, 0x1000, seen);
+        for (; i < num_slots; ++i) {
+            relocate_slot(start + i * sizeof(void*));
+        }
+    }
+
+    RELOCATE_TARGET_AVX2 size_t PointerRelocator::scan_flat_avx2(uintptr_t start, size_t num_slots) {
+        size_t i = 0;
+
+        // Unsigned (ptr - old_start) < size, done as a signed compare with both sides offset by INT64_MIN.
+        const auto bias = _mm256_set1_epi64x(INT64_MIN);
+        __m256i starts[detail::MAX_SIMD_RANGES]{};
+        __m256i sizes[detail::MAX_SIMD_RANGES]{};
+
+        for (size_t r = 0; r < m_ranges.size(); ++r) {
+            starts[r] = _mm256_set1_epi64x((int64_t)m_ranges[r].old_start);
+            sizes[r] = _mm256_set1_epi64x((int64_t)((m_ranges[r].old_end - m_ranges[r].old_start) ^ (uint64_t)INT64_MIN));
+        }
+
+        for (; i + 4 <= num_slots; i += 4) {
+            const auto slots = _mm256_loadu_si256((const __m256i*)(start + i * sizeof(void*)));
+            auto hits = _mm256_setzero_si256();
+
+            for (size_t r = 0; r < m_ranges.size(); ++r) {
+                const auto offset = _mm256_xor_si256(_mm256_sub_epi64(slots, starts[r]), bias);
+                hits = _mm256_or_si256(hits, _mm256_cmpgt_epi64(sizes[r], offset));
+            }
+
+            if (!_mm256_testz_si256(hits, hits)) {
+                for (size_t j = 0; j < 4; ++j) {
+                    relocate_slot(start + (i + j) * sizeof(void*));
+                }
+            }
+        }
+
+        return i;
+    }
+
+    void PointerRelocator::relocate_slot(uintptr_t slot) {
+        auto& ptr = *(uintptr_t*)slot;
+
+        if (const auto range = find_range(ptr); range != nullptr) {
+            ptr = range->new_start + (ptr - range->old_start);
+            ++m_num_relocated;
+        }
+    }
+
+    const RelocationRange* PointerRelocator::find_range(uintptr_t ptr) const {
+        for (const auto& range : m_ranges) {
+            if (ptr >= range.old_start && ptr < range.old_end) {
+                return &range;
+            }
+        }
+
+        return nullptr;
+    }
+
+    PointerRelocator::Region PointerRelocator::get_region(uintptr_t address) {
+        auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address, [](uintptr_t a, const Region& r) { return a < r.start; });
+
+        if (it != m_regions.begin() && address < std::prev(it)->end) {
+            return *std::prev(it);
+        }
+
+        Region region{address & ~(uintptr_t)0xFFF, (address & ~(uintptr_t)0xFFF) + 0x1000, false};
+
+        if (address >= detail::MIN_POINTER && address <= detail::MAX_POINTER) {
+#ifdef _WIN32
+            MEMORY_BASIC_INFORMATION mbi{};
+
+            if (VirtualQuery((LPCVOID)address, &mbi, sizeof(mbi)) != 0) {
+                constexpr auto readable_protection = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+                region.start = (uintptr_t)mbi.BaseAddress;
+                region.end = region.start + mbi.RegionSize;
+                region.readable = mbi.State == MEM_COMMIT && (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) == 0 && (mbi.Protect & readable_protection) != 0;
+            }
+#else
+            // Only used by the host-side tests.
+            if (auto maps = fopen("/proc/self/maps", "r"); maps != nullptr) {
+                char line[512]{};
+
+                while (fgets(line, sizeof(line), maps) != nullptr) {
+                    unsigned long long start{}, end{};
+                    char perms[5]{};
+
+                    if (sscanf(line, "%llx-%llx %4s", &start, &end, perms) == 3 && address >= start && address < end) {
+                        region = {(uintptr_t)start, (uintptr_t)end, perms[0] == 'r'};
+                        break;
                     }
                 }
-            } catch(...) {
-                // We reached the end of readable memory.
+
+                fclose(maps);
             }
+#endif
         }
+
+        // Regions never overlap, so the position found above is still the sorted one.
+        m_regions.insert(it, region);
+        return region;
     }
 
-    void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth, uint32_t skip_length, uint32_t scan_size) {
-        if (skip_length == 0) {
-            throw std::runtime_error("relocate_pointers: skip_length must be greater than 0");
+    size_t PointerRelocator::get_readable_size(uintptr_t address, size_t size) {
+        size_t result = 0;
+
+        while (result < size) {
+            const auto region = get_region(address + result);
+
+            if (!region.readable) {
+                break;
+            }
+
+            result = std::min<size_t>(size, region.end - address);
+        }
+
+        return result;
+    }
+
+    void PointerRelocator::mark_scanned(uintptr_t start, uintptr_t end) {
+        auto first = m_scanned.upper_bound(start);
+
+        if (first != m_scanned.begin() && std::prev(first)->second >= start) {
+            --first;
+            start = first->first;
         }
 
-        std::unordered_set<uint8_t*> seen{};
-        detail::relocate_pointers(scan_start, old_start, old_end, new_start, depth, skip_length, scan_size, seen);
+        // Swallow every interval that overlaps or touches [start, end), so is_scanned only has to look at one.
+        auto last = first;
+
+        for (; last != m_scanned.end() && last->first <= end; ++last) {
+            end = std::max(end, last->second);
+        }
+
+        m_scanned.emplace_hint(m_scanned.erase(first, last), start, end);
+    }
+
+    bool PointerRelocator::is_scanned(uintptr_t address) const {
+        auto it = m_scanned.upper_bound(address);
+
+        if (it == m_scanned.begin()) {
+            return false;
+        }
+
+        return address < std::prev(it)->second;
+    }
+
+    void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth, uint32_t skip_length, uint32_t scan_size) {
+        const RelocationRange range{old_start, old_end, new_start};
+
+        PointerRelocator relocator{std::span{&range, 1}, skip_length};
+        relocator.scan(scan_start, depth, scan_size);
+        relocator.log_summary(fmt::format("{:x}", (uintptr_t)scan_start));
     }
-}
\ No newline at end of file
+}
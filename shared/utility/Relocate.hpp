@@ -1,7 +1,63 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
+#include <span>
+#include <string_view>
+#include <vector>
 
 namespace utility {
+    struct RelocationRange {
+        uintptr_t old_start{};
+        uintptr_t old_end{};
+        uintptr_t new_start{};
+    };
+
+    // Rewrites every pointer into one of the old ranges to the same offset in its new range while scanning memory.
+    // Memory regions are queried once and cached, and a block is only followed once, so use a single instance
+    // for all the scans that belong to the same move.
+    class PointerRelocator {
+    public:
+        PointerRelocator(std::span<const RelocationRange> ranges, uint32_t skip_length = sizeof(void*));
+
+        // With depth > 0, readable pointers found in the block are followed and 0x1000 bytes are scanned at each.
+        void scan(uint8_t* scan_start, int32_t depth = 0, uint32_t scan_size = 0x1000);
+
+        // One line instead of a line per pointer.
+        void log_summary(std::string_view context) const;
+
+        size_t get_num_relocated() const { return m_num_relocated; }
+        size_t get_num_blocks() const { return m_num_blocks; }
+        size_t get_bytes_scanned() const { return m_bytes_scanned; }
+
+    private:
+        struct Region {
+            uintptr_t start{};
+            uintptr_t end{};
+            bool readable{false};
+        };
+
+        void scan_block(uintptr_t start, int32_t depth, size_t size);
+        void scan_flat(uintptr_t start, size_t num_slots);
+        size_t scan_flat_avx2(uintptr_t start, size_t num_slots); // Returns the number of slots handled
+        void relocate_slot(uintptr_t slot);
+
+        const RelocationRange* find_range(uintptr_t ptr) const;
+        Region get_region(uintptr_t address);
+        size_t get_readable_size(uintptr_t address, size_t size);
+        void mark_scanned(uintptr_t start, uintptr_t end);
+        bool is_scanned(uintptr_t address) const;
+
+        std::vector<RelocationRange> m_ranges{};
+        uint32_t m_skip_length{sizeof(void*)};
+
+        std::vector<Region> m_regions{}; // Sorted, never overlapping
+        std::map<uintptr_t, uintptr_t> m_scanned{}; // Block start -> end, never overlapping or touching
+
+        size_t m_num_relocated{0};
+        size_t m_num_blocks{0};
+        size_t m_bytes_scanned{0};
+    };
+
     void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth = 0, uint32_t skip_length = sizeof(void*), uint32_t scan_size = 0x1000);
 }
@@ -4,22 +4,27 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace genny {
@@ -99,7 +104,7 @@ public:
     // Searches for an owner of the correct type.
     template <typename T> const T* owner() const {
         for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
-            if (owner->is_a<T>()) {
+            if (owner->template is_a<T>()) {
                 return (const T*)owner;
             }
         }
@@ -107,13 +112,13 @@ public:
         return nullptr;
     }
 
-    template <typename T> T* owner() { return (T*)((const Object*)this)->owner<T>(); }
+    template <typename T> T* owner() { return (T*)((const Object*)this)->template owner<T>(); }
 
     template <typename T> const T* topmost_owner() const {
         const T* topmost{};
 
         for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
-            if (owner->is_a<T>()) {
+            if (owner->template is_a<T>()) {
                 topmost = (const T*)owner;
             }
         }
@@ -121,7 +126,7 @@ public:
         return topmost;
     }
 
-    template <typename T> T* topmost_owner() { return (T*)((const Object*)this)->topmost_owner<T>(); }
+    template <typename T> T* topmost_owner() { return (T*)((const Object*)this)->template topmost_owner<T>(); }
 
     auto direct_owner() const { return m_owner; }
 
@@ -129,7 +134,7 @@ public:
         std::vector<T*> owners{};
 
         for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
-            if (owner->is_a<T>()) {
+            if (owner->template is_a<T>()) {
                 owners.emplace_back((T*)owner);
             }
         }
@@ -141,7 +146,7 @@ public:
         std::vector<T*> children{};
 
         for (auto&& child : m_children) {
-            if (child->is_a<T>()) {
+            if (child->template is_a<T>()) {
                 children.emplace_back((T*)child.get());
             }
         }
@@ -160,12 +165,12 @@ public:
     }
 
     template <typename T> bool has_any() const {
-        return std::any_of(m_children.cbegin(), m_children.cend(), [](const auto& child) { return child->is_a<T>(); });
+        return std::any_of(m_children.cbegin(), m_children.cend(), [](const auto& child) { return child->template is_a<T>(); });
     }
 
     template <typename T> bool has_any_in_children() const {
         return std::any_of(m_children.cbegin(), m_children.cend(),
-            [](const auto& child) { return child->is_a<T>() || child->has_any_in_children<T>(); });
+            [](const auto& child) { return child->template is_a<T>() || child->template has_any_in_children<T>(); });
     }
 
     template <typename T> bool is_child_of(T* obj) const {
@@ -182,7 +187,7 @@ public:
 
     template <typename T> T* find(std::string_view name) const {
         for (auto&& child : m_children) {
-            if (child->is_a<T>() && child->m_name == name) {
+            if (child->template is_a<T>() && child->m_name == name) {
                 return (T*)child.get();
             }
         }
@@ -194,7 +199,7 @@ public:
         auto owner = (include_self) ? this : m_owner;
 
         for (; owner != nullptr; owner = owner->m_owner) {
-            if (auto search = owner->find<T>(name)) {
+            if (auto search = owner->template find<T>(name)) {
                 return search;
             }
         }
@@ -246,9 +251,9 @@ public:
     std::function<std::string()> usable_name = [this] {
         std::string name{};
 
-        const auto is_variable_or_fn = this->is_a<Variable>() || this->is_a<Function>();
-        const auto is_ptr_or_ref = this->is_a<Pointer>() || this->is_a<Reference>();
-        const auto is_array = this->is_a<Array>();
+        const auto is_variable_or_fn = this->template is_a<Variable>() || this->template is_a<Function>();
+        const auto is_ptr_or_ref = this->template is_a<Pointer>() || this->template is_a<Reference>();
+        const auto is_array = this->template is_a<Array>();
 
         for (auto&& c : m_name) {
             if (c == ' ' || c == '`' || c == '!' || c == '@' || c == '#' || c == '$' || c == '%' || c == '^' || c == '/' || c == '\\'
@@ -288,7 +293,7 @@ protected:
 };
 
 template <typename T> T* cast(const Object* object) {
-    if (object->is_a<T>()) {
+    if (object->template is_a<T>()) {
         return (T*)object;
     }
 
@@ -306,7 +311,7 @@ public:
         }
 
         if (auto owner_type = owner<Typename>()) {
-            if (obj == nullptr || owner_type != obj->owner<Typename>()) {
+            if (obj == nullptr || owner_type != obj->template owner<Typename>()) {
                 auto&& name = owner_type->name();
 
                 if (!name.empty()) {
@@ -371,14 +376,14 @@ protected:
 };
 
 inline Reference* Type::ref() {
-    return m_owner->find_or_add<Reference>(name() + '&')->to(this);
+    return m_owner->template find_or_add<Reference>(name() + '&')->to(this);
 }
 
 class Pointer : public Reference {
 public:
     explicit Pointer(std::string_view name) : Reference{name} {}
 
-    auto ptr() { return m_owner->find_or_add<Pointer>(m_name + '*')->to(this); }
+    auto ptr() { return m_owner->template find_or_add<Pointer>(m_name + '*')->to(this); }
 
     void generate_typename_for(std::ostream& os, const Object* obj) const override {
         m_to->generate_typename_for(os, obj);
@@ -387,7 +392,7 @@ public:
 };
 
 inline Pointer* Type::ptr() {
-    return (Pointer*)m_owner->find_or_add<Pointer>(name() + '*')->to(this);
+    return (Pointer*)m_owner->template find_or_add<Pointer>(name() + '*')->to(this);
 }
 
 class Array : public Type {
@@ -444,7 +449,7 @@ protected:
 };
 
 inline Array* Type::array_(size_t count) {
-    return (Array*)m_owner->find_or_add<Array>(name() + "[0]")->of(this)->count(count);
+    return (Array*)m_owner->template find_or_add<Array>(name() + "[0]")->of(this)->count(count);
 }
 
 class GenericType : public Type {
@@ -692,7 +697,7 @@ protected:
 
         std::vector<const Object*> owners{};
 
-        for (auto o = owner<Object>(); o != nullptr; o = o->owner<Object>()) {
+        for (auto o = owner<Object>(); o != nullptr; o = o->template owner<Object>()) {
             owners.emplace_back(o);
         }
 
@@ -938,7 +943,7 @@ protected:
 
     template <typename T> T* find_in_parents(std::string_view name) {
         for (auto&& parent : m_parents) {
-            if (auto obj = parent->find<T>(name)) {
+            if (auto obj = parent->template find<T>(name)) {
                 return obj;
             }
         }
@@ -1100,7 +1105,7 @@ protected:
         if (has_any<Function>()) {
             // Generate normal functions normally.
             for (auto&& child : get_all<Function>()) {
-                if (!child->is_a<VirtualFunction>()) {
+                if (!child->template is_a<VirtualFunction>()) {
                     child->generate(os);
                 }
             }
@@ -1139,7 +1144,7 @@ inline Variable* Variable::append() {
     uintptr_t highest_offset{};
     Variable* highest_var{};
 
-    for (auto&& var : struct_->get_all<Variable>()) {
+    for (auto&& var : struct_->template get_all<Variable>()) {
         if (var->offset() >= highest_offset && var != this) {
             highest_offset = var->offset();
             highest_var = var;
@@ -1276,6 +1281,95 @@ public:
         generate_namespace(sdk_path, m_global_ns.get());
     }
 
+    // Same files as generate(sdk_path), byte for byte, with the headers and sources written by num_threads workers.
+    // Each file only depends on the object graph, so objects are handed out in the serial order and the file list
+    // is written in that order at the end. on_progress is called from the workers.
+    void generate(const std::filesystem::path& sdk_path, size_t num_threads,
+        std::function<void(size_t done, size_t total)> on_progress = {}) const {
+        std::filesystem::remove(sdk_path / "file_list.txt");
+
+        std::vector<std::variant<Enum*, Struct*>> objects{};
+        collect_objects(m_global_ns.get(), objects);
+
+        std::vector<std::filesystem::path> header_paths(objects.size());
+        std::set<std::filesystem::path> directories{};
+
+        for (size_t i = 0; i < objects.size(); ++i) {
+            header_paths[i] = std::visit([&](auto obj) { return sdk_path / include_path_for_object(obj); }, objects[i]);
+            directories.emplace(header_paths[i].parent_path());
+        }
+
+        // Sources always sit next to their header.
+        for (auto&& directory : directories) {
+            std::filesystem::create_directories(directory);
+        }
+
+        std::vector<std::string> file_list_entries(objects.size());
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex error_mutex{};
+        std::exception_ptr error{};
+
+        auto worker = [&] {
+            try {
+                for (auto i = next++; i < objects.size(); i = next++) {
+                    auto& entry = file_list_entries[i];
+
+                    std::visit([&](auto obj) {
+                        {
+                            std::ofstream os{header_paths[i]};
+                            generate_header(os, obj);
+                        }
+
+                        entry += "\"" + header_paths[i].string() + "\" \\\n";
+
+                        if (has_source(obj)) {
+                            const auto src_path = sdk_path / source_path_for_object(obj);
+                            std::ofstream os{src_path};
+                            generate_source(os, obj);
+
+                            entry += "\"" + src_path.string() + "\" \\\n";
+                        }
+                    }, objects[i]);
+
+                    if (on_progress) {
+                        on_progress(++done, objects.size());
+                    }
+                }
+            } catch (...) {
+                std::scoped_lock _{error_mutex};
+
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+
+                next = objects.size();
+            }
+        };
+
+        std::vector<std::thread> threads{};
+
+        for (size_t i = 1; i < std::max<size_t>(num_threads, 1); ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto&& t : threads) {
+            t.join();
+        }
+
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+
+        std::ofstream file_list{sdk_path / "file_list.txt"};
+
+        for (auto&& entry : file_list_entries) {
+            file_list << entry;
+        }
+    }
+
     const auto& header_extension() const { return m_header_extension; }
     auto header_extension(std::string_view ext) {
         m_header_extension = ext;
@@ -1306,7 +1400,7 @@ protected:
 
     std::filesystem::path path_for_object(Object* obj) const {
         std::filesystem::path path{};
-        auto owners = obj->owners<Namespace>();
+        auto owners = obj->template owners<Namespace>();
 
         std::reverse(owners.begin(), owners.end());
 
@@ -1349,6 +1443,11 @@ protected:
         std::filesystem::create_directories(obj_inc_path.parent_path());
         std::ofstream os{obj_inc_path};
 
+        generate_header(os, obj);
+    }
+
+    // Only reads the object graph, so different objects can be generated from different threads.
+    template <typename T> void generate_header(std::ostream& os, T* obj) const {
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
             std::string line{};
@@ -1396,10 +1495,10 @@ protected:
             }
         };
 
-        obj->get_all_in_children<Constant>(constants);
-        obj->get_all_in_children<Variable>(variables);
-        obj->get_all_in_children<Function>(functions);
-        obj->get_all_in_children<Struct>(structs);
+        obj->template get_all_in_children<Constant>(constants);
+        obj->template get_all_in_children<Variable>(variables);
+        obj->template get_all_in_children<Function>(functions);
+        obj->template get_all_in_children<Struct>(structs);
 
         for (auto&& c : constants) {
             add_type(c->type());
@@ -1410,7 +1509,7 @@ protected:
         }
 
         for (auto&& fn : functions) {
-            for (auto&& param : fn->get_all<Parameter>()) {
+            for (auto&& param : fn->template get_all<Parameter>()) {
                 add_type(param->type());
             }
             add_type(fn->returns());
@@ -1430,7 +1529,7 @@ protected:
 
         // Go through all the types to include and replace nested types with the types they're nested within.
         for (auto it = types_to_include.begin(); it != types_to_include.end();) {
-            if (auto topmost = (*it)->topmost_owner<Struct>()) {
+            if (auto topmost = (*it)->template topmost_owner<Struct>()) {
                 it = types_to_include.erase(it);
 
                 // Skip adding the topmost owner if it's the object we're generating a header for.
@@ -1453,7 +1552,7 @@ protected:
         for (auto&& type : structs_to_forward_decl) {
             // Only forward decl structs we haven't already included.
             if (types_to_include.find(type) == types_to_include.end() && !type->is_child_of(obj)) {
-                auto owners = type->owners<Namespace>();
+                auto owners = type->template owners<Namespace>();
 
                 if (owners.size() > 1 && m_generate_namespaces) {
                     std::reverse(owners.begin(), owners.end());
@@ -1483,7 +1582,7 @@ protected:
             }
         }
 
-        auto owners = obj->owners<Namespace>();
+        auto owners = obj->template owners<Namespace>();
 
         if (owners.size() > 1 && m_generate_namespaces) {
             std::reverse(owners.begin(), owners.end());
@@ -1523,23 +1622,24 @@ protected:
         }
     }
 
-    template <typename T> void generate_source(const std::filesystem::path& sdk_path, T* obj) const {
+    template <typename T> bool has_source(T* obj) const {
         // Skip generating a source file for an object with no functions.
-        if (!obj->has_any<Function>()) {
-            return;
+        if (!obj->template has_any<Function>()) {
+            return false;
         }
 
         // Skip generating a source file for an object if the functions it does have are all undefined.
-        auto any_defined = false;
-
-        for (auto&& fn : obj->get_all<Function>()) {
+        for (auto&& fn : obj->template get_all<Function>()) {
             if (fn->defined()) {
-                any_defined = true;
-                break;
+                return true;
             }
         }
 
-        if (!any_defined) {
+        return false;
+    }
+
+    template <typename T> void generate_source(const std::filesystem::path& sdk_path, T* obj) const {
+        if (!has_source(obj)) {
             return;
         }
 
@@ -1550,6 +1650,10 @@ protected:
         std::filesystem::create_directories(obj_src_path.parent_path());
         std::ofstream os{obj_src_path};
 
+        generate_source(os, obj);
+    }
+
+    template <typename T> void generate_source(std::ostream& os, T* obj) const {
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
             std::string line{};
@@ -1584,14 +1688,14 @@ protected:
             }
         };
 
-        if (obj->is_a<Type>()) {
+        if (obj->template is_a<Type>()) {
             add_type(obj);
         }
 
-        obj->get_all_in_children<Function>(functions);
+        obj->template get_all_in_children<Function>(functions);
 
         for (auto&& fn : functions) {
-            for (auto&& param : fn->get_all<Parameter>()) {
+            for (auto&& param : fn->template get_all<Parameter>()) {
                 add_type(param->type());
             }
             for (auto&& dependent : fn->dependent_types()) {
@@ -1608,7 +1712,7 @@ protected:
 
         for (auto&& fn : functions) {
             // Skip pure virtual functions.
-            if (fn->is_a<VirtualFunction>() && fn->procedure().empty()) {
+            if (fn->template is_a<VirtualFunction>() && fn->procedure().empty()) {
                 continue;
             }
 
@@ -1626,7 +1730,7 @@ protected:
     }
 
     template <typename T> void generate(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        for (auto&& obj : ns->get_all<T>()) {
+        for (auto&& obj : ns->template get_all<T>()) {
             generate_header(sdk_path, obj);
             generate_source(sdk_path, obj);
         }
@@ -1636,9 +1740,24 @@ protected:
         generate<Enum>(sdk_path, ns);
         generate<Struct>(sdk_path, ns);
 
-        for (auto&& child : ns->get_all<Namespace>()) {
+        for (auto&& child : ns->template get_all<Namespace>()) {
             generate_namespace(sdk_path, child);
         }
     }
+
+    // Objects in the order generate_namespace emits them.
+    void collect_objects(Namespace* ns, std::vector<std::variant<Enum*, Struct*>>& objects) const {
+        for (auto&& obj : ns->template get_all<Enum>()) {
+            objects.emplace_back(obj);
+        }
+
+        for (auto&& obj : ns->template get_all<Struct>()) {
+            objects.emplace_back(obj);
+        }
+
+        for (auto&& child : ns->template get_all<Namespace>()) {
+            collect_objects(child, objects);
+        }
+    }
 };
 } // namespace genny
@@ -14,6 +14,7 @@
 #include <sdk/ReClass.hpp>
 #include <sdk/Renderer.hpp>
 #include "utility/Config.hpp"
+#include "utility/ConfigTable.hpp"
 
 #include "REFramework.hpp"
 
@@ -40,6 +41,7 @@ public:
 
     ModValue(std::string_view config_name, T default_value) 
         : m_config_name{ config_name },
+        m_config_key{ utility::ConfigKeys::intern(config_name) },
         m_value{ default_value }, 
         m_default_value{ default_value }
     {
@@ -48,7 +50,9 @@ public:
     virtual ~ModValue() override {};
 
     virtual void config_load(const utility::Config& cfg) override {
-        auto v = cfg.get<T>(m_config_name);
+        // By key id if the config store bound its table to cfg, by name otherwise.
+        const auto table = utility::ConfigTable::bound_to(cfg);
+        auto v = table != nullptr ? table->get<T>(m_config_key) : cfg.get<T>(m_config_name);
 
         if (v) {
             m_value = *v;
@@ -79,6 +83,7 @@ protected:
     T m_value{};
     T m_default_value{};
     std::string m_config_name{ "Default_ModValue" };
+    uint32_t m_config_key{ utility::ConfigKeys::INVALID };
 };
 
 class ModToggle : public ModValue<bool> {
@@ -264,7 +269,8 @@ public:
     }
 
     void config_load(const utility::Config& cfg) override {
-        auto v = cfg.get(m_config_name);
+        const auto table = utility::ConfigTable::bound_to(cfg);
+        auto v = table != nullptr ? table->get<std::string>(m_config_key) : cfg.get(m_config_name);
         index = 0;
 
         if (v) {
@@ -97,11 +97,12 @@ std::optional<std::string> Mods::on_initialize() const {
         }
     }
 
-    utility::Config cfg{ (REFramework::get_persistent_dir() / REFrameworkConfig::REFRAMEWORK_CONFIG_NAME).string() };
+    const auto snapshot = g_framework->get_config_store().load_snapshot();
+    const utility::ConfigTable::Binding _{snapshot->config, snapshot->table};
 
     for (auto& mod : m_mods) {
         spdlog::info("{:s}::on_config_load()", mod->get_name().data());
-        mod->on_config_load(cfg);
+        mod->on_config_load(snapshot->config);
     }
 
     return std::nullopt;
@@ -111,12 +112,13 @@ std::optional<std::string> Mods::on_initialize() const {
 std::optional<std::string> Mods::on_initialize_d3d_thread() const {
     auto do_not_hook_d3d = g_framework->acquire_do_not_hook_d3d();
 
-    utility::Config cfg{ (REFramework::get_persistent_dir() / REFrameworkConfig::REFRAMEWORK_CONFIG_NAME).string() };
+    const auto snapshot = g_framework->get_config_store().load_snapshot();
+    const utility::ConfigTable::Binding _{snapshot->config, snapshot->table};
 
     // once here to at least setup the values
     for (auto& mod : m_mods) {
         spdlog::info("{:s}::on_config_load()", mod->get_name().data());
-        mod->on_config_load(cfg);
+        mod->on_config_load(snapshot->config);
     }
 
     for (auto& mod : m_mods) {
@@ -130,7 +132,7 @@ std::optional<std::string> Mods::on_initialize_d3d_thread() const {
 
     for (auto& mod : m_mods) {
         spdlog::info("{:s}::on_config_load()", mod->get_name().data());
-        mod->on_config_load(cfg);
+        mod->on_config_load(snapshot->config);
     }
 
     return std::nullopt;
@@ -43,6 +43,7 @@ extern "C" {
 #include "mods/VR.hpp"
 #include "sdk/REGlobals.hpp"
 #include "sdk/Application.hpp"
+#include "sdk/GameObjectNames.hpp"
 #include "sdk/SDK.hpp"
 #include <sdk/GameIdentity.hpp>
 
@@ -264,6 +265,8 @@ REFramework::REFramework(HMODULE reframework_module)
 
     m_logger->sinks().push_back(m_dist_sink);
 
+    m_config_store = std::make_unique<utility::ConfigStore>(get_persistent_dir(REFrameworkConfig::REFRAMEWORK_CONFIG_NAME.data()));
+
     std::scoped_lock __{m_startup_mutex};
     const auto& gi = sdk::GameIdentity::get();
 
@@ -590,15 +593,14 @@ REFramework::REFramework(HMODULE reframework_module)
             FaultyFileDetector::get(); // Initialize early
         }
 
-        const auto config_path = get_persistent_dir(REFrameworkConfig::REFRAMEWORK_CONFIG_NAME.data()).string();
-        if (fs::exists(utility::widen(config_path))) {
-            utility::Config cfg{ config_path };
-            loader->on_config_load(cfg);
+        if (fs::exists(m_config_store->path())) {
+            const auto cfg = m_config_store->load();
+            loader->on_config_load(*cfg);
 
             if (has_faulty_file_detector) {
-                FaultyFileDetector::get()->on_config_load(cfg);
+                FaultyFileDetector::get()->on_config_load(*cfg);
             }
-            integrity_bypass->on_config_load(cfg);
+            integrity_bypass->on_config_load(*cfg);
         }
 
         if (loader->is_enabled()) {
@@ -816,7 +818,7 @@ REFramework::~REFramework() {
 
     if (ui_layout_save_pending) {
         if (m_mods_fully_initialized && can_save_imgui_config) {
-            save_config();
+            save_config(true);
 
             if (const auto* ini_filename = ImGui::GetIO().IniFilename; ini_filename != nullptr) {
                 ImGui::SaveIniSettingsToDisk(ini_filename);
@@ -824,7 +826,7 @@ REFramework::~REFramework() {
         }
     } else {
         if (m_wants_save_config && m_mods_fully_initialized) {
-            save_config();
+            save_config(true);
         }
 
         if (can_save_imgui_config) {
@@ -834,6 +836,11 @@ REFramework::~REFramework() {
         }
     }
 
+    // Anything saved earlier that the writer thread hasn't gotten to yet.
+    if (!m_config_store->flush()) {
+        spdlog::error("Failed to write {} on shutdown", REFrameworkConfig::REFRAMEWORK_CONFIG_NAME.data());
+    }
+
     if (m_is_d3d11) {
         deinit_d3d11();
     }
@@ -1471,7 +1478,7 @@ std::filesystem::path REFramework::get_persistent_dir() {
     return std::filesystem::path(*utility::get_module_path(utility::get_executable())).parent_path();
 }
 
-void REFramework::save_config() {
+void REFramework::save_config(bool write_now) {
     std::scoped_lock _{m_config_mtx};
 
     m_wants_save_config = false;
@@ -1484,20 +1491,13 @@ void REFramework::save_config() {
         mod->on_config_save(cfg);
     }
 
-    try {
-        if (!cfg.save((get_persistent_dir() / REFrameworkConfig::REFRAMEWORK_CONFIG_NAME.data()).string())) {
-            spdlog::error("Failed to save config");
-            return;
-        }
-    } catch(const std::exception& e) {
-        spdlog::error("Failed to save config: {}", e.what());
-        return;
-    } catch(...) {
-        spdlog::error("Unexpected error while saving config");
+    if (write_now) {
+        m_config_store->save_now(std::move(cfg));
         return;
     }
 
-    spdlog::info("Saved config");
+    // Written by the store's thread, failures are logged there and retried.
+    m_config_store->save(std::move(cfg));
 }
 
 void REFramework::set_draw_ui(bool state, bool should_save) {
@@ -1790,13 +1790,11 @@ void REFramework::preserve_main_window_position(const char* window_name) {
 
     if (!m_loaded_saved_ui_display_size) {
         m_loaded_saved_ui_display_size = true;
-        const auto config_path = get_persistent_dir(REFrameworkConfig::REFRAMEWORK_CONFIG_NAME.data()).string();
-
-        if (fs::exists(utility::widen(config_path))) {
-            const utility::Config cfg{config_path};
+        if (fs::exists(m_config_store->path())) {
+            const auto cfg = m_config_store->load();
             m_saved_ui_display_size = ImVec2{
-                static_cast<float>(cfg.get<int32_t>(REFrameworkConfig::UI_MONITOR_WIDTH_CONFIG_NAME.data()).value_or(0)),
-                static_cast<float>(cfg.get<int32_t>(REFrameworkConfig::UI_MONITOR_HEIGHT_CONFIG_NAME.data()).value_or(0))};
+                static_cast<float>(cfg->get<int32_t>(REFrameworkConfig::UI_MONITOR_WIDTH_CONFIG_NAME.data()).value_or(0)),
+                static_cast<float>(cfg->get<int32_t>(REFrameworkConfig::UI_MONITOR_HEIGHT_CONFIG_NAME.data()).value_or(0))};
         }
     }
 
@@ -2509,6 +2507,8 @@ void REFramework::call_on_frame() {
     const bool is_init_ok = m_error.empty() && m_game_data_initialized;
 
     if (is_init_ok) {
+        sdk::GameObjectNames::get().begin_frame();
+
         // Run mod frame callbacks.
         m_mods->on_frame();
     }
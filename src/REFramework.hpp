@@ -22,6 +22,8 @@ class RETypes;
 #include "DInputHook.hpp"
 #include "WindowsMessageHook.hpp"
 
+#include "utility/ConfigStore.hpp"
+
 // Global facilitator
 class REFramework {
 private:
@@ -96,6 +98,11 @@ public:
         m_wants_save_config = true;
     }
 
+    // Shared parse of the main config file, use this instead of constructing a utility::Config from it.
+    utility::ConfigStore& get_config_store() {
+        return *m_config_store;
+    }
+
     enum class RendererType : uint8_t {
         D3D11,
         D3D12
@@ -167,7 +174,8 @@ public:
     }
 
 private:
-    void save_config();
+    // write_now writes the file before returning instead of leaving it to the config store's thread.
+    void save_config(bool write_now = false);
     void consume_input();
     void init_fonts();
     void invalidate_device_objects();
@@ -253,6 +261,7 @@ private:
 
     std::mutex m_input_mutex{};
     std::recursive_mutex m_config_mtx{};
+    std::unique_ptr<utility::ConfigStore> m_config_store{};
     std::recursive_mutex m_imgui_mtx{};
     std::recursive_mutex m_patch_mtx{};
 
@@ -8,6 +8,7 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <utility/String.hpp>
 #include <utility/Module.hpp>
+#include <utility/Fnv1a.hpp>
 #include <utility/Scan.hpp>
 
 #include <safetyhook/mid_hook.hpp>
@@ -84,6 +85,21 @@ FaultyFileDetector::FaultyFileDetector() {
     m_logger->flush_on(spdlog::level::info);
 
     m_logger->set_pattern("\"%l\" %v");
+
+    m_consumer_thread = std::make_unique<std::jthread>([this](std::stop_token stop_token) {
+        consumer_thread_proc(stop_token);
+    });
+}
+
+FaultyFileDetector::~FaultyFileDetector() {
+    if (m_consumer_thread != nullptr) {
+        m_consumer_thread->request_stop();
+        m_consumer_thread.reset();
+    }
+
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
 }
 
 std::optional<std::string> FaultyFileDetector::on_initialize() {
@@ -379,27 +395,20 @@ void FaultyFileDetector::resource_parse_open_stream_failed_hook(safetyhook::Cont
 
     REResource_Via_Raw* resource = disasm_utils::get_register_value<REResource_Via_Raw*>(ctx, m_resource_open_failed_register);
 
-    if (resource) {
-        try_add_to_faulty_list(resource->path, FaultyTier::Severe, FaultyReason::MissingFile);
+    if (resource && resource->path) {
+        try_add_to_faulty_list(resource->path, FaultyTier::Severe, FaultyReason::MissingFile, resource);
     }
 }
 
+// The resource being parsed on this loading thread, set right before the parse call.
+static thread_local REResource_Via_Raw* t_resource_being_parsed{nullptr};
+
 void FaultyFileDetector::resource_set_argument_hook(safetyhook::Context& ctx) {
     if (!m_enabled->value()) {
         return;
     }
 
-    void *resource_ptr = reinterpret_cast<void*>(ctx.rcx);
-    std::thread::id thread_id = std::this_thread::get_id();
-
-    REResource_Via_Raw* resource = reinterpret_cast<REResource_Via_Raw*>(resource_ptr);
-
-    //spdlog::info("[FaultyFileDetector]: resource_set_argument_hook called for resource path: {}", utility::narrow(resource->path));
-
-    {
-        std::scoped_lock lock{m_mutex};
-        m_resource_by_thread_map[thread_id] = resource_ptr;
-    }
+    t_resource_being_parsed = reinterpret_cast<REResource_Via_Raw*>(ctx.rcx);
 }
 
 void FaultyFileDetector::resource_parse_finish_hook(safetyhook::Context& ctx) {
@@ -411,35 +420,97 @@ void FaultyFileDetector::resource_parse_finish_hook(safetyhook::Context& ctx) {
     bool parse_result = ctx.rax & 0x1; // First arg is parse result (0 = fail, 1 = success)
 
     if (!parse_result) {
-        auto thread_id = std::this_thread::get_id();
-        REResource_Via_Raw* resource = nullptr;
-
-        {
-            std::scoped_lock lock{m_mutex};
+        auto resource = t_resource_being_parsed;
 
-            if (!m_resource_by_thread_map.contains(thread_id)) {
-                return;
-            } else {
-                resource = reinterpret_cast<REResource_Via_Raw*>(m_resource_by_thread_map[thread_id]);
-            }
-        }
-
-        // Get resource pointer from register
-        if (resource != nullptr) {
-            // Log parsed resource path for debugging
-            // Get resource name
-            std::wstring_view resource_path(resource->path);
-            try_add_to_faulty_list(resource_path, FaultyTier::Severe, FaultyReason::Invalid);
+        if (resource != nullptr && resource->path != nullptr) {
+            try_add_to_faulty_list(resource->path, FaultyTier::Severe, FaultyReason::Invalid, resource);
         }
     }
 }
 
-void FaultyFileDetector::try_add_to_faulty_list(std::wstring_view filename, FaultyTier tier, FaultyReason reason) {
+// Never 0, 0 marks an empty recently queued slot.
+static uint64_t hash_faulty_path(std::wstring_view path) {
+    const auto hash = utility::fnv1a::hash64(path);
+    return hash != 0 ? hash : 1;
+}
+
+void FaultyFileDetector::try_add_to_faulty_list(std::wstring_view filename, FaultyTier tier, FaultyReason reason, void* resource) {
     if (filename.empty()) {
         return;
     }
 
-    std::wstring name_wstr{filename};
+    const auto path_hash = hash_faulty_path(filename) ^ (uint64_t)reason;
+    auto& recent = m_recently_queued[path_hash % RECENTLY_QUEUED_SIZE];
+
+    if (recent.load(std::memory_order_relaxed) == path_hash) {
+        return;
+    }
+
+    recent.store(path_hash, std::memory_order_relaxed);
+
+    const auto pushed = m_pending_records.try_push([&](FaultyRecord& record) {
+        record.resource = resource;
+        record.path_hash = path_hash;
+        record.tier = tier;
+        record.reason = reason;
+        record.path_length = (uint16_t)std::min(filename.size(), record.path.size());
+        std::copy_n(filename.data(), record.path_length, record.path.data());
+    });
+
+    if (!pushed) {
+        // Let the next failure of this file try again.
+        recent.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    // Pairs with the fence in consumer_thread_proc: either the consumer sees this record before
+    // going idle, or we see it idle and wake it. Only the first push after an idle period locks.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_consumer_idle.load(std::memory_order_relaxed) && m_consumer_idle.exchange(false)) {
+        {
+            std::scoped_lock _{m_consumer_mutex};
+            m_consumer_wake_requested = true;
+        }
+
+        m_consumer_cv.notify_one();
+    }
+}
+
+void FaultyFileDetector::consumer_thread_proc(std::stop_token stop_token) {
+    const auto woken = [this] { return std::exchange(m_consumer_wake_requested, false); };
+
+    while (!stop_token.stop_requested()) {
+        const auto drained = m_pending_records.drain([this](const FaultyRecord& record) {
+            process_faulty_record(record);
+        });
+
+        std::unique_lock lock{m_consumer_mutex};
+
+        // Failures come in bursts while loading, collect the rest of the burst before draining again.
+        if (drained > 0) {
+            m_consumer_cv.wait_for(lock, stop_token, CONSUMER_BATCH_INTERVAL, [] { return false; });
+            continue;
+        }
+
+        m_consumer_idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Something was pushed between the drain and going idle.
+        if (!m_pending_records.empty()) {
+            m_consumer_idle.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        m_consumer_cv.wait(lock, stop_token, woken);
+        m_consumer_idle.store(false, std::memory_order_relaxed);
+    }
+}
+
+void FaultyFileDetector::process_faulty_record(const FaultyRecord& record) {
+    std::wstring name_wstr{record.path.data(), record.path_length};
+    const auto reason = record.reason;
+    const auto tier = record.tier;
 
     bool should_log = false;
     
@@ -455,25 +526,21 @@ void FaultyFileDetector::try_add_to_faulty_list(std::wstring_view filename, Faul
             reason_deque.push_front(name_wstr);
             
             // Trim recent files to max size for this reason
-            if (reason_deque.size() > m_max_recent_files->value()) {
-                while (reason_deque.size() > m_max_recent_files->value()) {
-                    reason_deque.pop_back();
-                }
+            if (reason_deque.size() > (size_t)std::max(m_max_recent_files->value(), 0)) {
+                reason_deque.resize((size_t)std::max(m_max_recent_files->value(), 0));
             }
 
-            should_log = true;
-        }
-    }
-
-    if (should_log) {
-        // Push a toast notification
-        {
-            std::scoped_lock lock2{m_mutex};
+            // Push a toast notification
             Notification notif{};
             notif.text = std::format("[{}] {}", faulty_reason_to_string(reason), utility::narrow(name_wstr));
             notif.reason = reason;
             m_notifications.push_back(std::move(notif));
+
+            should_log = true;
         }
+    }
+
+    if (should_log) {
         // Log the faulty file to dedicated log file
         auto log_msg = std::format("{} \"{}\" \"{}\"", (int)reason, faulty_reason_to_string(reason), utility::narrow(name_wstr));
 
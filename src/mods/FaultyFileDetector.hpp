@@ -4,15 +4,20 @@
 #include "sdk/ResourceManager.hpp"
 
 #include <safetyhook.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <map>
-#include <regex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
 #include <spdlog/spdlog.h>
 #include <utility/Scan.hpp>
 
+#include "utility/LockFree.hpp"
+
 #include <sdk/TDBVer.hpp>
 
 #ifdef REFRAMEWORK_UNIVERSAL
@@ -45,6 +50,7 @@ public:
     };
 
     FaultyFileDetector();
+    ~FaultyFileDetector() override;
 
     std::string_view get_name() const override { return "FaultyFileDetector"; };
 
@@ -70,7 +76,23 @@ private:
     static void resource_set_argument_hook_wrapper(safetyhook::Context& ctx);
     void resource_set_argument_hook(safetyhook::Context& ctx);
 
-    void try_add_to_faulty_list(std::wstring_view filename, FaultyTier tier = FaultyTier::Severe, FaultyReason reason = FaultyReason::Unknown);
+    // Called from the loading threads, only copies the record into m_pending_records.
+    void try_add_to_faulty_list(std::wstring_view filename, FaultyTier tier = FaultyTier::Severe, FaultyReason reason = FaultyReason::Unknown, void* resource = nullptr);
+
+    static constexpr size_t MAX_RECORD_PATH_LENGTH = 260;
+
+    struct FaultyRecord {
+        void* resource{nullptr};
+        uint64_t path_hash{};
+        FaultyTier tier{FaultyTier::None};
+        FaultyReason reason{FaultyReason::Unknown};
+        uint16_t path_length{};
+        std::array<wchar_t, MAX_RECORD_PATH_LENGTH> path{};
+    };
+
+    // Consumer thread side: dedup, bookkeeping, notifications and logging.
+    void consumer_thread_proc(std::stop_token stop_token);
+    void process_faulty_record(const FaultyRecord& record);
 
     bool scan_resource_process_parse_and_hook();
     utility::ExhaustionResult scan_for_resource_open_failed_hook(utility::ExhaustionContext& ctx);
@@ -84,7 +106,6 @@ private:
     std::shared_ptr<spdlog::logger> m_logger{};
     safetyhook::InlineHook m_create_resource_original{};
     safetyhook::MidHook m_resource_parse_finish_hook{};
-    std::map<std::thread::id, void*> m_resource_by_thread_map{};
     std::vector<safetyhook::MidHook> m_resource_parse_finish_hooks{};
     std::vector<safetyhook::MidHook> m_resource_set_argument_hooks{};
     safetyhook::MidHook m_resource_open_failed_hook{};
@@ -92,6 +113,20 @@ private:
     uint8_t m_resource_open_failed_register{0};
     bool m_initialized{false};
 
+    // Loading threads push, m_consumer_thread drains. Paths that were queued recently are filtered out
+    // before they reach the ring so a file failing on every frame doesn't flood it.
+    // With nothing queued (always, while disabled) the consumer sleeps until the next push wakes it.
+    static constexpr size_t RECENTLY_QUEUED_SIZE = 256;
+    static constexpr auto CONSUMER_BATCH_INTERVAL = std::chrono::milliseconds{50};
+
+    utility::MpscRing<FaultyRecord, 512> m_pending_records{};
+    std::array<std::atomic<uint64_t>, RECENTLY_QUEUED_SIZE> m_recently_queued{};
+    std::mutex m_consumer_mutex{};
+    std::condition_variable_any m_consumer_cv{};
+    bool m_consumer_wake_requested{false}; // Guarded by m_consumer_mutex
+    std::atomic<bool> m_consumer_idle{false};
+    std::unique_ptr<std::jthread> m_consumer_thread{};
+
     struct Notification {
         std::string text;
         FaultyReason reason;
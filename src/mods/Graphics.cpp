@@ -1172,7 +1172,7 @@ void Graphics::setup_rt_component() {
         return;
     }
 
-    auto rt_component = game_object->get_transform()->find<REComponent>(rt_t->get_type());
+    auto rt_component = game_object->get_transform()->find<REComponent>(rt_t);
     
     // Attempt to create the component if it doesn't exist
     if (rt_component == nullptr || (m_ray_trace_always_recreate_rt_component->value() && m_rt_recreated_component.get() != (sdk::ManagedObject*)rt_component)) {
@@ -0,0 +1,232 @@
+#include <algorithm>
+
+#include <utility/String.hpp>
+
+#include "LooseFileAccessLog.hpp"
+
+LooseFileAccessLog::LooseFileAccessLog(std::shared_ptr<spdlog::logger> accessed_logger, std::shared_ptr<spdlog::logger> loose_logger)
+    : m_accessed_logger{std::move(accessed_logger)},
+    m_loose_logger{std::move(loose_logger)}
+{
+    m_writer = std::make_unique<std::jthread>([this](std::stop_token stop_token) { writer_proc(stop_token); });
+}
+
+LooseFileAccessLog::~LooseFileAccessLog() {
+    if (m_writer != nullptr) {
+        m_writer->request_stop();
+        m_writer.reset();
+    }
+}
+
+LooseFileAccessLog::Ring& LooseFileAccessLog::get_ring() {
+    // There's only one LooseFileLoader, so one ring per thread is enough.
+    thread_local std::shared_ptr<Ring> ring{};
+
+    if (ring == nullptr) {
+        ring = std::make_shared<Ring>();
+
+        std::scoped_lock _{m_rings_mutex};
+        m_rings.push_back(ring);
+    }
+
+    return *ring;
+}
+
+void LooseFileAccessLog::push(const wchar_t* path, size_t hash, uint8_t flags) {
+    get_ring().try_push([&](Record& record) {
+        // Assigning into the slot reuses its buffer, so steady state pushes don't allocate.
+        record.path.assign(path);
+        record.hash = hash;
+        record.flags = flags;
+        record.time = spdlog::log_clock::now();
+    });
+
+    // Pairs with the fence in writer_proc: either the writer sees this record before going idle,
+    // or we see m_idle and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_idle.load(std::memory_order_relaxed) && m_idle.exchange(false)) {
+        wake_writer();
+        return;
+    }
+
+    // Loading screens can fill a ring well before the next interval, wake the writer early.
+    thread_local size_t num_pushed{0};
+
+    if ((++num_pushed & (RING_CAPACITY / 4 - 1)) == 0) {
+        m_wake_requested.store(true, std::memory_order_relaxed);
+        m_wake.notify_one();
+    }
+}
+
+void LooseFileAccessLog::wake_writer() {
+    {
+        // Under the lock so the writer can't be between checking the flag and blocking.
+        std::scoped_lock _{m_wake_mutex};
+        m_wake_requested.store(true, std::memory_order_relaxed);
+    }
+
+    m_wake.notify_one();
+}
+
+void LooseFileAccessLog::writer_proc(std::stop_token stop_token) {
+    const auto woken = [this] { return m_wake_requested.exchange(false, std::memory_order_relaxed); };
+
+    while (!stop_token.stop_requested()) {
+        // Busy: keep batching at WRITE_INTERVAL.
+        if (drain() > 0) {
+            std::unique_lock lock{m_wake_mutex};
+            m_wake.wait_for(lock, stop_token, WRITE_INTERVAL, woken);
+            continue;
+        }
+
+        std::unique_lock lock{m_wake_mutex};
+
+        m_idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Something landed between the drain and going idle.
+        if (has_pending()) {
+            m_idle.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        m_wake.wait(lock, stop_token, woken);
+        m_idle.store(false, std::memory_order_relaxed);
+    }
+
+    drain();
+}
+
+bool LooseFileAccessLog::has_pending() {
+    std::scoped_lock _{m_rings_mutex};
+
+    return std::any_of(m_rings.begin(), m_rings.end(), [](const std::shared_ptr<Ring>& ring) { return !ring->empty(); });
+}
+
+// Returns the number of records processed.
+size_t LooseFileAccessLog::drain() {
+    std::vector<std::shared_ptr<Ring>> rings{};
+    size_t count = 0;
+
+    {
+        std::scoped_lock _{m_rings_mutex};
+        rings = m_rings;
+    }
+
+    m_batch.clear();
+
+    const auto collect = [this](const Record& record) {
+        m_batch.push_back({utility::narrow(record.path), record.hash, record.flags, record.time});
+    };
+
+    for (auto& ring : rings) {
+        count += ring->drain(collect);
+    }
+
+    rings.clear();
+
+    // Rings whose thread exited can't get new records, drain what's left and let them go.
+    {
+        std::scoped_lock _{m_rings_mutex};
+
+        std::erase_if(m_rings, [&](const std::shared_ptr<Ring>& ring) {
+            if (ring.use_count() != 1) {
+                return false;
+            }
+
+            count += ring->drain(collect);
+            m_dropped_from_retired_rings += ring->dropped();
+            return true;
+        });
+    }
+
+    if (m_batch.empty()) {
+        return count;
+    }
+
+    write_logs();
+    update_view();
+
+    if (m_needs_flush) {
+        m_accessed_logger->flush();
+        m_loose_logger->flush();
+        m_needs_flush = false;
+    }
+
+    return count;
+}
+
+// The file I/O, done without m_view_mutex so the UI never waits on it.
+void LooseFileAccessLog::write_logs() {
+    for (const auto& entry : m_batch) {
+        if ((entry.flags & LOG_ACCESSED) != 0 && m_logged_accessed.insert(entry.hash).second) {
+            m_accessed_logger->log(entry.time, spdlog::source_loc{}, spdlog::level::info, entry.path);
+            m_needs_flush = true;
+        }
+
+        if ((entry.flags & (LOOSE | LOG_LOOSE)) == (LOOSE | LOG_LOOSE) && m_logged_loose.insert(entry.hash).second) {
+            m_loose_logger->log(entry.time, spdlog::source_loc{}, spdlog::level::info, entry.path);
+            m_needs_flush = true;
+        }
+    }
+}
+
+void LooseFileAccessLog::update_view() {
+    std::unique_lock _{m_view_mutex};
+
+    for (const auto& entry : m_batch) {
+        const auto loose = (entry.flags & LOOSE) != 0;
+        const auto new_file = m_counted_files.insert(entry.hash).second;
+        const auto new_loose_file = loose && m_counted_loose_files.insert(entry.hash).second;
+
+        if (new_file || new_loose_file) {
+            const auto separator = entry.path.find_last_of("\\/");
+            auto& stats = m_directories[separator != std::string::npos ? entry.path.substr(0, separator) : std::string{}];
+
+            stats.files += new_file ? 1 : 0;
+            stats.loose_files += new_loose_file ? 1 : 0;
+        }
+
+        if ((entry.flags & SHOW_RECENT) == 0) {
+            continue;
+        }
+
+        m_recent_accessed_files.push_front(entry.path);
+
+        if (m_recent_accessed_files.size() > MAX_RECENT) {
+            m_recent_accessed_files.pop_back();
+        }
+
+        if (loose) {
+            m_recent_loose_files.push_front(entry.path);
+
+            if (m_recent_loose_files.size() > MAX_RECENT) {
+                m_recent_loose_files.pop_back();
+            }
+        }
+    }
+}
+
+void LooseFileAccessLog::clear_stats() {
+    std::unique_lock _{m_view_mutex};
+
+    m_recent_accessed_files.clear();
+    m_recent_loose_files.clear();
+    m_counted_files.clear();
+    m_counted_loose_files.clear();
+    m_directories.clear();
+}
+
+uint64_t LooseFileAccessLog::get_dropped() {
+    // Under the lock, a ring moves into the retired count while it's held.
+    std::scoped_lock _{m_rings_mutex};
+
+    uint64_t dropped = m_dropped_from_retired_rings;
+
+    for (const auto& ring : m_rings) {
+        dropped += ring->dropped();
+    }
+
+    return dropped;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "utility/LockFree.hpp"
+
+// Component class owned by LooseFileLoader — not a standalone Mod.
+// Collects the paths LooseFileLoader sees without doing any I/O on the hooked threads.
+// Every thread pushes into its own ring, a background thread drains them, writes the logs
+// in batches with one flush each and keeps the recent files and per directory counts for the UI.
+// While nothing is being pushed the writer sleeps without a timeout until the next push wakes it.
+class LooseFileAccessLog {
+public:
+    enum Flags : uint8_t {
+        LOOSE = 1 << 0, // The file exists on disk
+        SHOW_RECENT = 1 << 1,
+        LOG_ACCESSED = 1 << 2,
+        LOG_LOOSE = 1 << 3,
+    };
+
+    static constexpr size_t RING_CAPACITY = 2048;
+    static constexpr size_t MAX_RECENT = 100;
+    static constexpr auto WRITE_INTERVAL = std::chrono::milliseconds{100};
+
+    LooseFileAccessLog(std::shared_ptr<spdlog::logger> accessed_logger, std::shared_ptr<spdlog::logger> loose_logger);
+    ~LooseFileAccessLog();
+
+    LooseFileAccessLog(const LooseFileAccessLog&) = delete;
+    LooseFileAccessLog& operator=(const LooseFileAccessLog&) = delete;
+
+    // Called from the hook. Never blocks, the record is dropped if this thread's ring is full.
+    void push(const wchar_t* path, size_t hash, uint8_t flags);
+
+    void on_draw_ui(); // LooseFileAccessLogUI.cpp, so the rest builds without ImGui
+    void clear_stats();
+
+    // Records lost to full rings, including the rings of threads that have exited.
+    uint64_t get_dropped();
+
+private:
+    struct Record {
+        std::wstring path{};
+        size_t hash{};
+        uint8_t flags{};
+        spdlog::log_clock::time_point time{};
+    };
+
+    using Ring = utility::MpscRing<Record, RING_CAPACITY>;
+
+    // A drained record with its path already narrowed, so neither the log writes nor the view update do it.
+    struct BatchEntry {
+        std::string path{};
+        size_t hash{};
+        uint8_t flags{};
+        spdlog::log_clock::time_point time{};
+    };
+
+    struct DirectoryStats {
+        uint32_t files{};
+        uint32_t loose_files{};
+    };
+
+    Ring& get_ring();
+    void wake_writer();
+    void writer_proc(std::stop_token stop_token);
+    bool has_pending();
+    size_t drain();
+    void write_logs();
+    void update_view();
+
+    std::shared_ptr<spdlog::logger> m_accessed_logger{};
+    std::shared_ptr<spdlog::logger> m_loose_logger{};
+
+    std::mutex m_rings_mutex{};
+    std::vector<std::shared_ptr<Ring>> m_rings{};
+    std::atomic<uint64_t> m_dropped_from_retired_rings{0};
+
+    // Only touched by the writer.
+    std::vector<BatchEntry> m_batch{};
+    std::unordered_set<size_t> m_logged_accessed{};
+    std::unordered_set<size_t> m_logged_loose{};
+    bool m_needs_flush{false};
+
+    std::shared_mutex m_view_mutex{};
+    std::deque<std::string> m_recent_accessed_files{};
+    std::deque<std::string> m_recent_loose_files{};
+    std::unordered_set<size_t> m_counted_files{};
+    std::unordered_set<size_t> m_counted_loose_files{};
+    std::map<std::string, DirectoryStats> m_directories{};
+
+    std::mutex m_wake_mutex{};
+    std::condition_variable_any m_wake{};
+    std::atomic<bool> m_wake_requested{false};
+    std::atomic<bool> m_idle{false}; // The writer found nothing to do and is (about to be) waiting without a timeout
+    std::unique_ptr<std::jthread> m_writer{};
+};
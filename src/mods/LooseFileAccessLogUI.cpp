@@ -0,0 +1,70 @@
+#include <imgui.h>
+
+#include "LooseFileAccessLog.hpp"
+
+void LooseFileAccessLog::on_draw_ui() {
+    if (const auto dropped = get_dropped(); dropped > 0) {
+        ImGui::TextWrapped("Dropped records: %llu", (unsigned long long)dropped);
+    }
+
+    std::shared_lock _{m_view_mutex};
+
+    if (ImGui::TreeNode("Recent accessed files")) {
+        for (const auto& file : m_recent_accessed_files) {
+            ImGui::TextWrapped("%s", file.c_str());
+        }
+
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Recent loose files")) {
+        for (const auto& file : m_recent_loose_files) {
+            ImGui::TextWrapped("%s", file.c_str());
+        }
+
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Directories")) {
+        constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+
+        if (ImGui::BeginTable("LooseFileDirectories", 3, flags, ImVec2{0.0f, ImGui::GetTextLineHeightWithSpacing() * 16.0f})) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Directory", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Files", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("Loose", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper{};
+            clipper.Begin((int)m_directories.size());
+
+            auto it = m_directories.begin();
+            int row = 0;
+
+            while (clipper.Step()) {
+                if (clipper.DisplayStart < row) {
+                    it = m_directories.begin();
+                    row = 0;
+                }
+
+                for (; row < clipper.DisplayStart; ++row) {
+                    ++it;
+                }
+
+                for (; row < clipper.DisplayEnd; ++row, ++it) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(it->first.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", it->second.files);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", it->second.loose_files);
+                }
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::TreePop();
+    }
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <iterator>
+
+#include <utility/Fnv1a.hpp>
+
+#include "LooseFileExistenceCache.hpp"
+
+namespace {
+wchar_t fold_char(wchar_t c) {
+    // Only ASCII is folded, the game's paths don't use anything else.
+    if (c >= L'A' && c <= L'Z') {
+        return c - L'A' + L'a';
+    }
+
+    return c == L'\\' ? L'/' : c;
+}
+
+struct L1Cache {
+    uint32_t generation{UINT32_MAX};
+    uint64_t slots[LooseFileExistenceCache::L1_SIZE]{};
+};
+
+thread_local L1Cache t_l1{};
+
+// Counted before the table pointer is loaded, see try_reclaim_locked.
+class ReaderGuard {
+public:
+    ReaderGuard(std::atomic<uint32_t>& readers) : m_readers{readers} {
+        m_readers.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    ~ReaderGuard() {
+        m_readers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+private:
+    std::atomic<uint32_t>& m_readers;
+};
+}
+
+LooseFileExistenceCache::Table::Table(uint32_t generation, bool verify_keys)
+    : slots{std::make_unique<std::atomic<uint64_t>[]>(CAPACITY)},
+    generation{generation}
+{
+    if (verify_keys) {
+        keys = std::make_unique<std::wstring[]>(CAPACITY);
+    }
+}
+
+LooseFileExistenceCache::LooseFileExistenceCache() {
+    m_owned_table = std::make_unique<Table>(m_generation++, m_verify_keys);
+    m_table.store(m_owned_table.get(), std::memory_order_release);
+    m_current_generation.store(m_owned_table->generation, std::memory_order_release);
+}
+
+uint64_t LooseFileExistenceCache::hash_path(const wchar_t* path) {
+    // FNV-1a, then a final mix so the low bits used for the slot index are well distributed.
+    auto hash = utility::fnv1a::OFFSET_BASIS;
+
+    for (auto p = path; *p != L'\0'; ++p) {
+        hash = utility::fnv1a::step(hash, (uint16_t)fold_char(*p));
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+std::wstring LooseFileExistenceCache::fold_path(const wchar_t* path) {
+    std::wstring result{path};
+
+    for (auto& c : result) {
+        c = fold_char(c);
+    }
+
+    return result;
+}
+
+bool LooseFileExistenceCache::key_matches(const std::wstring& folded, const wchar_t* path) {
+    size_t i = 0;
+
+    for (; path[i] != L'\0'; ++i) {
+        if (i >= folded.size() || folded[i] != fold_char(path[i])) {
+            return false;
+        }
+    }
+
+    return i == folded.size();
+}
+
+LooseFileExistenceCache::Result LooseFileExistenceCache::check(const wchar_t* path, ProbeFn probe) {
+    const auto hash = hash_path(path);
+    const auto key = make_key(hash);
+
+    const auto use_l1 = m_use_l1.load(std::memory_order_relaxed);
+    auto& l1 = t_l1;
+
+    if (use_l1) {
+        const auto generation = m_current_generation.load(std::memory_order_acquire);
+
+        if (l1.generation != generation) {
+            std::fill(std::begin(l1.slots), std::end(l1.slots), 0);
+            l1.generation = generation;
+        }
+
+        const auto word = l1.slots[(hash >> 32) & (L1_SIZE - 1)];
+
+        if ((word & ~STATE_MASK) == key) {
+            return {(word & STATE_MASK) == PRESENT, false, true};
+        }
+    }
+
+    const auto remember = [&](uint64_t word) {
+        if (use_l1) {
+            l1.slots[(hash >> 32) & (L1_SIZE - 1)] = word;
+        }
+    };
+
+    // A word remembered from a table cleared in the meantime is dropped with the L1 on the next call.
+    const ReaderGuard reader{m_active_readers};
+    const auto table = m_table.load(std::memory_order_seq_cst);
+
+    for (size_t i = 0; i < MAX_PROBES; ++i) {
+        const auto index = (hash + i) & (CAPACITY - 1);
+        auto& slot = table->slots[index];
+        auto word = slot.load(std::memory_order_acquire);
+
+        if (word == 0) {
+            if (table->size.load(std::memory_order_relaxed) >= MAX_ENTRIES) {
+                break;
+            }
+
+            if (slot.compare_exchange_strong(word, key | PENDING, std::memory_order_acq_rel)) {
+                table->size.fetch_add(1, std::memory_order_relaxed);
+
+                if (table->keys != nullptr) {
+                    table->keys[index] = fold_path(path);
+                }
+
+                // The slot is ours, the disk is probed without anyone waiting on it.
+                const auto exists = probe(path);
+                const auto final_word = key | (exists ? PRESENT : ABSENT);
+
+                slot.store(final_word, std::memory_order_release);
+                remember(final_word);
+
+                return {exists, true, false};
+            }
+
+            // Someone else claimed it first, word now holds their key.
+        }
+
+        if ((word & ~STATE_MASK) != key) {
+            continue;
+        }
+
+        // Another thread is probing this path right now, probing again is cheaper than waiting.
+        if ((word & STATE_MASK) == PENDING) {
+            return {probe(path), false, false};
+        }
+
+        if (table->keys != nullptr && !key_matches(table->keys[index], path)) {
+            m_collisions.fetch_add(1, std::memory_order_relaxed);
+            return {probe(path), false, false};
+        }
+
+        remember(word);
+        return {(word & STATE_MASK) == PRESENT, false, true};
+    }
+
+    // Full, or an unlucky probe sequence. Still correct, just not cached.
+    m_overflows.fetch_add(1, std::memory_order_relaxed);
+    return {probe(path), true, false};
+}
+
+void LooseFileExistenceCache::clear() {
+    auto table = std::make_unique<Table>(m_generation++, m_verify_keys);
+    const auto generation = table->generation;
+    auto new_table = table.get();
+
+    std::scoped_lock _{m_retired_mutex};
+
+    std::swap(m_owned_table, table);
+    m_table.store(new_table, std::memory_order_seq_cst);
+    m_current_generation.store(generation, std::memory_order_release);
+
+    // A hook may still be mid lookup in the old table.
+    m_retired.push_back(std::move(table));
+    try_reclaim_locked();
+}
+
+void LooseFileExistenceCache::collect_garbage() {
+    std::scoped_lock _{m_retired_mutex};
+    try_reclaim_locked();
+}
+
+size_t LooseFileExistenceCache::get_num_retired() {
+    std::scoped_lock _{m_retired_mutex};
+    return m_retired.size();
+}
+
+void LooseFileExistenceCache::try_reclaim_locked() {
+    // A lookup that could still see a retired table incremented m_active_readers before the table
+    // was replaced. Lookups that start after this check can only load the current one.
+    if (!m_retired.empty() && m_active_readers.load(std::memory_order_seq_cst) == 0) {
+        m_retired.clear();
+    }
+}
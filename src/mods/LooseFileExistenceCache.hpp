@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Component class owned by LooseFileLoader — not a standalone Mod.
+// Remembers whether a path exists on disk so each unique path only hits the filesystem once.
+// Lookups are a few atomic loads with no locks or allocations, and a miss is claimed with one CAS
+// so the disk probe never runs under a lock. Lookups that reach the shared table count themselves
+// as readers, so a cleared table is only freed once none can still be using it. Keys are a 64-bit hash of the case folded path,
+// the game's own path hash is only 32 bits and collides too often to key on.
+class LooseFileExistenceCache {
+public:
+    using ProbeFn = bool (*)(const wchar_t* path);
+
+    struct Result {
+        bool exists{false};
+        bool first_seen{false}; // This call was the first to see the path since the last clear
+        bool cached{false};
+    };
+
+    static constexpr size_t CAPACITY = 1 << 18; // 2MB of slots
+    static constexpr size_t MAX_ENTRIES = CAPACITY / 4 * 3;
+    static constexpr size_t MAX_PROBES = 128;
+    static constexpr size_t L1_SIZE = 1024; // Per thread, direct mapped
+
+    LooseFileExistenceCache();
+
+    LooseFileExistenceCache(const LooseFileExistenceCache&) = delete;
+    LooseFileExistenceCache& operator=(const LooseFileExistenceCache&) = delete;
+
+    static uint64_t hash_path(const wchar_t* path);
+
+    // Called from the hook.
+    Result check(const wchar_t* path, ProbeFn probe);
+
+    // Swaps in an empty table. The old one is freed by clear or collect_garbage once no lookup is active.
+    void clear();
+    void collect_garbage();
+
+    size_t get_num_retired();
+
+    // Takes effect on the next clear.
+    void set_verify_keys(bool verify) { m_verify_keys = verify; }
+    bool get_verify_keys() const { return m_verify_keys; }
+
+    void set_use_l1(bool use_l1) { m_use_l1.store(use_l1, std::memory_order_relaxed); }
+    bool get_use_l1() const { return m_use_l1.load(std::memory_order_relaxed); }
+
+    size_t get_size() const { return m_table.load(std::memory_order_acquire)->size.load(std::memory_order_relaxed); }
+    uint64_t get_collisions() const { return m_collisions.load(std::memory_order_relaxed); }
+    uint64_t get_overflows() const { return m_overflows.load(std::memory_order_relaxed); }
+
+private:
+    // A slot is one word, the key with its low two bits replaced by the state, 0 when empty.
+    // Readers only ever do a single load so a slot can't be seen half written.
+    enum State : uint64_t {
+        PENDING = 1, // Claimed, the disk probe hasn't finished yet
+        ABSENT = 2,
+        PRESENT = 3,
+    };
+
+    static constexpr uint64_t STATE_MASK = 3;
+
+    struct Table {
+        Table(uint32_t generation, bool verify_keys);
+
+        std::unique_ptr<std::atomic<uint64_t>[]> slots{};
+        std::unique_ptr<std::wstring[]> keys{}; // Case folded paths, only when verifying
+        std::atomic<size_t> size{0};
+        uint32_t generation{};
+    };
+
+    static uint64_t make_key(uint64_t hash) {
+        const auto key = hash & ~STATE_MASK;
+        return key != 0 ? key : (STATE_MASK + 1);
+    }
+
+    static bool key_matches(const std::wstring& folded, const wchar_t* path);
+    static std::wstring fold_path(const wchar_t* path);
+
+    void try_reclaim_locked();
+
+    std::atomic<Table*> m_table{nullptr};
+    std::unique_ptr<Table> m_owned_table{};
+    std::atomic<uint32_t> m_generation{0};
+    std::atomic<uint32_t> m_current_generation{0}; // Of m_table, lets L1 hits skip touching it
+    std::atomic<uint32_t> m_active_readers{0};
+
+    std::mutex m_retired_mutex{};
+    std::vector<std::unique_ptr<Table>> m_retired{};
+
+    bool m_verify_keys{false};
+    std::atomic<bool> m_use_l1{true};
+    std::atomic<uint64_t> m_collisions{0};
+    std::atomic<uint64_t> m_overflows{0};
+};
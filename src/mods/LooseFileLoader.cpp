@@ -26,6 +26,12 @@ LooseFileLoader::LooseFileLoader()
     m_loose_file_logger->flush_on(spdlog::level::info);
 
     m_loose_file_logger->info("LooseFileLoader constructed");
+
+    // Paths are written from the access log's own thread in batches, flushing once per batch.
+    m_logger->flush_on(spdlog::level::off);
+    m_loose_file_logger->flush_on(spdlog::level::off);
+
+    m_access_log = std::make_unique<LooseFileAccessLog>(m_logger, m_loose_file_logger);
 }
 
 std::shared_ptr<LooseFileLoader>& LooseFileLoader::get() {
@@ -41,6 +47,9 @@ void LooseFileLoader::on_frame() {
     if (!m_attempted_hook && m_enabled->value()) {
         hook();
     }
+
+    m_existence_cache.collect_garbage();
+    m_texture_loader.on_frame();
 }
 
 void LooseFileLoader::on_config_load(const utility::Config& cfg) {
@@ -74,9 +83,7 @@ void LooseFileLoader::on_draw_ui() {
     }
 
     auto clear_existence_cache = [&]() {
-        std::unique_lock _{m_files_on_disk_mutex};
-        m_files_on_disk.clear();
-        m_seen_files.clear();
+        m_existence_cache.clear();
         m_cache_hits = 0;
         m_uncached_hits = 0;
     };
@@ -94,17 +101,28 @@ void LooseFileLoader::on_draw_ui() {
             m_files_encountered = 0;
             m_loose_files_loaded = 0;
 
-            std::unique_lock _{m_mutex};
-            m_recent_accessed_files.clear();
-            m_recent_loose_files.clear();
-            m_all_accessed_files.clear();
-            m_all_loose_files.clear();
+            m_access_log->clear_stats();
         }
 
         if (ImGui::TreeNode("Debug")) {
             ImGui::Checkbox("Enable file cache", &m_enable_file_cache);
             ImGui::TextWrapped("Cache hits: %d", m_cache_hits);
             ImGui::TextWrapped("Uncached hits: %d", m_uncached_hits);
+            ImGui::TextWrapped("Cached paths: %d / %d", (int)m_existence_cache.get_size(), (int)LooseFileExistenceCache::MAX_ENTRIES);
+            ImGui::TextWrapped("Overflows: %llu", m_existence_cache.get_overflows());
+
+            if (auto use_l1 = m_existence_cache.get_use_l1(); ImGui::Checkbox("Thread local cache", &use_l1)) {
+                m_existence_cache.set_use_l1(use_l1);
+            }
+
+            if (auto verify = m_existence_cache.get_verify_keys(); ImGui::Checkbox("Verify full paths", &verify)) {
+                m_existence_cache.set_verify_keys(verify);
+                clear_existence_cache();
+            }
+
+            if (m_existence_cache.get_verify_keys()) {
+                ImGui::TextWrapped("Hash collisions: %llu", m_existence_cache.get_collisions());
+            }
 
             if (ImGui::Button("Clear existence cache")) {
                 clear_existence_cache();
@@ -130,23 +148,7 @@ void LooseFileLoader::on_draw_ui() {
         ImGui::Checkbox("Show recent files", &m_show_recent_files);
 
         if (m_show_recent_files) {
-            std::shared_lock _{m_mutex};
-
-            if (ImGui::TreeNode("Recent accessed files")) {
-                for (const auto& file : m_recent_accessed_files) {
-                    ImGui::TextWrapped("%s", utility::narrow(file).c_str());
-                }
-
-                ImGui::TreePop();
-            }
-
-            if (ImGui::TreeNode("Recent loose files")) {
-                for (const auto& file : m_recent_loose_files) {
-                    ImGui::TextWrapped("%s", utility::narrow(file).c_str());
-                }
-
-                ImGui::TreePop();
-            }
+            m_access_log->on_draw_ui();
         }
     }
 
@@ -353,78 +355,37 @@ bool LooseFileLoader::handle_path(const wchar_t* path, size_t hash) {
 
     ++m_files_encountered;
 
-    if (m_show_recent_files) {
-        std::unique_lock _{m_mutex};
-
-        m_all_accessed_files.insert(path);
-
-        m_recent_accessed_files.push_front(path);
-
-        if (m_recent_accessed_files.size() > 100) {
-            m_recent_accessed_files.pop_back();
-        }
-    }
-
     const auto enabled = m_enabled->value();
 
     //spdlog::info("[LooseFileLoader] path_to_hash_hook called with path: {}", utility::narrow(path));
 
-    if (enabled) {
-        bool exists_in_cache{false};
+    if (!enabled) {
+        record_access(path, hash, false, false);
+        return false;
+    }
+
+    {
         bool exists_on_disk{false};
+        bool first_seen{false};
 
         if (m_enable_file_cache) {
-            // Intended to get rid of mutex usage which can be a bottleneck
-            static thread_local std::unordered_set<size_t> files_on_disk_local{};
-            static thread_local std::unordered_set<size_t> seen_files_local{};
-
-            {
-                // No need to lock a mutex as these are thread_local
-                exists_on_disk = files_on_disk_local.contains(hash);
-                exists_in_cache = exists_on_disk || seen_files_local.contains(hash);
-            }
-
-            if (!exists_in_cache) {
-                // TODO: refine this with mixed shared and unique locks
-                // This shouldnt be a huge performance issue for now
-                std::unique_lock _{m_files_on_disk_mutex};
-
-                // Purpose of this is to only hit the disk once per unique file
-                if (m_files_on_disk.contains(hash) || safe_exists(path)) {
-                    m_files_on_disk.insert(hash); // Global
-                    files_on_disk_local.insert(hash); // Thread local
-                    exists_on_disk = true;
-                }
+            // Lock free, the disk is only probed by the first thread to see a path.
+            const auto result = m_existence_cache.check(path, &safe_exists);
 
-                if (m_log_accessed_files->value()) {
-                    m_logger->info("{}", utility::narrow(path));
-                }
-
-                if (exists_on_disk && m_log_loose_files->value()) {
-                    m_loose_file_logger->info("{}", utility::narrow(path));
-                }
+            exists_on_disk = result.exists;
+            first_seen = result.first_seen;
 
-                m_seen_files.insert(hash); // Global
-                seen_files_local.insert(hash); // Thread local
-                ++m_uncached_hits;
-            } else {
+            if (result.cached) {
                 ++m_cache_hits;
+            } else {
+                ++m_uncached_hits;
             }
         } else {
             exists_on_disk = safe_exists(path);
             ++m_uncached_hits;
         }
 
-        if (m_show_recent_files && exists_on_disk) {
-            std::unique_lock _{m_mutex};
-
-            m_all_loose_files.insert(path);
-            m_recent_loose_files.push_front(path);
-
-            if (m_recent_loose_files.size() > 100) {
-                m_recent_loose_files.pop_back();
-            }
-        }
+        record_access(path, hash, first_seen, exists_on_disk);
 
         if (exists_on_disk) {
             ++g_loose_file_loader->m_loose_files_loaded;
@@ -435,6 +396,29 @@ bool LooseFileLoader::handle_path(const wchar_t* path, size_t hash) {
     return false;
 }
 
+void LooseFileLoader::record_access(const wchar_t* path, size_t hash, bool first_seen, bool exists_on_disk) {
+    uint8_t flags = exists_on_disk ? LooseFileAccessLog::LOOSE : 0;
+
+    if (m_show_recent_files) {
+        flags |= LooseFileAccessLog::SHOW_RECENT;
+    }
+
+    // The logs only ever get a path once, so repeats only matter for the recent files view.
+    if (first_seen && m_log_accessed_files->value()) {
+        flags |= LooseFileAccessLog::LOG_ACCESSED;
+    }
+
+    if (first_seen && exists_on_disk && m_log_loose_files->value()) {
+        flags |= LooseFileAccessLog::LOG_LOOSE;
+    }
+
+    if ((flags & ~LooseFileAccessLog::LOOSE) == 0) {
+        return;
+    }
+
+    m_access_log->push(path, hash, flags);
+}
+
 uint64_t LooseFileLoader::path_to_hash_hook(const wchar_t* path) {
     const auto og = g_loose_file_loader->m_path_to_hash_hook->get_original<decltype(path_to_hash_hook)>();
     const auto result = og(path);
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <sdk/GameIdentity.hpp>
-#include <deque>
 #include <unordered_set>
 #include <spdlog/spdlog.h>
 
 #include <utility/FunctionHook.hpp>
 
 #include "../Mod.hpp"
+#include "LooseFileAccessLog.hpp"
+#include "LooseFileExistenceCache.hpp"
 #include "LooseTextureLoader.hpp"
 
 class LooseFileLoader : public Mod {
@@ -38,6 +39,7 @@ public:
 
 private:
     bool handle_path(const wchar_t* path, size_t hash);
+    void record_access(const wchar_t* path, size_t hash, bool first_seen, bool exists_on_disk);
 
 #ifdef REFRAMEWORK_UNIVERSAL
     static uint64_t path_to_hash_hook(const wchar_t* path);
@@ -57,16 +59,6 @@ private:
     uint32_t m_cache_hits{};
     uint32_t m_loose_files_loaded{};
 
-    std::shared_mutex m_mutex{};
-    std::deque<std::wstring> m_recent_accessed_files{}; // max 100
-    std::deque<std::wstring> m_recent_loose_files{}; // max 100
-    std::unordered_set<std::wstring> m_all_accessed_files{};
-    std::unordered_set<std::wstring> m_all_loose_files{};
-
-    std::unordered_set<size_t> m_files_on_disk{};
-    std::unordered_set<size_t> m_seen_files{};
-    std::shared_mutex m_files_on_disk_mutex{};
-
     std::unique_ptr<FunctionHook> m_path_to_hash_hook{nullptr};
 
     ModToggle::Ptr m_enabled{ ModToggle::create(generate_name("Enabled")) };
@@ -85,5 +77,7 @@ private:
     };
 
     // Components
+    std::unique_ptr<LooseFileAccessLog> m_access_log{};
+    LooseFileExistenceCache m_existence_cache{};
     LooseTextureLoader m_texture_loader{};
 };
\ No newline at end of file
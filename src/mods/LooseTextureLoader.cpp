@@ -7,6 +7,7 @@
 
 #include "sdk/ResourceManager.hpp"
 
+#include "utility/Fnv1a.hpp"
 #include "utility/Module.hpp"
 #include "utility/Scan.hpp"
 #include "utility/String.hpp"
@@ -35,6 +36,12 @@ void LooseTextureLoader::handle_resource_hash_path_wrapper(safetyhook::Context&
     get().handle_resource_hash_path(context);
 }
 
+// Never 0, 0 marks an empty counter slot.
+static uint64_t hash_resource_path(std::wstring_view path) {
+    const auto hash = utility::fnv1a::hash64(path);
+    return hash != 0 ? hash : 1;
+}
+
 // Single-ref variant: find the function that references `ptr` via displacement.
 // Returns the function start of the first external caller (not the function containing ptr itself).
 static std::optional<uintptr_t> find_reference_function(HMODULE module, uintptr_t ptr) {
@@ -91,9 +98,9 @@ void LooseTextureLoader::on_draw_ui() {
 
         // Show loaded resource counters
         {
-            std::lock_guard lock(m_resource_path_counters_mutex);
+            const auto num_unique = m_resource_path_counters.size();
 
-            ImGui::Text("Unique loose textures loaded: %zu", m_resource_path_counters.size());
+            ImGui::Text("Unique loose textures loaded: %zu", num_unique);
 
             if (ImGui::Button("Reset Counters")) {
                 m_resource_path_counters.clear();
@@ -101,14 +108,13 @@ void LooseTextureLoader::on_draw_ui() {
             }
 
             if (!m_recent_resources.empty() && ImGui::TreeNode("Loaded Loose Textures (recent)")) {
-                for (const auto& path : m_recent_resources) {
-                    auto it = m_resource_path_counters.find(path);
-                    uint64_t count = (it != m_resource_path_counters.end()) ? it->second : 0;
+                for (const auto& [hash, path] : m_recent_resources) {
+                    const auto count = m_resource_path_counters.get(hash).value_or(0);
                     ImGui::Text("[%llu] %s", count, utility::narrow(path).c_str());
                 }
 
-                if (m_resource_path_counters.size() > m_recent_resources.size()) {
-                    ImGui::TextDisabled("... and %zu more", m_resource_path_counters.size() - m_recent_resources.size());
+                if (num_unique > m_recent_resources.size()) {
+                    ImGui::TextDisabled("... and %zu more", num_unique - m_recent_resources.size());
                 }
 
                 ImGui::TreePop();
@@ -120,6 +126,18 @@ void LooseTextureLoader::on_draw_ui() {
 #endif
 }
 
+void LooseTextureLoader::on_frame() {
+    // Keep the ring empty even while the menu is closed, so it always holds the latest loads.
+    m_recent_resource_queue.drain([this](const RecentResource& recent) {
+        std::erase_if(m_recent_resources, [&](const auto& entry) { return entry.first == recent.hash; });
+        m_recent_resources.insert(m_recent_resources.begin(), {recent.hash, std::wstring{recent.path.data(), recent.length}});
+
+        if (m_recent_resources.size() > MAX_RECENT_DISPLAY) {
+            m_recent_resources.pop_back();
+        }
+    });
+}
+
 void LooseTextureLoader::early_initialize() {
 #if ENABLE_LOOSE_TEXTURE_LOADER
     // Only TDB>=81 games (MHWILDS+) have the DStorage-based loose texture path.
@@ -613,27 +631,23 @@ void LooseTextureLoader::handle_path_check_to_open_dstorage_file(safetyhook::Con
 }
 
 REPakEntryData* LooseTextureLoader::borrow_pak_entry_data(uintptr_t dstorage_file_ptr) {
-    std::lock_guard lock(m_file_info_pool_mutex);
-
-    // Try to reuse a free entry
-    for (auto& entry : m_pak_entry_data_pool) {
-        if (!entry->in_use) {
-            entry->in_use = true;
-            entry->file_info.dstorage_file_ptr = dstorage_file_ptr;
-            entry->handle_info.pak_data = &entry->file_info;
-            entry->handle_info.index_in_pak = FAKE_INVALID_INDEX_IN_PAK;
-            return &entry->handle_info;
-        }
+    auto entry = m_pak_entry_data_pool.acquire();
+
+    if (entry == nullptr) {
+        // Dropping the entry would silently lose the texture upload, a slower allocation is better.
+        static std::once_flag logged{};
+        std::call_once(logged, [this] {
+            spdlog::warn("[LooseTextureLoader]: Pak entry pool exhausted ({} entries), falling back to the heap", m_pak_entry_data_pool.capacity());
+        });
+
+        entry = new PakEntryDataPool{};
+        entry->heap_allocated = true;
     }
 
-    // No free entry, allocate a new one
-    auto& entry = m_pak_entry_data_pool.emplace_back(std::make_unique<PakEntryDataPool>());
-    entry->in_use = true;
     entry->file_info.dstorage_file_ptr = dstorage_file_ptr;
     entry->handle_info.pak_data = &entry->file_info;
     entry->handle_info.index_in_pak = FAKE_INVALID_INDEX_IN_PAK;
 
-    //spdlog::info("[LooseTextureLoader]: Pool grew to {} entries", m_pak_entry_data_pool.size());
     return &entry->handle_info;
 }
 
@@ -642,14 +656,14 @@ void LooseTextureLoader::release_pak_entry_data(REPakEntryData* handle_info) {
         return;
     }
 
-    std::lock_guard lock(m_file_info_pool_mutex);
+    auto entry = reinterpret_cast<PakEntryDataPool*>(handle_info);
 
-    for (auto& entry : m_pak_entry_data_pool) {
-        if (&entry->handle_info == handle_info) {
-            entry->in_use = false;
-            return;
-        }
+    if (entry->heap_allocated) {
+        delete entry;
+        return;
     }
+
+    m_pak_entry_data_pool.release(entry);
 }
 
 void LooseTextureLoader::handle_prepare_enqueue_texture_upload(safetyhook::Context& context) {
@@ -668,6 +682,11 @@ void LooseTextureLoader::handle_prepare_enqueue_texture_upload(safetyhook::Conte
     }
 
     pak_entry_data = borrow_pak_entry_data(stream->dstorage_file_ptr);
+
+    if (pak_entry_data == nullptr) {
+        return;
+    }
+
     stream->set_pak_entry_data(pak_entry_data);
     
     //spdlog::info("[LooseTextureLoader]: Filled REUnkFileInfoFromHandle for modded stream file at 0x{:X}", (uintptr_t)stream);
@@ -770,22 +789,15 @@ void LooseTextureLoader::handle_resource_hash_path(safetyhook::Context& context)
     }
 
     // Get or increment the counter for this path
-    uint64_t counter{};
-    {
-        std::lock_guard lock(m_resource_path_counters_mutex);
-        std::wstring key{path_view.data(), path_view.size()};
-        counter = m_resource_path_counters[key]++;
-
-        // Update recent list: remove old position if present, push to front
-        auto it = std::find(m_recent_resources.begin(), m_recent_resources.end(), key);
-        if (it != m_recent_resources.end()) {
-            m_recent_resources.erase(it);
-        }
-        m_recent_resources.insert(m_recent_resources.begin(), std::move(key));
-        if (m_recent_resources.size() > MAX_RECENT_DISPLAY) {
-            m_recent_resources.pop_back();
-        }
-    }
+    const auto path_hash = hash_resource_path(path_view);
+    const auto counter = m_resource_path_counters.increment(path_hash);
+
+    // Best effort, the UI only shows the most recent ones anyway.
+    m_recent_resource_queue.try_push([&](RecentResource& recent) {
+        recent.hash = path_hash;
+        recent.length = (uint16_t)std::min(path_view.size(), recent.path.size());
+        std::copy_n(path_view.data(), recent.length, recent.path.data());
+    });
 
     if (!m_disable_texture_cache->value()) {
         return; // Still count, but don't modify the hash path
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "Mod.hpp"
+#include "utility/LockFree.hpp"
 #include "sdk/ReClass_LooseTextureLoader_Internal.hpp"
 
 #include <safetyhook.hpp>
@@ -53,6 +55,7 @@ public:
     void on_config_load(const utility::Config& cfg);
     void on_config_save(utility::Config& cfg);
     void on_draw_ui();
+    void on_frame();
 
     bool is_enabled() const { return m_enabled->value(); }
 
@@ -67,6 +70,7 @@ private:
     static constexpr const wchar_t *TEX_FILE_EXTENSION = L".tex.";
 
     static constexpr size_t MAX_RECENT_DISPLAY = 50;
+    static constexpr size_t MAX_RECENT_PATH_LENGTH = 260;
 
 private:
     // Lazy-cached lookups
@@ -99,20 +103,29 @@ private:
     safetyhook::MidHook m_start_enqueue_texture_upload_hook{};
     safetyhook::MidHook m_resource_hash_path_hook{};
 
+    // handle_info must stay first, release_pak_entry_data converts it back to the pool entry.
     struct PakEntryDataPool {
         REPakEntryData handle_info{};
         REPakData file_info{};
-        bool in_use{false};
+        bool heap_allocated{false}; // Pool was exhausted, freed with delete instead of going back to the pool
     };
 
-    std::vector<std::unique_ptr<PakEntryDataPool>> m_pak_entry_data_pool{};
-    std::mutex m_file_info_pool_mutex{};
+    utility::SlabPool<PakEntryDataPool> m_pak_entry_data_pool{};
 
     GetNativeResourcePath m_get_native_path_to_resource_func{nullptr};
 
-    std::map<std::wstring, uint64_t> m_resource_path_counters{};
-    std::vector<std::wstring> m_recent_resources{};  // Most recent first, capped at MAX_RECENT_DISPLAY
-    std::mutex m_resource_path_counters_mutex{};
+    // Written from the streaming threads, keyed by path hash.
+    utility::ShardedCounters<> m_resource_path_counters{};
+
+    struct RecentResource {
+        uint64_t hash{};
+        uint16_t length{};
+        std::array<wchar_t, MAX_RECENT_PATH_LENGTH> path{};
+    };
+
+    // Streaming threads push, on_frame drains into m_recent_resources.
+    utility::MpscRing<RecentResource, 256> m_recent_resource_queue{};
+    std::vector<std::pair<uint64_t, std::wstring>> m_recent_resources{};  // UI thread only. Most recent first, capped at MAX_RECENT_DISPLAY
 
     // Config
     ModToggle::Ptr m_enabled{ ModToggle::create(generate_name("Enabled"), true) };
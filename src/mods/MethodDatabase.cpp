@@ -1,10 +1,16 @@
+#include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <thread>
+
 #include <spdlog/spdlog.h>
 
 #include <sdk/RETypeDB.hpp>
 
 #include "utility/Exceptions.hpp"
+#include "utility/Module.hpp"
 #include "utility/Scan.hpp"
+#include "utility/Fnv1a.hpp"
 
 #include "MethodDatabase.hpp"
 
@@ -13,95 +19,346 @@ std::shared_ptr<MethodDatabase>& MethodDatabase::get() {
     return instance;
 }
 
+MethodDatabase::~MethodDatabase() {
+    close_cache();
+}
+
 std::string MethodDatabase::resolve_address(uintptr_t addr) {
     return get()->find_method(addr);
 }
 
-std::optional<std::string> MethodDatabase::on_initialize() {
-    spdlog::info("[MethodDatabase] Building method address map...");
+std::filesystem::path MethodDatabase::get_cache_path() {
+    return REFramework::get_persistent_dir() / "reframework" / "cache" / "method_database.bin";
+}
 
-    const auto start = std::chrono::steady_clock::now();
+uint64_t MethodDatabase::compute_cache_key(HMODULE exe) {
+    // Hash the head of the executable on disk (PE headers, section table and the start of .text)
+    // along with its size. This changes with every game patch without reading hundreds of MB.
+    const auto exe_path = utility::get_module_pathw(exe);
+
+    if (!exe_path) {
+        return 0;
+    }
+
+    std::ifstream f{std::filesystem::path{*exe_path}, std::ios::binary};
+
+    if (!f) {
+        return 0;
+    }
+
+    std::vector<char> head(0x10000);
+    f.read(head.data(), head.size());
+
+    std::error_code ec{};
+    const uint64_t file_size = std::filesystem::file_size(*exe_path, ec);
+
+    auto key = utility::fnv1a::hash64(head.data(), (size_t)f.gcount());
+    key = utility::fnv1a::hash64(&file_size, sizeof(file_size), key);
+
+    const auto tdb = sdk::RETypeDB::get();
+    const auto num_methods = tdb != nullptr ? tdb->get_num_methods() : 0;
+    key = utility::fnv1a::hash64(&num_methods, sizeof(num_methods), key);
+
+    return key;
+}
 
+std::optional<std::string> MethodDatabase::on_initialize() {
     auto tdb = sdk::RETypeDB::get();
 
     if (tdb == nullptr) {
         return "MethodDatabase: RETypeDB not available";
     }
 
+    const auto exe = utility::get_executable();
+    m_image_base = (uintptr_t)exe;
+    m_image_size = utility::get_module_size(exe).value_or(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto cache_key = compute_cache_key(exe);
+
+    if (cache_key != 0 && load_cache(cache_key)) {
+        m_loaded_from_cache = true;
+    } else {
+        spdlog::info("[MethodDatabase] Building method address map...");
+        build(cache_key);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    m_build_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    const auto ram = m_entries.size_bytes() + m_arena.size_bytes();
+
+    spdlog::info("[MethodDatabase] {} map with {} methods in {}ms (~{:.1f} MB {})",
+        m_loaded_from_cache ? "Mapped" : "Built",
+        m_entries.size(),
+        m_build_time_ms,
+        ram / (1024.0 * 1024.0),
+        m_loaded_from_cache ? "shared" : "RAM");
+
+    utility::exceptions::set_address_name_resolver(&MethodDatabase::resolve_address);
+
+    return Mod::on_initialize();
+}
+
+void MethodDatabase::build(uint64_t cache_key) {
+    auto tdb = sdk::RETypeDB::get();
+
     const auto num_methods = tdb->get_num_methods();
-    size_t thunks = 0;
+    const auto num_types = tdb->get_num_types();
 
-    {
-        std::unique_lock lock{m_mutex};
+    struct PendingEntry {
+        uint32_t rva;
+        uint32_t method_index;
+        uint32_t type_index;
+    };
 
-        for (uint32_t i = 0; i < num_methods; ++i) {
-            auto method = tdb->get_method(i);
+    const auto num_workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 16);
+    const auto chunk_size = (num_methods + num_workers - 1) / num_workers;
 
-            if (method == nullptr) {
-                continue;
-            }
+    auto run_workers = [&](auto&& fn) {
+        std::vector<std::jthread> workers{};
 
-            auto func = method->get_function();
+        for (size_t w = 0; w < num_workers; ++w) {
+            const auto chunk_start = (uint32_t)std::min<size_t>(w * chunk_size, num_methods);
+            const auto chunk_end = (uint32_t)std::min<size_t>(chunk_start + chunk_size, num_methods);
 
-            if (func == nullptr) {
-                continue;
-            }
+            workers.emplace_back([&fn, w, chunk_start, chunk_end]() { fn(w, chunk_start, chunk_end); });
+        }
+    };
 
-            auto declaring_type = method->get_declaring_type();
+    auto to_rva = [this](uintptr_t addr) -> std::optional<uint32_t> {
+        if (addr < m_image_base || addr - m_image_base >= m_image_size) {
+            return std::nullopt;
+        }
 
-            if (declaring_type == nullptr) {
-                continue;
-            }
+        return (uint32_t)(addr - m_image_base);
+    };
+
+    // Pass 1 (parallel): gather every method address, including jmp thunk targets.
+    // This only reads the TDB, so it is safe to do off the calling thread.
+    std::vector<std::vector<PendingEntry>> pending(num_workers);
+    std::vector<size_t> thunks(num_workers);
 
+    run_workers([&](size_t w, uint32_t chunk_start, uint32_t chunk_end) {
+        auto& out = pending[w];
+
+        for (uint32_t i = chunk_start; i < chunk_end; ++i) {
             try {
-                auto full_name = declaring_type->get_full_name();
-                auto method_name = method->get_name();
+                auto method = tdb->get_method(i);
+
+                if (method == nullptr) {
+                    continue;
+                }
 
-                if (method_name == nullptr) {
+                const auto func = (uintptr_t)method->get_function();
+                const auto declaring_type = method->get_declaring_type();
+
+                if (func == 0 || declaring_type == nullptr || method->get_name() == nullptr) {
                     continue;
                 }
 
-                full_name += ".";
-                full_name += method_name;
+                const auto rva = to_rva(func);
+
+                if (!rva) {
+                    continue;
+                }
 
-                const auto func_addr = (uintptr_t)func;
-                m_method_map[func_addr] = full_name;
+                const auto type_index = declaring_type->get_index();
+                out.push_back({*rva, i, type_index});
 
                 // If the function starts with an E9 jmp, also map the jump target
                 if (*(uint8_t*)func == 0xE9) {
-                    const auto target = utility::calculate_absolute((uintptr_t)func + 1);
-                    m_method_map[target] = full_name;
-                    ++thunks;
+                    if (const auto target = to_rva(utility::calculate_absolute(func + 1))) {
+                        out.push_back({*target, i, type_index});
+                        ++thunks[w];
+                    }
                 }
             } catch (...) {
                 continue;
             }
         }
+    });
+
+    // Pass 2 (calling thread): resolve each distinct declaring type name once.
+    // get_full_name may call into the VM, so it stays on this thread.
+    std::vector<std::string> type_names(num_types);
+    std::vector<bool> type_resolved(num_types);
+
+    for (const auto& chunk : pending) {
+        for (const auto& p : chunk) {
+            if (p.type_index >= num_types || type_resolved[p.type_index]) {
+                continue;
+            }
+
+            type_resolved[p.type_index] = true;
+
+            try {
+                type_names[p.type_index] = tdb->get_type(p.type_index)->get_full_name();
+            } catch (...) {
+            }
+        }
+    }
+
+    // Pass 3 (parallel): format "Type.method" into per-worker arenas.
+    std::vector<std::vector<Entry>> entries(num_workers);
+    std::vector<std::vector<char>> arenas(num_workers);
+
+    run_workers([&](size_t w, uint32_t, uint32_t) {
+        auto& out = entries[w];
+        auto& arena = arenas[w];
+
+        out.reserve(pending[w].size());
+
+        for (const auto& p : pending[w]) {
+            if (p.type_index >= num_types) {
+                continue;
+            }
+
+            const auto& type_name = type_names[p.type_index];
+            const std::string_view method_name{tdb->get_method(p.method_index)->get_name()};
+
+            out.push_back({p.rva, (uint32_t)arena.size()});
+            arena.insert(arena.end(), type_name.begin(), type_name.end());
+            arena.push_back('.');
+            arena.insert(arena.end(), method_name.begin(), method_name.end());
+            arena.push_back('\0');
+        }
+    });
+
+    // Merge, rebasing the per-worker name offsets into the final arena.
+    std::vector<Entry> merged{};
+    std::vector<char> arena{};
+    MethodTable::merge(entries, arenas, merged, arena);
+
+    size_t total_thunks = 0;
+
+    for (const auto t : thunks) {
+        total_thunks += t;
     }
 
-    const auto end = std::chrono::steady_clock::now();
-    m_build_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    spdlog::info("[MethodDatabase] Thunks found: {}", total_thunks);
+
+    {
+        std::unique_lock lock{m_mutex};
+
+        m_entry_storage = std::move(merged);
+        m_arena_storage = std::move(arena);
+        m_entries = m_entry_storage;
+        m_arena = m_arena_storage;
+    }
 
-    // Estimate RAM: each std::map node has ~48 bytes overhead (red-black tree node with 3 pointers + color + key + std::string object)
-    // plus the actual string heap allocation for strings > SSO threshold
-    constexpr size_t map_node_overhead = sizeof(uintptr_t) + sizeof(std::string) + sizeof(void*) * 3 + sizeof(int);
-    m_estimated_ram = 0;
-    for (const auto& [addr, name] : m_method_map) {
-        m_estimated_ram += map_node_overhead + (name.size() > 22 ? name.size() + 1 : 0);
+    if (cache_key != 0) {
+        save_cache(cache_key);
     }
+}
 
-    spdlog::info("[MethodDatabase] Built map with {} methods in {}ms (~{:.1f} MB RAM)", m_method_map.size(), m_build_time_ms, m_estimated_ram / (1024.0 * 1024.0));
-    spdlog::info("[MethodDatabase] Thunks found: {}", thunks);
+bool MethodDatabase::load_cache(uint64_t cache_key) {
+    const auto path = get_cache_path();
 
-    utility::exceptions::set_address_name_resolver(&MethodDatabase::resolve_address);
+    m_cache_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
 
-    return Mod::on_initialize();
+    if (m_cache_file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size{};
+
+    if (!GetFileSizeEx(m_cache_file, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(MethodTable::CacheHeader)) {
+        close_cache();
+        return false;
+    }
+
+    m_cache_mapping = CreateFileMappingW(m_cache_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (m_cache_mapping == nullptr) {
+        close_cache();
+        return false;
+    }
+
+    m_cache_view = MapViewOfFile(m_cache_mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (m_cache_view == nullptr) {
+        close_cache();
+        return false;
+    }
+
+    const auto cache = MethodTable::parse_cache({(const char*)m_cache_view, (size_t)file_size.QuadPart}, cache_key);
+
+    if (cache.status == MethodTable::CacheStatus::STALE) {
+        spdlog::info("[MethodDatabase] Cache at {} is stale, rebuilding", path.string());
+        close_cache();
+        return false;
+    }
+
+    if (cache.status == MethodTable::CacheStatus::CORRUPT) {
+        spdlog::warn("[MethodDatabase] Cache at {} is corrupt, rebuilding", path.string());
+        close_cache();
+        return false;
+    }
+
+    std::unique_lock lock{m_mutex};
+    m_entries = cache.entries;
+    m_arena = cache.arena;
+
+    return true;
+}
+
+void MethodDatabase::save_cache(uint64_t cache_key) const try {
+    const auto path = get_cache_path();
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    std::filesystem::create_directories(path.parent_path());
+
+    {
+        std::ofstream f{tmp_path, std::ios::binary | std::ios::trunc};
+
+        if (!f) {
+            spdlog::error("[MethodDatabase] Failed to open {} for writing", tmp_path.string());
+            return;
+        }
+
+        if (!MethodTable::write_cache(f, cache_key, m_entries, m_arena)) {
+            spdlog::error("[MethodDatabase] Failed to write {}", tmp_path.string());
+            return;
+        }
+    }
+
+    std::filesystem::rename(tmp_path, path);
+    spdlog::info("[MethodDatabase] Saved cache to {}", path.string());
+} catch (const std::exception& e) {
+    spdlog::error("[MethodDatabase] Failed to save cache: {}", e.what());
+}
+
+void MethodDatabase::close_cache() {
+    if (m_cache_view != nullptr) {
+        UnmapViewOfFile(m_cache_view);
+        m_cache_view = nullptr;
+    }
+
+    if (m_cache_mapping != nullptr) {
+        CloseHandle(m_cache_mapping);
+        m_cache_mapping = nullptr;
+    }
+
+    if (m_cache_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_cache_file);
+        m_cache_file = INVALID_HANDLE_VALUE;
+    }
+}
+
+const MethodDatabase::Entry* MethodDatabase::find_entry(uintptr_t addr) const {
+    if (m_entries.empty() || addr < m_image_base || addr - m_image_base >= m_image_size) {
+        return nullptr;
+    }
+
+    return MethodTable::find(m_entries, (uint32_t)(addr - m_image_base));
 }
 
 std::string MethodDatabase::find_method(uintptr_t addr) const {
     std::shared_lock lock{m_mutex};
 
-    if (m_method_map.empty()) {
+    if (m_entries.empty()) {
         return {};
     }
 
@@ -109,27 +366,23 @@ std::string MethodDatabase::find_method(uintptr_t addr) const {
     const auto func_start = utility::find_function_start_unwind(addr);
 
     if (func_start) {
-        auto it = m_method_map.find(*func_start);
-
-        if (it != m_method_map.end()) {
-            return it->second;
+        if (auto entry = find_entry(*func_start); entry != nullptr && m_image_base + entry->rva == *func_start) {
+            return std::string{get_entry_name(*entry)};
         }
     }
 
-    // Fall back to upper_bound lookup
-    auto it = m_method_map.upper_bound(addr);
+    // Fall back to the nearest preceding method
+    const auto entry = find_entry(addr);
 
-    if (it == m_method_map.begin()) {
+    if (entry == nullptr) {
         return {};
     }
 
-    --it;
-
     constexpr uintptr_t max_method_size = 0x10000;
 
-    if (addr - it->first > max_method_size) {
+    if (addr - (m_image_base + entry->rva) > max_method_size) {
         return {};
     }
 
-    return it->second;
+    return std::string{get_entry_name(*entry)};
 }
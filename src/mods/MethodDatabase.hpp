@@ -1,25 +1,72 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
+#include <filesystem>
 #include <shared_mutex>
+#include <span>
 #include <string>
+#include <vector>
+
+#include <Windows.h>
 
 #include "Mod.hpp"
+#include "MethodTable.hpp"
 
+// Flat, sorted address -> method name table.
+// Names live in a single null-terminated string arena, entries are {rva, name_offset} pairs
+// sorted by rva. The table can be persisted to a cache file keyed by the executable
+// and memory mapped on later launches instead of being rebuilt (format in MethodTable.hpp).
 class MethodDatabase : public Mod {
 public:
+    using Entry = MethodTable::Entry;
+
     static std::shared_ptr<MethodDatabase>& get();
 
+    ~MethodDatabase() override;
+
     std::string_view get_name() const override { return "MethodDatabase"; }
     std::optional<std::string> on_initialize() override;
 
     std::string find_method(uintptr_t addr) const;
 
+    // Returns the greatest entry with entry.rva <= addr - image base, or nullptr.
+    const Entry* find_entry(uintptr_t addr) const;
+
+    std::string_view get_entry_name(const Entry& entry) const {
+        return MethodTable::name(m_arena, entry);
+    }
+
+    std::span<const Entry> get_entries() const {
+        return m_entries;
+    }
+
 private:
     static std::string resolve_address(uintptr_t addr);
 
+    static std::filesystem::path get_cache_path();
+    static uint64_t compute_cache_key(HMODULE exe);
+
+    void build(uint64_t cache_key);
+    bool load_cache(uint64_t cache_key);
+    void save_cache(uint64_t cache_key) const;
+    void close_cache();
+
     mutable std::shared_mutex m_mutex{};
-    std::map<uintptr_t, std::string> m_method_map{};
+
+    // Either point into the owned storage below or into the mapped cache file.
+    std::span<const Entry> m_entries{};
+    std::span<const char> m_arena{};
+
+    std::vector<Entry> m_entry_storage{};
+    std::vector<char> m_arena_storage{};
+
+    uintptr_t m_image_base{0};
+    size_t m_image_size{0};
+
+    HANDLE m_cache_file{INVALID_HANDLE_VALUE};
+    HANDLE m_cache_mapping{nullptr};
+    const void* m_cache_view{nullptr};
+
     size_t m_build_time_ms{0};
-    size_t m_estimated_ram{0};
+    bool m_loaded_from_cache{false};
 };
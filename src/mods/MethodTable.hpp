@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "utility/AddressIndex.hpp"
+
+// Component of MethodDatabase, kept free of the TDB and Win32 so it can be tested on its own.
+// Entries are {rva, name_offset} pairs sorted by rva, names are C strings in one arena.
+// The cache file is a CacheHeader, then the entries, then the arena.
+class MethodTable {
+public:
+    struct Entry {
+        uint32_t rva;
+        uint32_t name_offset;
+    };
+
+    static_assert(sizeof(Entry) == 8);
+
+    static constexpr uint32_t CACHE_MAGIC = 0x42444D52; // "RMDB"
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    struct CacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t num_entries;
+        uint32_t arena_size;
+    };
+
+    static_assert(sizeof(CacheHeader) % alignof(Entry) == 0);
+
+    enum class CacheStatus {
+        OK,
+        STALE,   // Another game version or cache format, expected after a patch
+        CORRUPT, // Matches, but can't be read safely
+    };
+
+    struct CacheView {
+        CacheStatus status{CacheStatus::STALE};
+        std::span<const Entry> entries{};
+        std::span<const char> arena{};
+    };
+
+    // data is the whole cache file. On OK the spans point into it.
+    static CacheView parse_cache(std::span<const char> data, uint64_t key) {
+        if (data.size() < sizeof(CacheHeader) || (uintptr_t)data.data() % alignof(CacheHeader) != 0) {
+            return {CacheStatus::STALE};
+        }
+
+        const auto header = (const CacheHeader*)data.data();
+        const auto expected_size = sizeof(CacheHeader) + (uint64_t)header->num_entries * sizeof(Entry) + header->arena_size;
+
+        if (header->magic != CACHE_MAGIC || header->version != CACHE_VERSION || header->key != key || data.size() != expected_size) {
+            return {CacheStatus::STALE};
+        }
+
+        const auto entries = std::span<const Entry>{(const Entry*)(header + 1), header->num_entries};
+        const auto arena = std::span<const char>{(const char*)(entries.data() + entries.size()), header->arena_size};
+
+        // Names are read as C strings starting at name_offset, so every offset has to land inside the arena
+        // and the arena has to end in a terminator. Otherwise a damaged file would have us read past the mapping.
+        if (!entries.empty()) {
+            const auto arena_terminated = !arena.empty() && arena.back() == '\0';
+            const auto offsets_in_range = std::all_of(entries.begin(), entries.end(), [&](const Entry& e) {
+                return e.name_offset < arena.size();
+            });
+
+            if (!arena_terminated || !offsets_in_range) {
+                return {CacheStatus::CORRUPT};
+            }
+        }
+
+        return {CacheStatus::OK, entries, arena};
+    }
+
+    static bool write_cache(std::ostream& out, uint64_t key, std::span<const Entry> entries, std::span<const char> arena) {
+        const CacheHeader header{CACHE_MAGIC, CACHE_VERSION, key, (uint32_t)entries.size(), (uint32_t)arena.size()};
+
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)entries.data(), entries.size_bytes());
+        out.write(arena.data(), arena.size_bytes());
+
+        return (bool)out;
+    }
+
+    // Joins per-worker tables into one, rebasing the name offsets into the joined arena.
+    // The result is sorted by rva, the first entry wins where several share one.
+    static void merge(std::span<const std::vector<Entry>> entries, std::span<const std::vector<char>> arenas,
+                      std::vector<Entry>& out_entries, std::vector<char>& out_arena)
+    {
+        size_t total_entries = 0;
+        size_t total_arena = 0;
+
+        for (size_t w = 0; w < entries.size(); ++w) {
+            total_entries += entries[w].size();
+            total_arena += arenas[w].size();
+        }
+
+        out_entries.clear();
+        out_arena.clear();
+        out_entries.reserve(total_entries);
+        out_arena.reserve(total_arena);
+
+        for (size_t w = 0; w < entries.size(); ++w) {
+            const auto base = (uint32_t)out_arena.size();
+
+            for (const auto& e : entries[w]) {
+                out_entries.push_back({e.rva, base + e.name_offset});
+            }
+
+            out_arena.insert(out_arena.end(), arenas[w].begin(), arenas[w].end());
+        }
+
+        std::stable_sort(out_entries.begin(), out_entries.end(), [](const Entry& a, const Entry& b) { return a.rva < b.rva; });
+        out_entries.erase(std::unique(out_entries.begin(), out_entries.end(), [](const Entry& a, const Entry& b) { return a.rva == b.rva; }), out_entries.end());
+        out_entries.shrink_to_fit();
+    }
+
+    // The greatest entry with entry.rva <= rva, or nullptr.
+    static const Entry* find(std::span<const Entry> entries, uint32_t rva) {
+        return utility::find_last_le(entries.data(), entries.size(), rva, [](const Entry& e) { return e.rva; });
+    }
+
+    static std::string_view name(std::span<const char> arena, const Entry& entry) {
+        return std::string_view{arena.data() + entry.name_offset};
+    }
+};
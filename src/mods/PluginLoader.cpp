@@ -135,7 +135,7 @@ REFrameworkSDKFunctions g_sdk_functions {
     },
     // get_native_singletons
     [](REFrameworkNativeSingleton* out, unsigned int out_size, unsigned int* out_count) -> REFrameworkResult {
-        auto& native_singletons = reframework::get_globals()->get_native_singleton_types();
+        const auto native_singletons = reframework::get_globals()->get_native_singleton_types();
 
         if (out_size < native_singletons.size() * sizeof(REFrameworkNativeSingleton)) {
             return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
@@ -304,7 +304,14 @@ REFrameworkTDBTypeDefinition g_type_definition_data {
     [](REFrameworkTypeDefinitionHandle tdef) { return (REFrameworkTypeDefinitionHandle)RETYPEDEF(tdef)->get_declaring_type(); },
     [](REFrameworkTypeDefinitionHandle tdef) { return (REFrameworkTypeDefinitionHandle)RETYPEDEF(tdef)->get_underlying_type(); },
     [](REFrameworkTypeDefinitionHandle tdef) { return (REFrameworkTypeInfoHandle)RETYPEDEF(tdef)->get_type(); },
-    [](REFrameworkTypeDefinitionHandle tdef) { return (REFrameworkManagedObjectHandle)RETYPEDEF(tdef)->get_runtime_type(); }
+    [](REFrameworkTypeDefinitionHandle tdef) { return (REFrameworkManagedObjectHandle)RETYPEDEF(tdef)->get_runtime_type(); },
+    [](REFrameworkTypeDefinitionHandle tdef, const REFrameworkTypeDefinitionHandle* args, unsigned int num_args) {
+        if (args == nullptr && num_args > 0) {
+            return (REFrameworkTypeDefinitionHandle)nullptr;
+        }
+
+        return (REFrameworkTypeDefinitionHandle)RETYPEDEF(tdef)->instantiate(std::span{(sdk::RETypeDefinition* const*)args, num_args});
+    }
 };
 
 #define REMETHOD(var) ((sdk::REMethodDefinition*)var)
@@ -407,8 +407,9 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data,bool
 
 ScriptState::~ScriptState() {
     {
+        // Drops this state's delegate callbacks while m_lua is still open.
         std::scoped_lock _{s_delegates_mutex};
-        std::erase_if(s_delegates, [](auto& pair) { return pair.second->owner.expired(); });
+        unbind_delegates_locked(this);
     }
 
     std::scoped_lock _{m_execution_mutex};
@@ -417,6 +418,25 @@ ScriptState::~ScriptState() {
             g_hookman.remove(fn, id);
         }
     }
+
+    // Free the callbacks and every retired snapshot now, with the state locked, instead of leaving it to member destruction.
+    for_each_callback_vector([](auto& callbacks) {
+        callbacks.clear();
+        callbacks.collect();
+    });
+}
+
+void ScriptState::collect_callbacks() {
+    bool has_retired = false;
+
+    for_each_callback_vector([&](auto& callbacks) { has_retired |= callbacks.has_retired(); });
+
+    if (!has_retired) {
+        return;
+    }
+
+    std::scoped_lock _{m_execution_mutex};
+    for_each_callback_vector([](auto& callbacks) { callbacks.collect(); });
 }
 
 void ScriptState::run_script(const std::string& p) {
@@ -490,16 +510,21 @@ bool ScriptState::should_remove_hook(const sol::protected_function_result &resul
 
 void ScriptState::on_frame() {
     try {
-        std::scoped_lock _{ m_execution_mutex };
+        // Nothing to run, don't contend for the state with other threads.
+        if (!m_on_frame_fns.empty()) {
+            std::scoped_lock _{ m_execution_mutex };
 
-        auto guard = m_on_frame_fns.acquire_iteration();
-        for (auto& fn : m_on_frame_fns.get()) {
-            auto result = handle_protected_result(fn());
+            for (auto [handle, fn] : m_on_frame_fns.acquire_iteration()) {
+                auto result = handle_protected_result(fn());
 
-            if (should_remove_hook(result)) {
-                m_on_frame_fns.remove(fn);
+                if (should_remove_hook(result)) {
+                    m_on_frame_fns.remove(handle);
+                }
             }
         }
+
+        // Removals from any callback list (or re.on_* calls from hooks) only retire snapshots, free them once a frame.
+        collect_callbacks();
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
     } catch (...) {
@@ -512,14 +537,15 @@ void ScriptState::on_frame() {
 
 void ScriptState::on_draw_ui() {
     try {
-        std::scoped_lock _{ m_execution_mutex };
+        if (!m_on_draw_ui_fns.empty()) {
+            std::scoped_lock _{ m_execution_mutex };
 
-        auto guard = m_on_draw_ui_fns.acquire_iteration();
-        for (auto& fn : m_on_draw_ui_fns.get()) {
-            auto result = handle_protected_result(fn());
+            for (auto [handle, fn] : m_on_draw_ui_fns.acquire_iteration()) {
+                auto result = handle_protected_result(fn());
 
-            if (should_remove_hook(result)) {
-                m_on_draw_ui_fns.remove(fn);
+                if (should_remove_hook(result)) {
+                    m_on_draw_ui_fns.remove(handle);
+                }
             }
         }
     } catch (const std::exception& e) {
@@ -658,11 +684,15 @@ void ScriptState::on_application_entry(size_t hash) {
 bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* context) {
     bool any_false = false;
 
+    // Called for every GUI element every frame, skip the lock entirely when no script cares.
+    if (m_pre_gui_draw_element_fns.empty()) {
+        return true;
+    }
+
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        auto guard = m_pre_gui_draw_element_fns.acquire_iteration();
-        for (auto& fn : m_pre_gui_draw_element_fns.get()) {
+        for (auto [handle, fn] : m_pre_gui_draw_element_fns.acquire_iteration()) {
             if (auto result = handle_protected_result(fn(gui_element, context))) {
                 auto result_obj = result.get<sol::object>();
 
@@ -670,7 +700,7 @@ bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* contex
                     any_false = true;
                 } else {
                     if (should_remove_hook(result)) {
-                        m_pre_gui_draw_element_fns.remove(fn);
+                        m_pre_gui_draw_element_fns.remove(handle);
                     }
                 }
             }
@@ -685,15 +715,18 @@ bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* contex
 }
 
 void ScriptState::on_gui_draw_element(REComponent* gui_element, void* context) {
+    if (m_gui_draw_element_fns.empty()) {
+        return;
+    }
+
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        auto guard = m_gui_draw_element_fns.acquire_iteration();
-        for (auto& fn : m_gui_draw_element_fns.get()) {
+        for (auto [handle, fn] : m_gui_draw_element_fns.acquire_iteration()) {
             auto result = handle_protected_result(fn(gui_element, context));
 
             if (should_remove_hook(result)) {
-                m_gui_draw_element_fns.remove(fn);
+                m_gui_draw_element_fns.remove(handle);
             }
         }
     } catch (const std::exception& e) {
@@ -707,19 +740,17 @@ void ScriptState::on_script_reset() try {
     std::scoped_lock _{ m_execution_mutex };
 
     // We first call on_config_save functions so scripts can save prior to reset.
-    auto guard_save = m_on_config_save_fns.acquire_iteration();
-    for (auto& fn : m_on_config_save_fns.get()) {
+    for (auto [handle, fn] : m_on_config_save_fns.acquire_iteration()) {
         auto result = handle_protected_result(fn());
         if (should_remove_hook(result)) {
-            m_on_config_save_fns.remove(fn);
+            m_on_config_save_fns.remove(handle);
         }
     }
 
-    auto guard_reset = m_on_script_reset_fns.acquire_iteration();
-    for (auto& fn : m_on_script_reset_fns.get()) {
+    for (auto [handle, fn] : m_on_script_reset_fns.acquire_iteration()) {
         auto result = handle_protected_result(fn());
         if (should_remove_hook(result)) {
-            m_on_script_reset_fns.remove(fn);
+            m_on_script_reset_fns.remove(handle);
         }
     }
 } catch (const std::exception& e) {
@@ -731,12 +762,11 @@ void ScriptState::on_script_reset() try {
 void ScriptState::on_config_save() try {
     std::scoped_lock _{ m_execution_mutex };
 
-    auto guard = m_on_config_save_fns.acquire_iteration();
-    for (auto& fn : m_on_config_save_fns.get()) {
+    for (auto [handle, fn] : m_on_config_save_fns.acquire_iteration()) {
         auto result = handle_protected_result(fn());
 
         if (should_remove_hook(result)) {
-            m_on_config_save_fns.remove(fn);
+            m_on_config_save_fns.remove(handle);
         }
     }
 }
@@ -856,51 +886,151 @@ void ScriptState::install_hooks() {
     }
 }
 
-void ScriptState::add_delegate_callback(sdk::DelegateInvocation& invo, sol::protected_function callback) {
-    std::unique_lock _{s_delegates_mutex};
-    auto it = s_delegates.find(invo.object);
+uintptr_t ScriptState::create_delegate_thunk(DelegateStorage* storage) {
+    using namespace asmjit;
+    using namespace asmjit::x86;
 
-    if (it != s_delegates.end()) {
-        it->second->callbacks.add(callback);
-    } else {
-        auto storage = std::make_unique<DelegateStorage>();
-        storage->owner = shared_from_this();
-        storage->callbacks.add(callback);
-        
-        static auto system_object_t = sdk::find_type_definition("System.Object");
+    CodeHolder code{};
+    code.init(s_delegate_jit.environment());
+
+    Assembler a{&code};
+
+    auto calls_label = a.newLabel();
+    auto storage_label = a.newLabel();
+    auto target_label = a.newLabel();
 
-        invo.object = (::REManagedObject*)system_object_t->create_instance_full();
-        invo.object->add_ref();
+    // Count the call before the storage is touched, a retired storage isn't freed while its count is nonzero.
+    a.mov(rax, ptr(calls_label));
+    a.lock().add(qword_ptr(rax), 1);
 
-        invo.func = &ScriptState::delegate_callback;
-        s_delegates[invo.object] = std::move(storage);
+    // delegate_callback(ctx, obj, storage). Tail call, so the stack is left as the engine set it up.
+    a.mov(r8, ptr(storage_label));
+    a.jmp(ptr(target_label));
+
+    a.bind(calls_label);
+    a.dq((uint64_t)&storage->calls.count);
+    a.bind(storage_label);
+    a.dq((uint64_t)storage);
+    a.bind(target_label);
+    a.dq((uint64_t)&ScriptState::delegate_callback);
+
+    uintptr_t thunk{};
+
+    if (s_delegate_jit.add(&thunk, &code) != kErrorOk) {
+        return 0;
     }
+
+    return thunk;
 }
 
-void ScriptState::delegate_callback(sdk::VMContext* ctx, REManagedObject* obj) {
-    std::scoped_lock _{ s_delegates_mutex };
+void ScriptState::unbind_delegates_locked(const ScriptState* state) {
+    for (auto it = s_delegates.begin(); it != s_delegates.end();) {
+        auto& storage = it->second;
 
-    if (ctx == nullptr) {
+        if (storage->state != state) {
+            ++it;
+            continue;
+        }
+
+        // New calls go nowhere, the placeholder object stays so the delegate can be bound again.
+        std::atomic_ref{storage->invocation->func}.store(&ScriptState::orphaned_delegate_callback, std::memory_order_seq_cst);
+        storage->delegate->release();
+        storage->delegate = nullptr;
+        storage->invocation = nullptr;
+
+        // Calls still running hold the owner alive, so nothing can be iterating these once it's being destroyed.
+        storage->callbacks.clear();
+        storage->callbacks.collect();
+
+        s_retired_delegates.retire(std::move(storage));
+        it = s_delegates.erase(it);
+    }
+
+    try_release_retired_delegates_locked();
+}
+
+void ScriptState::try_release_retired_delegates_locked() {
+    // The engine can have loaded an old thunk's address right before its invocation was unbound and not have
+    // reached the thunk's count yet, so a storage is only freed after its grace period and with nothing in flight.
+    // The rest wait for a later frame.
+    s_retired_delegates.collect(
+        [](const std::unique_ptr<DelegateStorage>& storage) { return storage->calls.idle(); },
+        [](std::unique_ptr<DelegateStorage>& storage) { s_delegate_jit.release(storage->thunk); }
+    );
+}
+
+void ScriptState::collect_retired_delegates() {
+    // Never stall the frame on a script binding or tearing down, the epoch just advances a frame later.
+    std::unique_lock lock{s_delegates_mutex, std::try_to_lock};
+
+    if (!lock.owns_lock() || s_retired_delegates.empty()) {
         return;
     }
 
-    auto it = s_delegates.find(obj);
+    s_retired_delegates.advance();
+    try_release_retired_delegates_locked();
+}
 
-    if (it == s_delegates.end()) {
+void ScriptState::add_delegate_callback(sdk::Delegate* delegate, uint32_t index, sol::protected_function callback) {
+    std::unique_lock _{s_delegates_mutex};
+    try_release_retired_delegates_locked();
+
+    auto& invo = delegate->methods[index];
+
+    if (auto it = s_delegates.find(invo.object); it != s_delegates.end() && it->second->invocation == &invo) {
+        it->second->callbacks.add(callback);
         return;
     }
 
-    auto& delegate = it->second;
-    auto owner_state = delegate->owner.lock();
+    // The placeholder of an invocation whose state was destroyed is reused.
+    ::REManagedObject* placeholder = invo.func == &ScriptState::orphaned_delegate_callback ? invo.object : nullptr;
+
+    auto storage = std::make_unique<DelegateStorage>();
+    storage->owner = shared_from_this();
+    storage->state = this;
+    storage->callbacks.add(callback);
+    storage->thunk = create_delegate_thunk(storage.get());
+
+    if (storage->thunk == 0) {
+        throw sol::error("Failed to create delegate thunk");
+    }
+
+    if (placeholder == nullptr) {
+        static auto system_object_t = sdk::find_type_definition("System.Object");
+
+        placeholder = (::REManagedObject*)system_object_t->create_instance_full();
+        placeholder->add_ref();
+    }
+
+    // Keeps the invocation's memory alive so teardown can unbind it.
+    delegate->add_ref();
+    storage->delegate = delegate;
+    storage->invocation = &invo;
+
+    invo.object = placeholder;
+    invo.func = (sdk::DelegateInvocation::InvocationFn)storage->thunk;
+    s_delegates[placeholder] = std::move(storage);
+}
+
+void ScriptState::delegate_callback(sdk::VMContext* ctx, REManagedObject* obj, DelegateStorage* storage) {
+    // Only ever called from the storage's own thunk, which counted this call.
+    utility::ScopeGuard in_flight{[storage]() {
+        storage->calls.leave();
+    }};
+
+    if (ctx == nullptr || storage->callbacks.empty()) {
+        return;
+    }
+
+    // Keeps the state alive for the duration of the call.
+    auto owner_state = storage->owner.lock();
     if (owner_state == nullptr) {
-        s_delegates.erase(it);
         return;
     }
 
     auto __ = owner_state->scoped_lock();
 
-    auto guard = delegate->callbacks.acquire_iteration();
-    for (auto& fn : delegate->callbacks.get()) {
+    for (auto [handle, fn] : storage->callbacks.acquire_iteration()) {
         try {
             auto script_result = fn(obj);
 
@@ -915,6 +1045,10 @@ void ScriptState::delegate_callback(sdk::VMContext* ctx, REManagedObject* obj) {
     }
 }
 
+void ScriptState::orphaned_delegate_callback(sdk::VMContext*, REManagedObject*) {
+    // The script that bound this delegate was unloaded.
+}
+
 void ScriptState::gc_data_changed(GarbageCollectionData data) {
     // Handler
     switch (data.gc_handler) {
@@ -1061,6 +1195,8 @@ void ScriptRunner::hook_battle_rule() {
 }
 
 void ScriptRunner::on_frame() {
+    ScriptState::collect_retired_delegates();
+
     if (!m_console_startup_checked) {
         // Delay because C# API hides it
         if (m_console_startup_delay_frames > 0) {
@@ -17,6 +17,7 @@
 #include "utility/FunctionHook.hpp"
 #include <utility/ScopeGuard.hpp>
 #include <utility/SafeCallbackVector.hpp>
+#include <utility/GraceRetireList.hpp>
 
 #include "Mod.hpp"
 
@@ -262,7 +263,10 @@ public:
         return m_table_pool;
     }
 
-    void add_delegate_callback(sdk::DelegateInvocation& invo, sol::protected_function callback);
+    void add_delegate_callback(sdk::Delegate* delegate, uint32_t index, sol::protected_function callback);
+
+    // Once per frame, ends a grace period for the delegates retired before it.
+    static void collect_retired_delegates();
 
 private:
     sol::reference get_hook_storage_internal(size_t thread_hash) {
@@ -278,6 +282,20 @@ private:
         return sol::nil;
     }
 
+    template <typename F>
+    void for_each_callback_vector(F&& fn) {
+        fn(m_pre_gui_draw_element_fns);
+        fn(m_gui_draw_element_fns);
+        fn(m_on_draw_ui_fns);
+        fn(m_on_frame_fns);
+        fn(m_on_script_reset_fns);
+        fn(m_on_config_save_fns);
+    }
+
+    // Frees the snapshots the callback vectors retired since the last call. They hold Lua references,
+    // so this locks the state, but only when there's something to free.
+    void collect_callbacks();
+
     sol::state m_lua{};
     TablePool m_table_pool{};
 
@@ -314,16 +332,38 @@ private:
     std::unordered_map<size_t, std::list<TablePool::TableGuard>> m_hook_storage{};
     sol::reference m_current_hook_storage{};
 
+    // Bound to its delegate through a jitted thunk that passes the storage pointer straight to delegate_callback,
+    // so invocations never look anything up or take s_delegates_mutex.
+    // When the owning state is destroyed the invocation is pointed at orphaned_delegate_callback, and the storage
+    // and thunk are retired: freed a few frames later, once none of its own calls are in flight (see ~ScriptState).
     struct DelegateStorage {
         std::weak_ptr<ScriptState> owner{}; // Weak pointer to the ScriptState that owns this delegate storage because the ScriptState may be deleted. 
+        const ScriptState* state{}; // Same state, only compared against, so teardown can find its storages
         SafeCallbackVector<sol::protected_function> callbacks{};
+        uintptr_t thunk{};
+        sdk::Delegate* delegate{}; // add_ref'd until the invocation is unbound
+        sdk::DelegateInvocation* invocation{};
 
+        // Incremented by the thunk before anything else, decremented when delegate_callback returns.
+        utility::InFlightCounter calls{};
     };
 
+    // A call can have loaded an unbound thunk's address without having counted itself yet,
+    // retired thunks wait this many frames before their count is trusted.
+    static constexpr uint64_t DELEGATE_GRACE_FRAMES = 2;
+
+    static uintptr_t create_delegate_thunk(DelegateStorage* storage);
+    static void unbind_delegates_locked(const ScriptState* state);
+    static void try_release_retired_delegates_locked();
+
+    // Only used when adding callbacks and tearing states down, never on invocation.
     static inline std::unordered_map<REManagedObject*, std::unique_ptr<DelegateStorage>> s_delegates{};
+    static inline utility::GraceRetireList<std::unique_ptr<DelegateStorage>> s_retired_delegates{DELEGATE_GRACE_FRAMES};
     static inline std::recursive_mutex s_delegates_mutex{};
+    static inline asmjit::JitRuntime s_delegate_jit{};
 
-    static void delegate_callback(sdk::VMContext* ctx, REManagedObject* obj);
+    static void orphaned_delegate_callback(sdk::VMContext* ctx, REManagedObject* obj);
+    static void delegate_callback(sdk::VMContext* ctx, REManagedObject* obj, DelegateStorage* storage);
 };
 
 class ScriptRunner : public Mod {
@@ -1447,7 +1447,33 @@ void set_scroll_from_pos_y(float local_y, float center_y_ratio = 0.5f) {
 } // namespace api::imgui
 
 namespace api::draw {
-std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
+// Camera state needed to project world positions. Command lists fetch it once per draw instead of once per primitive.
+struct ScreenProjection {
+    Matrix4x4f proj{};
+    Matrix4x4f view{};
+    float screen_size[2]{};
+    Vector4f camera_origin{};
+    Vector4f camera_forward{};
+
+    std::optional<Vector2f> project(Vector4f world_pos) {
+        const auto delta = world_pos - camera_origin;
+
+        // behind camera
+        if (glm::dot(Vector3f{delta}, Vector3f{-camera_forward}) <= 0.0f) {
+            return std::nullopt;
+        }
+
+        static auto math_t = sdk::find_type_definition("via.math");
+        static auto world_to_screen_method = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)"); // there are 2 of them.
+
+        Vector4f screen_pos{};
+        world_to_screen_method->call<void*>(&screen_pos, sdk::get_thread_context(), &world_pos, &view, &proj, &screen_size);
+
+        return Vector2f{screen_pos.x, screen_pos.y};
+    }
+};
+
+std::optional<ScreenProjection> get_screen_projection() {
     auto scene = sdk::get_current_scene();
 
     if (scene == nullptr) {
@@ -1463,31 +1489,10 @@ std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
         return std::nullopt;
     }
 
-    if (world_pos_object.is<sol::nil_t>()) {
-        return std::nullopt;
-    }
-
-    Vector4f world_pos{};
-
-    if (world_pos_object.is<Vector2f>()) {
-        auto& v2f = world_pos_object.as<Vector2f&>();
-        world_pos = Vector4f{v2f.x, v2f.y, 0.0f, 1.0f};
-    } else if (world_pos_object.is<Vector3f>()) {
-        auto& v3f = world_pos_object.as<Vector3f&>();
-        world_pos = Vector4f{v3f.x, v3f.y, v3f.z, 1.0f};
-    } else if (world_pos_object.is<Vector4f>()) {
-        auto& v4f = world_pos_object.as<Vector4f&>();
-        world_pos = Vector4f{v4f.x, v4f.y, v4f.z, v4f.w};
-    } else {
-        return std::nullopt;
-    }
-
     static auto transform_def = first_transform->get_type_definition();
-    static auto next_transform_method = transform_def->get_method("get_Next");
     static auto get_gameobject_method = transform_def->get_method("get_GameObject");
     static auto get_position_method = transform_def->get_method("get_Position");
     static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-    static auto math_t = sdk::find_type_definition("via.math");
 
     auto camera = sdk::get_primary_camera();
 
@@ -1504,36 +1509,51 @@ std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
     auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
     auto camera_transform = camera_gameobject->get_transform();
 
-    Vector4f camera_origin{};
-    get_position_method->call<void*>(&camera_origin, context, camera_transform);
-
-    camera_origin.w = 1.0f;
+    ScreenProjection projection{};
 
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
+    get_position_method->call<void*>(&projection.camera_origin, context, camera_transform);
+    projection.camera_origin.w = 1.0f;
 
-    camera_forward.w = 1.0f;
+    get_axisz_method->call<void*>(&projection.camera_forward, context, camera_transform);
+    projection.camera_forward.w = 1.0f;
 
     // Translate 2d position to 3d position (screen to world)
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &projection.proj, context, camera);
+    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &projection.view, context, camera);
+    sdk::call_object_func<void*>(main_view, "get_WindowSize", &projection.screen_size, context, main_view);
 
-    Vector4f screen_pos{};
+    return projection;
+}
 
-    const auto delta = world_pos - camera_origin;
+std::optional<Vector4f> to_world_pos(sol::object world_pos_object) {
+    if (world_pos_object.is<Vector2f>()) {
+        auto& v2f = world_pos_object.as<Vector2f&>();
+        return Vector4f{v2f.x, v2f.y, 0.0f, 1.0f};
+    } else if (world_pos_object.is<Vector3f>()) {
+        auto& v3f = world_pos_object.as<Vector3f&>();
+        return Vector4f{v3f.x, v3f.y, v3f.z, 1.0f};
+    } else if (world_pos_object.is<Vector4f>()) {
+        auto& v4f = world_pos_object.as<Vector4f&>();
+        return Vector4f{v4f.x, v4f.y, v4f.z, v4f.w};
+    }
+
+    return std::nullopt;
+}
+
+std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
+    const auto world_pos = to_world_pos(world_pos_object);
 
-    // behind camera
-    if (glm::dot(Vector3f{delta}, Vector3f{-camera_forward}) <= 0.0f) {
+    if (!world_pos) {
         return std::nullopt;
     }
 
-    static auto world_to_screen_method = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)"); // there are 2 of them.
-    world_to_screen_method->call<void*>(&screen_pos, context, &world_pos, &view, &proj, &screen_size);
+    auto projection = get_screen_projection();
 
-    return Vector2f{screen_pos.x, screen_pos.y};
+    if (!projection) {
+        return std::nullopt;
+    }
+
+    return projection->project(*world_pos);
 }
 
 void world_text(const char* text, sol::object world_pos_object, ImU32 color = 0xFFFFFFFF) {
@@ -1671,6 +1691,254 @@ sol::variadic_results gizmo(sol::this_state s, int64_t unique_id, Matrix4x4f& tr
 
     return results;
 }
+
+// Retained list of overlay primitives. Scripts fill it when their overlay changes and call draw() every frame,
+// so the per frame cost is one call into C++ no matter how many primitives there are.
+class CommandList {
+public:
+    enum class Type : uint8_t {
+        Line,
+        FilledRect,
+        OutlineRect,
+        FilledCircle,
+        OutlineCircle,
+        FilledQuad,
+        OutlineQuad,
+        Text,
+        WorldText,
+    };
+
+    struct Command {
+        Type type{};
+        ImU32 color{};
+        uint32_t text{}; // Index into m_texts for Text/WorldText
+        float v[8]{};
+    };
+
+    // Keeps each reservation well inside what 16 bit indices can address.
+    static constexpr size_t MAX_RECTS_PER_RESERVE = 4096;
+
+    void clear() {
+        m_commands.clear();
+        m_texts.clear();
+    }
+
+    size_t size() const {
+        return m_commands.size();
+    }
+
+    void line(float x1, float y1, float x2, float y2, ImU32 color, sol::object thickness) {
+        push(Type::Line, color, {x1, y1, x2, y2, thickness.is<float>() ? thickness.as<float>() : 1.0f});
+    }
+
+    void filled_rect(float x, float y, float w, float h, ImU32 color) {
+        push(Type::FilledRect, color, {x, y, x + w, y + h});
+    }
+
+    void outline_rect(float x, float y, float w, float h, ImU32 color) {
+        push(Type::OutlineRect, color, {x, y, x + w, y + h});
+    }
+
+    void filled_circle(float x, float y, float radius, ImU32 color, sol::object num_segments) {
+        push(Type::FilledCircle, color, {x, y, radius, (float)(num_segments.is<int>() ? num_segments.as<int>() : 32)});
+    }
+
+    void outline_circle(float x, float y, float radius, ImU32 color, sol::object num_segments) {
+        push(Type::OutlineCircle, color, {x, y, radius, (float)(num_segments.is<int>() ? num_segments.as<int>() : 32)});
+    }
+
+    void filled_quad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, ImU32 color) {
+        push(Type::FilledQuad, color, {x1, y1, x2, y2, x3, y3, x4, y4});
+    }
+
+    void outline_quad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, ImU32 color) {
+        push(Type::OutlineQuad, color, {x1, y1, x2, y2, x3, y3, x4, y4});
+    }
+
+    void text(const char* text, float x, float y, ImU32 color) {
+        push(Type::Text, color, {x, y}).text = add_text(text);
+    }
+
+    void world_text(const char* text, sol::object world_pos_object, ImU32 color) {
+        const auto world_pos = to_world_pos(world_pos_object);
+
+        if (!world_pos) {
+            return;
+        }
+
+        push(Type::WorldText, color, {world_pos->x, world_pos->y, world_pos->z, world_pos->w}).text = add_text(text);
+    }
+
+    // Packed variants take a flat array, {x1, y1, x2, y2, ...} for lines and {x, y, w, h, ...} for rects.
+    // When color is nil every entry carries its own color as an extra trailing element.
+    void lines(sol::table packed, sol::object color, sol::object thickness) {
+        const auto t = thickness.is<float>() ? thickness.as<float>() : 1.0f;
+
+        read_packed<4>(packed, color, [&](const float* v, ImU32 c) {
+            push(Type::Line, c, {v[0], v[1], v[2], v[3], t});
+        });
+    }
+
+    void filled_rects(sol::table packed, sol::object color) {
+        read_packed<4>(packed, color, [&](const float* v, ImU32 c) {
+            push(Type::FilledRect, c, {v[0], v[1], v[0] + v[2], v[1] + v[3]});
+        });
+    }
+
+    void outline_rects(sol::table packed, sol::object color) {
+        read_packed<4>(packed, color, [&](const float* v, ImU32 c) {
+            push(Type::OutlineRect, c, {v[0], v[1], v[0] + v[2], v[1] + v[3]});
+        });
+    }
+
+    void draw() const {
+        auto draw_list = ImGui::GetBackgroundDrawList();
+        std::optional<ScreenProjection> projection{};
+        bool fetched_projection{false};
+
+        for (size_t i = 0; i < m_commands.size();) {
+            const auto& cmd = m_commands[i];
+
+            if (cmd.type == Type::FilledRect) {
+                i = draw_filled_rects(draw_list, i);
+                continue;
+            }
+
+            switch (cmd.type) {
+            case Type::Line:
+                draw_list->AddLine(ImVec2{cmd.v[0], cmd.v[1]}, ImVec2{cmd.v[2], cmd.v[3]}, cmd.color, cmd.v[4]);
+                break;
+            case Type::OutlineRect:
+                draw_list->AddRect(ImVec2{cmd.v[0], cmd.v[1]}, ImVec2{cmd.v[2], cmd.v[3]}, cmd.color);
+                break;
+            case Type::FilledCircle:
+                draw_list->AddCircleFilled(ImVec2{cmd.v[0], cmd.v[1]}, cmd.v[2], cmd.color, (int)cmd.v[3]);
+                break;
+            case Type::OutlineCircle:
+                draw_list->AddCircle(ImVec2{cmd.v[0], cmd.v[1]}, cmd.v[2], cmd.color, (int)cmd.v[3]);
+                break;
+            case Type::FilledQuad:
+                draw_list->AddQuadFilled(ImVec2{cmd.v[0], cmd.v[1]}, ImVec2{cmd.v[2], cmd.v[3]}, ImVec2{cmd.v[4], cmd.v[5]}, ImVec2{cmd.v[6], cmd.v[7]}, cmd.color);
+                break;
+            case Type::OutlineQuad:
+                draw_list->AddQuad(ImVec2{cmd.v[0], cmd.v[1]}, ImVec2{cmd.v[2], cmd.v[3]}, ImVec2{cmd.v[4], cmd.v[5]}, ImVec2{cmd.v[6], cmd.v[7]}, cmd.color);
+                break;
+            case Type::Text:
+                draw_list->AddText(ImVec2{cmd.v[0], cmd.v[1]}, cmd.color, m_texts[cmd.text].c_str());
+                break;
+            case Type::WorldText: {
+                if (!fetched_projection) {
+                    projection = get_screen_projection();
+                    fetched_projection = true;
+                }
+
+                if (!projection) {
+                    break;
+                }
+
+                if (auto screen_pos = projection->project(Vector4f{cmd.v[0], cmd.v[1], cmd.v[2], cmd.v[3]})) {
+                    draw_list->AddText(ImVec2{screen_pos->x, screen_pos->y}, cmd.color, m_texts[cmd.text].c_str());
+                }
+
+                break;
+            }
+            default:
+                break;
+            }
+
+            ++i;
+        }
+    }
+
+private:
+    Command& push(Type type, ImU32 color, std::initializer_list<float> values) {
+        auto& cmd = m_commands.emplace_back();
+        cmd.type = type;
+        cmd.color = color;
+        std::copy(values.begin(), values.end(), cmd.v);
+
+        return cmd;
+    }
+
+    uint32_t add_text(const char* text) {
+        m_texts.emplace_back(text != nullptr ? text : "");
+        return (uint32_t)(m_texts.size() - 1);
+    }
+
+    // Reads the array straight off the Lua stack, going through sol::table for every element would cost
+    // about as much as the per primitive calls this replaces.
+    template<size_t N, typename F>
+    void read_packed(sol::table& packed, sol::object& color, F&& on_entry) {
+        const bool per_entry_color = color.is<sol::nil_t>();
+        const auto fixed_color = per_entry_color ? 0 : color.as<ImU32>();
+        const size_t stride = per_entry_color ? N + 1 : N;
+
+        auto l = packed.lua_state();
+        packed.push();
+
+        const auto len = (size_t)lua_rawlen(l, -1);
+        m_commands.reserve(m_commands.size() + len / stride);
+
+        float v[N]{};
+
+        for (size_t i = 1; i + stride <= len + 1; i += stride) {
+            for (size_t j = 0; j < N; ++j) {
+                lua_rawgeti(l, -1, (lua_Integer)(i + j));
+                v[j] = (float)lua_tonumber(l, -1);
+                lua_pop(l, 1);
+            }
+
+            auto c = fixed_color;
+
+            if (per_entry_color) {
+                lua_rawgeti(l, -1, (lua_Integer)(i + N));
+                c = (ImU32)lua_tointeger(l, -1);
+                lua_pop(l, 1);
+            }
+
+            on_entry(v, c);
+        }
+
+        lua_pop(l, 1);
+    }
+
+    // Consecutive filled rects share vertex reservations. Same output as AddRectFilled without rounding.
+    size_t draw_filled_rects(ImDrawList* draw_list, size_t start) const {
+        auto end = start;
+
+        while (end < m_commands.size() && m_commands[end].type == Type::FilledRect) {
+            ++end;
+        }
+
+        for (auto i = start; i < end;) {
+            const auto batch_end = std::min(end, i + MAX_RECTS_PER_RESERVE);
+
+            // AddRectFilled skips fully transparent rects, the reservation has to match exactly.
+            const auto visible = std::count_if(m_commands.begin() + i, m_commands.begin() + batch_end, [](const Command& cmd) {
+                return (cmd.color & IM_COL32_A_MASK) != 0;
+            });
+
+            if (visible > 0) {
+                draw_list->PrimReserve((int)visible * 6, (int)visible * 4);
+
+                for (auto j = i; j < batch_end; ++j) {
+                    const auto& cmd = m_commands[j];
+
+                    if ((cmd.color & IM_COL32_A_MASK) != 0) {
+                        draw_list->PrimRect(ImVec2{cmd.v[0], cmd.v[1]}, ImVec2{cmd.v[2], cmd.v[3]}, cmd.color);
+                    }
+                }
+            }
+
+            i = batch_end;
+        }
+
+        return end;
+    }
+
+    std::vector<Command> m_commands{};
+    std::vector<std::string> m_texts{};
+};
 } // namespace api::draw
 
 namespace api::imnodes {
@@ -2601,6 +2869,24 @@ void bindings::open_imgui(ScriptState* s) {
     draw["gizmo"] = api::draw::gizmo;
     draw["cube"] = [](const Matrix4x4f& mat) { ::imgui::draw_cube(mat); };
     draw["grid"] = [](const Matrix4x4f& mat, float size) { ::imgui::draw_grid(mat, size); };
+    draw["command_list"] = [] { return api::draw::CommandList{}; };
+    draw.new_usertype<api::draw::CommandList>("CommandList",
+        "clear", &api::draw::CommandList::clear,
+        "size", &api::draw::CommandList::size,
+        "line", &api::draw::CommandList::line,
+        "filled_rect", &api::draw::CommandList::filled_rect,
+        "outline_rect", &api::draw::CommandList::outline_rect,
+        "filled_circle", &api::draw::CommandList::filled_circle,
+        "outline_circle", &api::draw::CommandList::outline_circle,
+        "filled_quad", &api::draw::CommandList::filled_quad,
+        "outline_quad", &api::draw::CommandList::outline_quad,
+        "text", &api::draw::CommandList::text,
+        "world_text", &api::draw::CommandList::world_text,
+        "lines", &api::draw::CommandList::lines,
+        "filled_rects", &api::draw::CommandList::filled_rects,
+        "outline_rects", &api::draw::CommandList::outline_rects,
+        "draw", &api::draw::CommandList::draw
+    );
     lua["draw"] = draw;
 
     auto imnodes = lua.create_table();
@@ -9,6 +9,7 @@
 #include "sdk/REDelegate.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/GameObjectNames.hpp"
 #include "sdk/ResourceManager.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
 #include "sdk/TDBVer.hpp"
@@ -32,6 +33,17 @@ struct BehaviorTree : public ::REManagedObject {
     int unused;
     int unused2;
 };
+
+// What BehaviorTreeObject:resolve() hands to Lua. A ResolvedTreeObject holds spans into the tree's arrays, which
+// commits and the game reallocate, and a script can keep the handle around for as long as it likes.
+// So only the tree is kept and every call resolves again, still once per call for the node walks.
+struct ResolvedBehaviorTree {
+    ::sdk::behaviortree::ResolvedTreeObject resolve() const {
+        return tree->resolve();
+    }
+
+    ::sdk::behaviortree::TreeObject* tree{};
+};
 }
 }
 
@@ -225,7 +237,7 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
                     if (auto it = api::sdk::s_fnv_cache.find(td); it != api::sdk::s_fnv_cache.end()) {
                         typename_hash = it->second;
                     } else {
-                        typename_hash = utility::hash(td->get_full_name());
+                        typename_hash = utility::hash(td->get_full_name_view());
                         api::sdk::s_fnv_cache[td] = typename_hash;
                     }
 
@@ -331,11 +343,10 @@ void add_lua_delegate(sol::this_state s, ::sdk::Delegate* delegate, uint32_t ind
         throw sol::error("Delegate index out of bounds");
     }
 
-    auto& invo = delegate->methods[index];
     auto sol_state = sol::state_view{s};
     auto state = sol_state.registry()["state"].get<ScriptState*>();
 
-    state->add_delegate_callback(invo, callback);
+    state->add_delegate_callback(delegate, index, callback);
 }
 
 // newindex
@@ -975,10 +986,10 @@ sol::object parse_data(lua_State* l, void* data, ::sdk::RETypeDefinition* data_t
             auto underlying_type = data_type->get_underlying_type();
 
             if (underlying_type != nullptr) {
-                full_name_hash = utility::hash(underlying_type->get_full_name());
+                full_name_hash = utility::hash(underlying_type->get_full_name_view());
             }
         } else {
-            full_name_hash = utility::hash(data_type->get_full_name());
+            full_name_hash = utility::hash(data_type->get_full_name_view());
         }
 
         const auto vm_obj_type = data_type->get_vm_obj_type();
@@ -1128,10 +1139,10 @@ void set_data(void* data, ::sdk::RETypeDefinition* data_type, sol::object& value
             auto underlying_type = data_type->get_underlying_type();
 
             if (underlying_type != nullptr) {
-                full_name_hash = utility::hash(underlying_type->get_full_name());
+                full_name_hash = utility::hash(underlying_type->get_full_name_view());
             }
         } else {
-            full_name_hash = utility::hash(data_type->get_full_name());
+            full_name_hash = utility::hash(data_type->get_full_name_view());
         }
 
         // Commemorating the moment I finally added support for this
@@ -1631,6 +1642,10 @@ void bindings::open_sdk(ScriptState* s) {
     sdk["get_native_field"] = api::sdk::get_native_field;
     sdk["set_native_field"] = api::sdk::set_native_field;
     sdk["get_primary_camera"] = api::sdk::get_primary_camera;
+    sdk["find_game_objects_by_name"] = [](const char* name) {
+        const auto game_objects = ::sdk::GameObjectNames::get().find_game_objects_by_name(std::string_view{name});
+        return std::vector<::REManagedObject*>{game_objects.begin(), game_objects.end()};
+    };
     sdk["copy_to_clipboard"] = api::sdk::copy_to_clipboard;
     sdk["hook"] = api::sdk::hook;
     sdk["hook_vtable"] = api::sdk::hook_vtable;
@@ -1696,6 +1711,32 @@ void bindings::open_sdk(ScriptState* s) {
 
         return final_result;
     };
+    sdk["deserialize_batch"] = [](sol::this_state s, sol::object data_obj, sol::table objects_table, sol::object references_obj) -> size_t {
+        if (!data_obj.is<std::vector<uint8_t>>()) {
+            throw sol::error("Data must be a vector of bytes");
+        }
+
+        auto data = data_obj.as<std::vector<uint8_t>>();
+
+        std::vector<::REManagedObject*> objects{};
+        objects.reserve(objects_table.size());
+
+        for (auto i = 1; i <= objects_table.size(); i++) {
+            objects.push_back(objects_table.get<::REManagedObject*>(i));
+        }
+
+        std::vector<::REManagedObject*> references{};
+
+        if (references_obj.is<sol::table>()) {
+            sol::table references_table = references_obj.as<sol::table>();
+
+            for (auto i = 1; i <= references_table.size(); i++) {
+                references.push_back(references_table.get<::REManagedObject*>(i));
+            }
+        }
+
+        return REManagedObject::deserialize_batch(data.data(), data.size(), objects, references);
+    };
     sdk["to_resource"] = [](sol::this_state s, void* ptr) { return sol::make_object(s, (::sdk::Resource*)ptr); };
     sdk["to_double"] = [](void* ptr) { return *(double*)&ptr; };
     sdk["to_float"] = [](void* ptr) { return *(float*)&ptr; };
@@ -1754,7 +1795,7 @@ void bindings::open_sdk(ScriptState* s) {
 
             return fields;
         },
-        "get_full_name", &sdk::RETypeDefinition::get_full_name,
+        "get_full_name", &sdk::RETypeDefinition::get_full_name_view,
         "get_name", &sdk::RETypeDefinition::get_name,
         "get_namespace", &sdk::RETypeDefinition::get_namespace,
         "get_method", &::sdk::RETypeDefinition::get_method,
@@ -1767,6 +1808,25 @@ void bindings::open_sdk(ScriptState* s) {
         "get_valuetype_size", &::sdk::RETypeDefinition::get_valuetype_size,
         "get_generic_argument_types", &::sdk::RETypeDefinition::get_generic_argument_types,
         "get_generic_type_definition", &::sdk::RETypeDefinition::get_generic_type_definition,
+        "instantiate", [](sdk::RETypeDefinition* def, sol::table arguments_table) -> sdk::RETypeDefinition* {
+            std::vector<sdk::RETypeDefinition*> arguments{};
+            arguments.reserve(arguments_table.size());
+
+            // Type names are accepted too, they're resolved once through find_type_definition's map.
+            for (size_t i = 1; i <= arguments_table.size(); ++i) {
+                sol::object arg = arguments_table[i];
+
+                if (arg.is<sdk::RETypeDefinition*>()) {
+                    arguments.push_back(arg.as<sdk::RETypeDefinition*>());
+                } else if (arg.is<const char*>()) {
+                    arguments.push_back(sdk::find_type_definition(arg.as<const char*>()));
+                } else {
+                    return nullptr;
+                }
+            }
+
+            return def->instantiate(arguments);
+        },
         "is_value_type", &::sdk::RETypeDefinition::is_value_type,
         "is_enum", &::sdk::RETypeDefinition::is_enum,
         "is_array", &::sdk::RETypeDefinition::is_array,
@@ -2008,6 +2068,43 @@ void bindings::open_sdk(ScriptState* s) {
         "get_size", &sdk::SystemArray::get_size,
         "get_element", &sdk::SystemArray::get_element,
         "get_elements", &sdk::SystemArray::get_elements,
+        "get_elements_typed", [](sol::this_state s, sdk::SystemArray* arr) -> sol::object {
+            // One pass over the native storage, converting each element the same way fields are.
+            const auto contained_type = arr->get_contained_type();
+
+            if (contained_type == nullptr || !arr->is_single_dimensional()) {
+                const auto elements = arr->get_elements();
+                auto result = sol::state_view{s}.create_table((int)elements.size(), 0);
+
+                for (size_t i = 0; i < elements.size(); ++i) {
+                    result[i + 1] = elements[i];
+                }
+
+                return result;
+            }
+
+            const auto size = arr->get_size();
+            const auto element_size = arr->get_element_size();
+            const auto data = (uint8_t*)arr->get_data();
+
+            auto result = sol::state_view{s}.create_table((int)size, 0);
+
+            for (size_t i = 0; i < size; ++i) {
+                result[i + 1] = api::sdk::parse_data(s, data + i * element_size, contained_type, false);
+            }
+
+            return result;
+        },
+        "set_range", [](sol::this_state s, sdk::SystemArray* arr, uint32_t start, sol::table values) {
+            std::vector<::REManagedObject*> objects{};
+            objects.reserve(values.size());
+
+            for (size_t i = 1; i <= values.size(); ++i) {
+                objects.push_back(values.get<::REManagedObject*>(i));
+            }
+
+            arr->set_range(start, objects);
+        },
         sol::meta_function::index, [](sol::this_state s, sdk::SystemArray* arr, sol::variadic_args args) {
             auto index = args[0];
             if (index.is<int32_t>()) {
@@ -2359,7 +2456,78 @@ void bindings::open_sdk(ScriptState* s) {
         "get_static_condition_count", &::sdk::behaviortree::TreeObject::get_static_condition_count,
         "get_static_transition_count", &::sdk::behaviortree::TreeObject::get_static_transition_count,
         "relocate", &::sdk::behaviortree::TreeObject::relocate,
-        "get_uservariable_hub", &::sdk::behaviortree::TreeObject::get_uservariable_hub
+        "get_uservariable_hub", &::sdk::behaviortree::TreeObject::get_uservariable_hub,
+        "resolve", [](::sdk::behaviortree::TreeObject* obj) {
+            return api::sdk::ResolvedBehaviorTree{obj};
+        },
+        "begin_transaction", [](::sdk::behaviortree::TreeObject* obj) {
+            return ::sdk::behaviortree::TreeTransaction{obj};
+        }
+    );
+
+    lua.new_usertype<::sdk::behaviortree::TreeTransaction>("BehaviorTreeTransaction",
+        "add_action", &::sdk::behaviortree::TreeTransaction::add_action,
+        "add_condition", &::sdk::behaviortree::TreeTransaction::add_condition,
+        "add_transition", &::sdk::behaviortree::TreeTransaction::add_transition,
+        "add_node", &::sdk::behaviortree::TreeTransaction::add_node,
+        "append_node_action", &::sdk::behaviortree::TreeTransaction::append_node_action,
+        "remove_node_action", &::sdk::behaviortree::TreeTransaction::remove_node_action,
+        "append_node_condition", &::sdk::behaviortree::TreeTransaction::append_node_condition,
+        "remove_node_condition", &::sdk::behaviortree::TreeTransaction::remove_node_condition,
+        "empty", &::sdk::behaviortree::TreeTransaction::empty,
+        "commit", &::sdk::behaviortree::TreeTransaction::commit
+    );
+
+    using ResolvedBehaviorTree = api::sdk::ResolvedBehaviorTree;
+
+    lua.new_usertype<ResolvedBehaviorTree>("BehaviorTreeResolvedObject",
+        "get_tree", [](ResolvedBehaviorTree* obj) {
+            return obj->tree;
+        },
+        "is_delayed", [](ResolvedBehaviorTree* obj) {
+            return obj->tree->is_delayed();
+        },
+        "get_action", [](ResolvedBehaviorTree* obj, uint32_t index) {
+            return obj->resolve().get_action(index);
+        },
+        "get_condition", [](ResolvedBehaviorTree* obj, int32_t index) {
+            return obj->resolve().get_condition(index);
+        },
+        "get_transition", [](ResolvedBehaviorTree* obj, int32_t index) {
+            return obj->resolve().get_transition(index);
+        },
+        "get_actions", [](ResolvedBehaviorTree* obj) {
+            const auto actions = obj->resolve().get_actions();
+            return std::vector<::REManagedObject*>{actions.begin(), actions.end()};
+        },
+        "get_conditions", [](ResolvedBehaviorTree* obj) {
+            const auto conditions = obj->resolve().get_conditions();
+            return std::vector<::REManagedObject*>{conditions.begin(), conditions.end()};
+        },
+        "get_transitions", [](ResolvedBehaviorTree* obj) {
+            const auto transitions = obj->resolve().get_transitions();
+            return std::vector<::REManagedObject*>{transitions.begin(), transitions.end()};
+        },
+        "get_node_actions", [](ResolvedBehaviorTree* obj, ::sdk::behaviortree::TreeNode* node) {
+            std::vector<::REManagedObject*> out{};
+            obj->resolve().collect_actions(node, out);
+            return out;
+        },
+        "get_node_conditions", [](ResolvedBehaviorTree* obj, ::sdk::behaviortree::TreeNode* node) {
+            std::vector<::REManagedObject*> out{};
+            obj->resolve().collect_conditions(node, out);
+            return out;
+        },
+        "get_node_transition_conditions", [](ResolvedBehaviorTree* obj, ::sdk::behaviortree::TreeNode* node) {
+            std::vector<::REManagedObject*> out{};
+            obj->resolve().collect_transition_conditions(node, out);
+            return out;
+        },
+        "get_node_transition_events", [](ResolvedBehaviorTree* obj, ::sdk::behaviortree::TreeNode* node) {
+            std::vector<::REManagedObject*> out{};
+            obj->resolve().collect_transition_events(node, out);
+            return out;
+        }
     );
 
     lua.new_usertype<api::sdk::BehaviorTreeCoreHandle>("BehaviorTreeCoreHandle",
@@ -2374,6 +2542,10 @@ void bindings::open_sdk(ScriptState* s) {
         },
         "relocate_datas", [](api::sdk::BehaviorTreeCoreHandle* handle, uintptr_t old_start, uintptr_t old_end, sdk::NativeArrayNoCapacity<sdk::behaviortree::TreeNodeData>& new_nodes) {
             ((sdk::behaviortree::CoreHandle*)handle)->relocate_datas(old_start, old_end, new_nodes);
+        },
+        "begin_transaction", [](api::sdk::BehaviorTreeCoreHandle* handle) {
+            const auto core_handle = (sdk::behaviortree::CoreHandle*)handle;
+            return sdk::behaviortree::TreeTransaction{core_handle->get_tree_object(), core_handle};
         }
     );
 
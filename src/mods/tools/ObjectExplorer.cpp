@@ -419,7 +419,6 @@ void ObjectExplorer::on_draw_dev_ui() {
             break;
         case SdkDumpStage::GENERATE_SDK:
             overlay = "Generating IDA SDK...";
-            progress = static_cast<float>(ImGui::GetTime()) * -0.35f;
             break;
         default: 
             progress = 0.0f;
@@ -480,7 +479,7 @@ void ObjectExplorer::on_draw_dev_ui() {
     }
 
     if (ImGui::CollapsingHeader("Native Singletons")) {
-        auto& native_singletons = reframework::get_globals()->get_native_singleton_types();
+        const auto native_singletons = reframework::get_globals()->get_native_singleton_types();
 
         // Display the nodes
         for (auto t : native_singletons) {
@@ -649,7 +648,7 @@ void ObjectExplorer::on_draw_dev_ui() {
         m_displayed_types.clear();
         m_type_field[0] = '\0';
 
-        if (!std::string_view{m_type_member.data()}.empty()) {
+        if (!std::string_view{m_type_member.data()}.empty() && !search_types_indexed(m_type_member.data(), false)) {
             for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); });
                 i != m_sorted_types.end();
                 i = std::find_if(i + 1, m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); })) {
@@ -664,7 +663,7 @@ void ObjectExplorer::on_draw_dev_ui() {
         m_displayed_types.clear();
         m_type_member[0] = '\0';
 
-        if (!std::string_view{m_type_field.data()}.empty()) {
+        if (!std::string_view{m_type_field.data()}.empty() && !search_types_indexed(m_type_field.data(), true)) {
             for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); });
                 i != m_sorted_types.end();
                 i = std::find_if(i + 1, m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); })) {
@@ -777,13 +776,16 @@ void ObjectExplorer::on_frame() {
 
             for (auto& listener : m_veh_state.read_listeners) {
                 if (ImGui::TreeNode(listener.second->field, "%s [Hits: %d [%d instructions]]", listener.second->field->get_name(), listener.second->hits, listener.second->instructions.size())) {
-                    for (auto& instruction : listener.second->instructions) {
-                        auto nearest_method = locate_nearest_method(instruction);
+                    const std::vector<uintptr_t> instructions{listener.second->instructions.begin(), listener.second->instructions.end()};
+                    std::vector<sdk::REMethodDefinition*> nearest_methods(instructions.size());
+
+                    locate_nearest_methods(instructions, nearest_methods);
 
-                        if (nearest_method != nullptr) {
-                            attempt_display_method(nullptr, *nearest_method, true);
+                    for (size_t i = 0; i < instructions.size(); ++i) {
+                        if (nearest_methods[i] != nullptr) {
+                            attempt_display_method(nullptr, *nearest_methods[i], true);
                         } else {
-                            ImGui::Text("0x%p", instruction);
+                            ImGui::Text("0x%p", instructions[i]);
                         }
                     }
 
@@ -2512,11 +2514,16 @@ void ObjectExplorer::generate_sdk(const bool skip_sdkgenny) {
     sdk.generate("sdk");*/
 
     spdlog::info("Generating IDA SDK...");
+    report_sdk_dump_progress(0.0f);
     m_sdk_dump_stage = SdkDumpStage::GENERATE_SDK;
 
     if (!skip_sdkgenny) {
         genny::ida::transform(sdk);
-        sdk.generate("sdk_ida");
+
+        // Headers are independent once the graph is built, so they're written in parallel. Output matches a serial run.
+        sdk.generate("sdk_ida", std::max(std::thread::hardware_concurrency(), 1u), [this](size_t done, size_t total) {
+            report_sdk_dump_progress((float)done / (float)total);
+        });
     }
 
     // Free a couple gigabytes of no longer used memory
@@ -4824,6 +4831,10 @@ void ObjectExplorer::init() {
     populate_classes();
     populate_enums();
 
+    if (m_search_index_thread == nullptr) {
+        m_search_index_thread = std::make_unique<std::jthread>([this](std::stop_token stop_token) { build_search_index(stop_token); });
+    }
+
     if (m_function_occurrences.empty()) {
         const auto tdb = sdk::RETypeDB::get();
 
@@ -4846,9 +4857,40 @@ void ObjectExplorer::init() {
 
             m_function_occurrences[func]++;
         }
+
+        build_method_index();
     }
 }
 
+void ObjectExplorer::build_method_index() {
+    const auto game = utility::get_executable();
+    const auto game_base = (uintptr_t)game;
+    const auto game_size = utility::get_module_size(game).value_or(0);
+
+    std::vector<utility::AddressIndex<sdk::REMethodDefinition*>::Entry> entries{};
+    entries.reserve(m_method_map.size());
+
+    for (const auto& [func, method] : m_method_map) {
+        uintptr_t end = 0;
+
+        // Functions outside of the executable are rare, only pay for the module lookup on those.
+        const auto module_base = (func >= game_base && func < game_base + game_size) ? game_base : (uintptr_t)utility::get_module_within(func).value_or(nullptr);
+
+        if (module_base != 0) {
+            if (const auto entry = utility::find_function_entry(func); entry && module_base + entry->BeginAddress == func) {
+                end = module_base + entry->EndAddress;
+            }
+        }
+
+        entries.push_back({func, end, method});
+    }
+
+    m_method_index.build(std::move(entries));
+    ++m_method_index_generation;
+
+    spdlog::info("[ObjectExplorer] Built method index with {} entries", m_method_index.size());
+}
+
 void ObjectExplorer::install_veh() {
     if (m_veh_installed) {
         return;
@@ -5260,6 +5302,110 @@ uintptr_t ObjectExplorer::get_original_va(void* ptr) {
     return *utility::get_imagebase_va_from_ptr(m_module_chunk.data(), g_framework->get_module(), ptr);
 }
 
+void ObjectExplorer::build_search_index(std::stop_token stop_token) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+
+    utility::SubstringIndex::Builder methods{};
+    utility::SubstringIndex::Builder fields{};
+
+    // Same strings is_filtered_method and is_filtered_field look at.
+    for (uint32_t i = 0; i < m_sorted_types.size(); ++i) {
+        if (stop_token.stop_requested()) {
+            return;
+        }
+
+        const auto add = [i](utility::SubstringIndex::Builder& builder, const char* str) {
+            if (str != nullptr) {
+                builder.add(i, str);
+            }
+        };
+
+        auto it = m_types.find(m_sorted_types[i]);
+
+        if (it == m_types.end() || it->second == nullptr) {
+            continue;
+        }
+
+        auto tdef = utility::re_type::get_type_definition(it->second);
+
+        if (tdef == nullptr) {
+            continue;
+        }
+
+        for (auto& m : tdef->get_methods()) try {
+            add(methods, m.get_name());
+
+            if (auto return_type = m.get_return_type(); return_type != nullptr) {
+                methods.add(i, return_type->get_full_name());
+            }
+
+            for (auto param_name : m.get_param_names()) {
+                add(methods, param_name);
+            }
+
+            for (auto param_type : m.get_param_types()) {
+                if (param_type != nullptr) {
+                    add(methods, param_type->get_name());
+                }
+            }
+        } catch (...) {
+        }
+
+        for (auto f : tdef->get_fields()) try {
+            if (f == nullptr) {
+                continue;
+            }
+
+            add(fields, f->get_name());
+
+            if (auto field_type = f->get_type(); field_type != nullptr) {
+                fields.add(i, field_type->get_full_name());
+            }
+        } catch (...) {
+        }
+    }
+
+    auto method_index = std::make_shared<const utility::SubstringIndex>(methods.build());
+    auto field_index = std::make_shared<const utility::SubstringIndex>(fields.build());
+
+    spdlog::info("[ObjectExplorer] Built search index with {} method strings and {} field strings in {}ms",
+        method_index->get_num_strings(), field_index->get_num_strings(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time).count());
+
+    std::scoped_lock _{m_search_index_mutex};
+    m_method_search_index = std::move(method_index);
+    m_field_search_index = std::move(field_index);
+}
+
+bool ObjectExplorer::search_types_indexed(std::string_view query, bool fields) {
+    // Regex can't use the trigrams, it goes through is_filtered_type like before.
+    if (m_search_using_regex) {
+        return false;
+    }
+
+    std::shared_ptr<const utility::SubstringIndex> index{};
+
+    {
+        std::scoped_lock _{m_search_index_mutex};
+        index = fields ? m_field_search_index : m_method_search_index;
+    }
+
+    if (index == nullptr) {
+        return false;
+    }
+
+    std::vector<uint32_t> owners{};
+    index->search(query, fields ? m_field_search : m_method_search, owners);
+
+    for (const auto owner : owners) {
+        if (auto t = get_type(m_sorted_types[owner])) {
+            m_displayed_types.push_back(t);
+        }
+    }
+
+    return true;
+}
+
 bool ObjectExplorer::is_filtered_type(std::string name) {
     auto it = m_types.find(name);
 
@@ -5391,36 +5537,54 @@ bool ObjectExplorer::is_filtered_field(sdk::REField& f) try {
 }
 
 sdk::REMethodDefinition* ObjectExplorer::locate_nearest_method(uintptr_t instruction) {
-    static thread_local std::unordered_map<uintptr_t, sdk::REMethodDefinition*> method_map{};
-    if (auto it = method_map.find(instruction); it != method_map.end()) {
-        return it->second;
-    }
+    struct HotCache {
+        utility::SmallLru<uintptr_t, sdk::REMethodDefinition*> lru{};
+        uint32_t generation{0};
+    };
 
-    auto unwound_function_start = utility::find_function_start_unwind(instruction);
-    if (!unwound_function_start) {
-        unwound_function_start = instruction;
+    static thread_local HotCache cache{};
+
+    if (const auto generation = m_method_index_generation.load(); cache.generation != generation) {
+        cache.lru.clear();
+        cache.generation = generation;
     }
 
-    size_t nearest_distance = UINT64_MAX;
-    sdk::REMethodDefinition* nearest_method{nullptr};
+    if (auto it = cache.lru.find(instruction); it != nullptr) {
+        return *it;
+    }
 
-    const auto search = *unwound_function_start;
+    sdk::REMethodDefinition* result{nullptr};
 
-    for (auto& it : m_method_map) {
-        if (it.first > search) {
-            continue;
-        }
+    // Fast path: the instruction falls inside a method's unwind range, no unwind walk needed.
+    if (auto entry = m_method_index.find_containing(instruction); entry != nullptr) {
+        result = entry->value;
+    } else {
+        const auto search = utility::find_function_start_unwind(instruction).value_or(instruction);
 
-        const auto distance = search - it.first;
-        if (distance < nearest_distance) {
-            nearest_distance = distance;
-            nearest_method = it.second;
+        if (auto nearest = m_method_index.find_nearest(search); nearest != nullptr) {
+            result = nearest->value;
         }
     }
 
-    method_map[instruction] = nearest_method;
+    cache.lru.insert(instruction, result);
+
+    return result;
+}
 
-    return nearest_method;
+void ObjectExplorer::locate_nearest_methods(std::span<const uintptr_t> instructions, std::span<sdk::REMethodDefinition*> out) {
+    std::vector<const utility::AddressIndex<sdk::REMethodDefinition*>::Entry*> entries(instructions.size());
+    m_method_index.find_nearest_many(instructions, entries);
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        const auto entry = entries[i];
+
+        if (entry != nullptr && instructions[i] < entry->end) {
+            out[i] = entry->value;
+        } else {
+            // Outside of any known range (or no unwind data), take the slow path for this one.
+            out[i] = locate_nearest_method(instructions[i]);
+        }
+    }
 }
 
 HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
@@ -6,12 +6,15 @@
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <imgui.h>
 #include <json.hpp>
 #include <asmjit/asmjit.h>
 #include <asmjit/x86/x86assembler.h>
 
 #include "utility/Address.hpp"
+#include "utility/AddressIndex.hpp"
+#include "utility/SubstringIndex.hpp"
 #include "Tool.hpp"
 #include "HookManager.hpp"
 
@@ -208,6 +211,9 @@ private:
 
     uintptr_t get_original_va(void* ptr);
 
+    void build_search_index(std::stop_token stop_token);
+    bool search_types_indexed(std::string_view query, bool fields);
+
     bool is_filtered_type(std::string name);
     bool is_filtered_method(sdk::REMethodDefinition& m);
     bool is_filtered_field(sdk::REField& f);
@@ -239,6 +245,8 @@ private:
     }
 
     sdk::REMethodDefinition* locate_nearest_method(uintptr_t instruction);
+    void locate_nearest_methods(std::span<const uintptr_t> instructions, std::span<sdk::REMethodDefinition*> out);
+    void build_method_index();
     HookManager::PreHookResult pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
     static HookManager::PreHookResult pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
 
@@ -384,10 +392,20 @@ private:
     std::unordered_set<void*> m_ok_methods{};
     std::unordered_map<void*, uint32_t> m_function_occurrences{}; // occurrences of re-uses of the function address in other methods
     std::unordered_map<uintptr_t, sdk::REMethodDefinition*> m_method_map{};
+    utility::AddressIndex<sdk::REMethodDefinition*> m_method_index{}; // sorted by function start, end bounds from unwind data
+    std::atomic<uint32_t> m_method_index_generation{0};
     std::unordered_multimap<std::string, EnumDescriptor> m_enums;
     std::unordered_map<std::string, REType*> m_types;
     std::vector<std::string> m_sorted_types;
 
+    // Method and field signature search, owners are indices into m_sorted_types.
+    std::mutex m_search_index_mutex{};
+    std::shared_ptr<const utility::SubstringIndex> m_method_search_index{};
+    std::shared_ptr<const utility::SubstringIndex> m_field_search_index{};
+    utility::SubstringIndex::Search m_method_search{};
+    utility::SubstringIndex::Search m_field_search{};
+    std::unique_ptr<std::jthread> m_search_index_thread{};
+
     std::mutex m_enum_mutex;
 
     // Types currently being displayed
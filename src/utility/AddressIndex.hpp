@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace utility {
+// Branchless search for the last element whose key is <= the given key.
+// data must be sorted by key. Returns nullptr if every key is greater.
+template <typename T, typename Key, typename Proj>
+const T* find_last_le(const T* data, size_t n, Key key, Proj proj) {
+    if (n == 0) {
+        return nullptr;
+    }
+
+    auto base = data;
+
+    while (n > 1) {
+        const auto half = n / 2;
+        base = (proj(base[half]) <= key) ? base + half : base;
+        n -= half;
+    }
+
+    return proj(*base) <= key ? base : nullptr;
+}
+
+// Sorted code address -> value index with optional end bounds (e.g. from unwind data).
+// Immutable after build(), so lookups can be done from any thread.
+template <typename T>
+class AddressIndex {
+public:
+    struct Entry {
+        uintptr_t start{};
+        uintptr_t end{}; // 0 if unknown
+        T value{};
+    };
+
+    void build(std::vector<Entry>&& entries) {
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.start < b.start; });
+        entries.erase(std::unique(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.start == b.start; }), entries.end());
+        entries.shrink_to_fit();
+
+        m_entries = std::move(entries);
+    }
+
+    void clear() {
+        m_entries.clear();
+    }
+
+    bool empty() const {
+        return m_entries.empty();
+    }
+
+    size_t size() const {
+        return m_entries.size();
+    }
+
+    std::span<const Entry> entries() const {
+        return m_entries;
+    }
+
+    // Entry with the greatest start <= addr.
+    const Entry* find_nearest(uintptr_t addr) const {
+        return find_last_le(m_entries.data(), m_entries.size(), addr, [](const Entry& e) { return e.start; });
+    }
+
+    // Entry whose known [start, end) range contains addr.
+    const Entry* find_containing(uintptr_t addr) const {
+        const auto e = find_nearest(addr);
+        return e != nullptr && addr < e->end ? e : nullptr;
+    }
+
+    const Entry* find_exact(uintptr_t addr) const {
+        const auto e = find_nearest(addr);
+        return e != nullptr && e->start == addr ? e : nullptr;
+    }
+
+    // Resolves many addresses at once (e.g. a whole callstack).
+    // Addresses are visited in sorted order so each search only covers the
+    // part of the index past the previous hit.
+    void find_nearest_many(std::span<const uintptr_t> addrs, std::span<const Entry*> out) const {
+        std::vector<uint32_t> order(addrs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return addrs[a] < addrs[b]; });
+
+        const Entry* lo = m_entries.data();
+        const Entry* const last = m_entries.data() + m_entries.size();
+
+        for (const auto i : order) {
+            const auto e = find_last_le(lo, (size_t)(last - lo), addrs[i], [](const Entry& e) { return e.start; });
+            out[i] = e;
+
+            if (e != nullptr) {
+                lo = e;
+            }
+        }
+    }
+
+private:
+    std::vector<Entry> m_entries{};
+};
+
+// Tiny fixed-capacity LRU for hot lookups (e.g. return addresses).
+// Linear scan over N contiguous keys, most recently used first.
+template <typename K, typename V, size_t N = 32>
+class SmallLru {
+public:
+    V* find(const K& key) {
+        for (size_t i = 0; i < m_size; ++i) {
+            if (m_keys[i] == key) {
+                touch(i);
+                return &m_values[0];
+            }
+        }
+
+        return nullptr;
+    }
+
+    void insert(const K& key, const V& value) {
+        if (m_size < N) {
+            ++m_size;
+        }
+
+        // Evict the least recently used entry (the last one).
+        std::move_backward(m_keys.begin(), m_keys.begin() + m_size - 1, m_keys.begin() + m_size);
+        std::move_backward(m_values.begin(), m_values.begin() + m_size - 1, m_values.begin() + m_size);
+
+        m_keys[0] = key;
+        m_values[0] = value;
+    }
+
+    void clear() {
+        m_size = 0;
+    }
+
+private:
+    void touch(size_t i) {
+        if (i == 0) {
+            return;
+        }
+
+        std::rotate(m_keys.begin(), m_keys.begin() + i, m_keys.begin() + i + 1);
+        std::rotate(m_values.begin(), m_values.begin() + i, m_values.begin() + i + 1);
+    }
+
+    std::array<K, N> m_keys{};
+    std::array<V, N> m_values{};
+    size_t m_size{0};
+};
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "ConfigStore.hpp"
+
+namespace fs = std::filesystem;
+
+namespace utility {
+namespace {
+std::shared_ptr<const ConfigStore::Snapshot> make_snapshot(Config cfg) {
+    auto table = ConfigTable::from_key_values(cfg.get_key_values());
+    return std::make_shared<const ConfigStore::Snapshot>(std::move(cfg), std::move(table));
+}
+}
+
+ConfigStore::ConfigStore(fs::path path)
+    : m_path{std::move(path)}
+{
+    m_writer = std::make_unique<std::jthread>([this](std::stop_token stop_token) { writer_proc(stop_token); });
+}
+
+ConfigStore::~ConfigStore() {
+    if (m_writer != nullptr) {
+        m_writer->request_stop();
+        m_writer.reset();
+    }
+
+    flush();
+}
+
+std::shared_ptr<const ConfigStore::Snapshot> ConfigStore::load_snapshot() {
+    std::error_code ec{};
+    const auto write_time = fs::last_write_time(m_path, ec);
+
+    std::scoped_lock _{m_mutex};
+
+    // A save that hasn't hit the disk yet is newer than whatever the file says.
+    if (m_pending != nullptr) {
+        return m_pending;
+    }
+
+    if (ec) {
+        m_cached = std::make_shared<const Snapshot>();
+        m_cached_write_time.reset();
+        return m_cached;
+    }
+
+    if (m_cached == nullptr || m_cached_write_time != write_time) {
+        m_cached = make_snapshot(Config{m_path.string()});
+        m_cached_write_time = write_time;
+    }
+
+    return m_cached;
+}
+
+void ConfigStore::save(Config cfg) {
+    auto snapshot = make_snapshot(std::move(cfg));
+
+    {
+        std::scoped_lock _{m_mutex};
+
+        m_pending = std::move(snapshot);
+        m_pending_since = std::chrono::steady_clock::now();
+    }
+
+    m_cv.notify_one();
+}
+
+bool ConfigStore::save_now(Config cfg) {
+    save(std::move(cfg));
+    return flush();
+}
+
+bool ConfigStore::flush() {
+    std::scoped_lock write_lock{m_write_mutex};
+    std::shared_ptr<const Snapshot> pending{};
+
+    {
+        std::scoped_lock _{m_mutex};
+        pending = m_pending;
+    }
+
+    if (pending == nullptr) {
+        return true;
+    }
+
+    const auto result = write(pending->config);
+
+    std::error_code ec{};
+    const auto write_time = fs::last_write_time(m_path, ec);
+
+    std::scoped_lock _{m_mutex};
+
+    // Still pending, the writer thread tries again after SAVE_RETRY_DELAY.
+    if (!result) {
+        m_retry_at = std::chrono::steady_clock::now() + SAVE_RETRY_DELAY;
+        return false;
+    }
+
+    // Written configs become the cached parse, so the next load doesn't read back what we just wrote.
+    m_cached = pending;
+    m_cached_write_time = ec ? std::nullopt : std::optional{write_time};
+
+    // Another save may have come in while writing, that one still has to go out.
+    if (m_pending == pending) {
+        m_pending.reset();
+    }
+
+    return true;
+}
+
+void ConfigStore::writer_proc(std::stop_token stop_token) {
+    while (!stop_token.stop_requested()) {
+        {
+            std::unique_lock lock{m_mutex};
+
+            if (!m_cv.wait(lock, stop_token, [this] { return m_pending != nullptr; })) {
+                return;
+            }
+
+            // Wait until saves stop coming in for SAVE_DEBOUNCE, and past the retry delay after a failed write.
+            while (!stop_token.stop_requested() && m_pending != nullptr) {
+                const auto due = std::max(m_pending_since + SAVE_DEBOUNCE, m_retry_at);
+
+                if (std::chrono::steady_clock::now() >= due) {
+                    break;
+                }
+
+                m_cv.wait_until(lock, stop_token, due, [] { return false; });
+            }
+        }
+
+        if (stop_token.stop_requested()) {
+            return;
+        }
+
+        flush();
+    }
+}
+
+bool ConfigStore::write(const Config& cfg) {
+    // Write next to the real file and swap it in, so a crash mid-write never leaves a truncated config behind.
+    auto tmp_path = m_path;
+    tmp_path += ".tmp";
+
+    try {
+        // Config::save isn't const.
+        auto copy = cfg;
+
+        if (!copy.save(tmp_path.string())) {
+            spdlog::error("[ConfigStore] Failed to write {}", tmp_path.string());
+            return false;
+        }
+
+        fs::rename(tmp_path, m_path);
+    } catch (const std::exception& e) {
+        spdlog::error("[ConfigStore] Failed to save {}: {}", m_path.string(), e.what());
+        return false;
+    } catch (...) {
+        spdlog::error("[ConfigStore] Unexpected error while saving {}", m_path.string());
+        return false;
+    }
+
+    return true;
+}
+}
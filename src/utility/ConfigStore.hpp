@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <utility/Config.hpp>
+
+#include "ConfigTable.hpp"
+
+namespace utility {
+// Owns one config file. Every loader shares a single parsed copy, which is only re-parsed when the file changes
+// on disk, and saves are written from a background thread with bursts of saves collapsed into one write.
+// A save that fails to write stays pending and is retried.
+class ConfigStore {
+public:
+    static constexpr auto SAVE_DEBOUNCE = std::chrono::milliseconds{250};
+    static constexpr auto SAVE_RETRY_DELAY = std::chrono::seconds{2};
+
+    // A parsed config plus its values indexed by interned key id, see ConfigTable::Binding.
+    struct Snapshot {
+        Config config{};
+        ConfigTable table{};
+    };
+
+    ConfigStore(std::filesystem::path path);
+    ~ConfigStore();
+
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    // Empty if the file doesn't exist, same as constructing a Config from a missing file.
+    std::shared_ptr<const Snapshot> load_snapshot();
+
+    std::shared_ptr<const Config> load() {
+        auto snapshot = load_snapshot();
+        return {snapshot, &snapshot->config};
+    }
+
+    // The saved config becomes what load() returns right away, the file is written shortly after.
+    void save(Config cfg);
+
+    // Saves and writes on the calling thread, for shutdown where the writer thread may not get another chance.
+    bool save_now(Config cfg);
+
+    // Writes a pending save now, on the calling thread. Returns false if the write failed, the save stays pending.
+    bool flush();
+
+    bool has_pending() {
+        std::scoped_lock _{m_mutex};
+        return m_pending != nullptr;
+    }
+
+    const std::filesystem::path& path() const {
+        return m_path;
+    }
+
+private:
+    void writer_proc(std::stop_token stop_token);
+    bool write(const Config& cfg);
+
+    std::filesystem::path m_path{};
+
+    std::mutex m_mutex{};
+    std::shared_ptr<const Snapshot> m_cached{};
+    std::optional<std::filesystem::file_time_type> m_cached_write_time{};
+
+    // Guarded by m_mutex. Writes are serialized by m_write_mutex so a flush can't race the writer thread.
+    std::shared_ptr<const Snapshot> m_pending{};
+    std::chrono::steady_clock::time_point m_pending_since{};
+    std::chrono::steady_clock::time_point m_retry_at{};
+    std::mutex m_write_mutex{};
+
+    std::condition_variable_any m_cv{};
+    std::unique_ptr<std::jthread> m_writer{};
+};
+}
@@ -0,0 +1,96 @@
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "ConfigTable.hpp"
+
+namespace utility {
+namespace {
+struct KeyTable {
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    std::shared_mutex mutex{};
+    std::unordered_map<std::string, uint32_t, Hash, std::equal_to<>> ids{};
+    std::vector<std::string> names{};
+};
+
+KeyTable& key_table() {
+    static KeyTable table{};
+    return table;
+}
+
+thread_local const Config* t_bound_config{nullptr};
+thread_local const ConfigTable* t_bound_table{nullptr};
+}
+
+uint32_t ConfigKeys::intern(std::string_view name) {
+    auto& table = key_table();
+
+    {
+        std::shared_lock _{table.mutex};
+
+        if (auto it = table.ids.find(name); it != table.ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock _{table.mutex};
+
+    // Someone else may have added it between the locks.
+    const auto [it, inserted] = table.ids.try_emplace(std::string{name}, (uint32_t)table.names.size());
+
+    if (inserted) {
+        table.names.emplace_back(name);
+    }
+
+    return it->second;
+}
+
+uint32_t ConfigKeys::find(std::string_view name) {
+    auto& table = key_table();
+    std::shared_lock _{table.mutex};
+
+    if (auto it = table.ids.find(name); it != table.ids.end()) {
+        return it->second;
+    }
+
+    return INVALID;
+}
+
+std::string ConfigKeys::name(uint32_t id) {
+    auto& table = key_table();
+    std::shared_lock _{table.mutex};
+
+    return id < table.names.size() ? table.names[id] : std::string{};
+}
+
+size_t ConfigKeys::size() {
+    auto& table = key_table();
+    std::shared_lock _{table.mutex};
+
+    return table.names.size();
+}
+
+ConfigTable::Binding::Binding(const Config& cfg, const ConfigTable& table)
+    : m_prev_config{t_bound_config},
+    m_prev_table{t_bound_table}
+{
+    t_bound_config = &cfg;
+    t_bound_table = &table;
+}
+
+ConfigTable::Binding::~Binding() {
+    t_bound_config = m_prev_config;
+    t_bound_table = m_prev_table;
+}
+
+const ConfigTable* ConfigTable::bound_to(const Config& cfg) {
+    return t_bound_config == &cfg ? t_bound_table : nullptr;
+}
+}
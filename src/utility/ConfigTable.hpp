@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utility {
+class Config;
+
+// Process-wide ids for config key names. A name keeps its id for the lifetime of the process,
+// so a ModValue interns its name once and every later load is an index into a ConfigTable.
+class ConfigKeys {
+public:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    static uint32_t intern(std::string_view name);
+
+    // INVALID if the name was never interned.
+    static uint32_t find(std::string_view name);
+
+    static std::string name(uint32_t id);
+    static size_t size();
+};
+
+// The values of one parsed config, indexed by key id.
+class ConfigTable {
+public:
+    ConfigTable() = default;
+
+    // Interns every key.
+    template <typename KeyValues>
+    static ConfigTable from_key_values(const KeyValues& key_values) {
+        ConfigTable table{};
+
+        for (const auto& [name, value] : key_values) {
+            table.set(ConfigKeys::intern(name), value);
+        }
+
+        return table;
+    }
+
+    void set(uint32_t id, std::string value) {
+        if (id >= m_values.size()) {
+            m_values.resize(id + 1);
+        }
+
+        if (!m_values[id].has_value()) {
+            ++m_size;
+        }
+
+        m_values[id] = std::move(value);
+    }
+
+    const std::string* get(uint32_t id) const {
+        if (id >= m_values.size() || !m_values[id].has_value()) {
+            return nullptr;
+        }
+
+        return &*m_values[id];
+    }
+
+    // Same conversions as Config::get<T>: the value is read with operator>> and boolalpha, so leading
+    // whitespace and '+' are accepted and anything after the number is ignored ("12abc" is 12).
+    template <typename T>
+    std::optional<T> get(uint32_t id) const {
+        const auto value = get(id);
+
+        if (value == nullptr) {
+            return std::nullopt;
+        }
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            return *value;
+        } else {
+            T result{};
+            std::istringstream ss{*value};
+            ss >> std::boolalpha >> result;
+
+            if (ss.fail()) {
+                return std::nullopt;
+            }
+
+            return result;
+        }
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    // While a Binding is alive, ModValue::config_load reads the bound config through its table on this thread.
+    // Any other Config (one a mod built itself, say) still goes through the string lookups.
+    class Binding {
+    public:
+        Binding(const Config& cfg, const ConfigTable& table);
+        ~Binding();
+
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+
+    private:
+        const Config* m_prev_config{};
+        const ConfigTable* m_prev_table{};
+    };
+
+    // The table bound to cfg on this thread, or nullptr.
+    static const ConfigTable* bound_to(const Config& cfg);
+
+private:
+    std::vector<std::optional<std::string>> m_values{};
+    size_t m_size{0};
+};
+}
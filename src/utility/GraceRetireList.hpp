@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace utility {
+// Calls currently inside one object, counted by the callee itself (e.g. by a jitted thunk).
+// On its own cache line so objects called from different threads don't contend.
+struct alignas(64) InFlightCounter {
+    std::atomic<uint64_t> count{0};
+
+    void enter() {
+        count.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void leave() {
+        count.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    bool idle() const {
+        return count.load(std::memory_order_seq_cst) == 0;
+    }
+};
+
+// Objects other threads can still reach for a short while after they were unlinked, without taking any lock.
+// A thunk address the engine loaded just before the invocation was pointed elsewhere, say: that caller hasn't
+// counted itself yet, so a count reading zero alone doesn't mean nobody is about to use the object.
+//
+// A retired object is released only once at least `grace` epochs have passed since it was retired and its own
+// count reads zero. The owner advances the epoch at a point every thread passes regularly (once per frame).
+// Not thread safe, the owner serializes retire(), advance() and collect().
+template <typename T>
+class GraceRetireList {
+public:
+    explicit GraceRetireList(uint64_t grace = 2) : m_grace{grace} {}
+
+    void retire(T item) {
+        m_items.push_back({std::move(item), m_epoch});
+    }
+
+    void advance() {
+        ++m_epoch;
+    }
+
+    // Releases every item that's past its grace period and idle, the rest wait for a later collect.
+    template <typename Idle, typename Release>
+    size_t collect(Idle&& is_idle, Release&& release) {
+        const auto released = std::erase_if(m_items, [&](Retired& retired) {
+            if (m_epoch - retired.epoch < m_grace || !is_idle(retired.item)) {
+                return false;
+            }
+
+            release(retired.item);
+            return true;
+        });
+
+        return released;
+    }
+
+    uint64_t epoch() const {
+        return m_epoch;
+    }
+
+    bool empty() const {
+        return m_items.empty();
+    }
+
+    size_t size() const {
+        return m_items.size();
+    }
+
+private:
+    struct Retired {
+        T item;
+        uint64_t epoch{};
+    };
+
+    std::vector<Retired> m_items{};
+    uint64_t m_epoch{0};
+    uint64_t m_grace;
+};
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+namespace utility {
+// Fixed-slab object pool with a lock-free free list.
+// Objects never move and are never freed while the pool is alive, so pointers handed out stay valid.
+// acquire/release are a CAS on a tagged head, the mutex is only taken when a new slab has to be allocated.
+template <typename T, size_t SlabSize = 64, size_t MaxSlabs = 256>
+class SlabPool {
+public:
+    SlabPool() = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Returns nullptr if the pool is at MaxSlabs * SlabSize objects and all of them are in use.
+    T* acquire() {
+        for (;;) {
+            if (const auto index = pop(); index != INVALID) {
+                return &node(index).value;
+            }
+
+            if (!grow()) {
+                return nullptr;
+            }
+        }
+    }
+
+    void release(T* value) {
+        if (value == nullptr) {
+            return;
+        }
+
+        push(reinterpret_cast<Node*>(value)->index);
+    }
+
+    size_t capacity() const {
+        return m_num_slabs.load(std::memory_order_acquire) * SlabSize;
+    }
+
+private:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    struct Node {
+        T value{}; // first, so a T* converts back to its node
+        uint32_t index{INVALID};
+        std::atomic<uint32_t> next{INVALID};
+    };
+
+    static_assert(std::is_standard_layout_v<Node>, "SlabPool requires T* to be convertible back to its node");
+
+    using Slab = std::array<Node, SlabSize>;
+
+    // Head is (tag << 32 | index), the tag avoids ABA when the same node is popped and pushed back.
+    static constexpr uint64_t pack(uint32_t index, uint32_t tag) {
+        return ((uint64_t)tag << 32) | index;
+    }
+
+    Node& node(uint32_t index) {
+        return (*m_slabs[index / SlabSize].load(std::memory_order_acquire))[index % SlabSize];
+    }
+
+    uint32_t pop() {
+        auto head = m_head.load(std::memory_order_acquire);
+
+        for (;;) {
+            const auto index = (uint32_t)head;
+
+            if (index == INVALID) {
+                return INVALID;
+            }
+
+            const auto next = node(index).next.load(std::memory_order_relaxed);
+
+            if (m_head.compare_exchange_weak(head, pack(next, (uint32_t)(head >> 32) + 1), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    void push(uint32_t index) {
+        auto head = m_head.load(std::memory_order_relaxed);
+
+        for (;;) {
+            node(index).next.store((uint32_t)head, std::memory_order_relaxed);
+
+            if (m_head.compare_exchange_weak(head, pack(index, (uint32_t)(head >> 32) + 1), std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    bool grow() {
+        std::scoped_lock _{m_grow_mutex};
+
+        // Someone else grew it (or released something) while we were waiting.
+        if ((uint32_t)m_head.load(std::memory_order_acquire) != INVALID) {
+            return true;
+        }
+
+        const auto slab_index = m_num_slabs.load(std::memory_order_relaxed);
+
+        if (slab_index >= MaxSlabs) {
+            return false;
+        }
+
+        auto slab = std::make_unique<Slab>();
+        const auto base = (uint32_t)(slab_index * SlabSize);
+
+        for (uint32_t i = 0; i < SlabSize; ++i) {
+            (*slab)[i].index = base + i;
+        }
+
+        m_slabs[slab_index].store(slab.get(), std::memory_order_release);
+        m_owned_slabs[slab_index] = std::move(slab);
+        m_num_slabs.store(slab_index + 1, std::memory_order_release);
+
+        for (uint32_t i = 0; i < SlabSize; ++i) {
+            push(base + i);
+        }
+
+        return true;
+    }
+
+    std::atomic<uint64_t> m_head{pack(INVALID, 0)};
+    std::array<std::atomic<Slab*>, MaxSlabs> m_slabs{};
+    std::array<std::unique_ptr<Slab>, MaxSlabs> m_owned_slabs{};
+    std::atomic<size_t> m_num_slabs{0};
+    std::mutex m_grow_mutex{};
+};
+
+// Hash-keyed counters spread over independent shards so unrelated keys don't share cache lines.
+// Every shard is a fixed open-addressing table, so increments never lock or allocate.
+// Keys must be nonzero. Once a shard is full new keys go to a shared overflow counter.
+template <size_t NumShards = 16, size_t SlotsPerShard = 1024>
+class ShardedCounters {
+public:
+    static_assert((SlotsPerShard & (SlotsPerShard - 1)) == 0, "SlotsPerShard must be a power of two");
+
+    ShardedCounters() : m_shards{std::make_unique<Shard[]>(NumShards)} {}
+
+    // Returns the value before the increment.
+    uint64_t increment(uint64_t key) {
+        if (auto slot = find_or_insert(key); slot != nullptr) {
+            return slot->count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return m_overflow.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::optional<uint64_t> get(uint64_t key) const {
+        const auto& shard = m_shards[shard_index(key)];
+
+        for (size_t i = 0, pos = key & (SlotsPerShard - 1); i < SlotsPerShard; ++i, pos = (pos + 1) & (SlotsPerShard - 1)) {
+            const auto slot_key = shard.slots[pos].key.load(std::memory_order_acquire);
+
+            if (slot_key == key) {
+                return shard.slots[pos].count.load(std::memory_order_relaxed);
+            }
+
+            if (slot_key == 0) {
+                break;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // Number of distinct keys seen.
+    size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    // Not synchronized with concurrent increments, those may land before or after the reset.
+    void clear() {
+        for (size_t s = 0; s < NumShards; ++s) {
+            for (auto& slot : m_shards[s].slots) {
+                slot.count.store(0, std::memory_order_relaxed);
+                slot.key.store(0, std::memory_order_release);
+            }
+        }
+
+        m_overflow.store(0, std::memory_order_relaxed);
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key{0};
+        std::atomic<uint64_t> count{0};
+    };
+
+    struct alignas(64) Shard {
+        std::array<Slot, SlotsPerShard> slots{};
+    };
+
+    static size_t shard_index(uint64_t key) {
+        return (size_t)(key >> 48) % NumShards;
+    }
+
+    Slot* find_or_insert(uint64_t key) {
+        auto& shard = m_shards[shard_index(key)];
+
+        for (size_t i = 0, pos = key & (SlotsPerShard - 1); i < SlotsPerShard; ++i, pos = (pos + 1) & (SlotsPerShard - 1)) {
+            auto& slot = shard.slots[pos];
+            auto slot_key = slot.key.load(std::memory_order_acquire);
+
+            if (slot_key == 0) {
+                if (slot.key.compare_exchange_strong(slot_key, key, std::memory_order_acq_rel)) {
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+                    return &slot;
+                }
+
+                // Lost the race, slot_key now holds the winner's key.
+            }
+
+            if (slot_key == key) {
+                return &slot;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<uint64_t> m_overflow{0};
+    std::atomic<size_t> m_size{0};
+};
+
+// Bounded multi-producer queue with per-cell sequence numbers (Vyukov).
+// Producers never block, try_push fails when the ring is full. Meant to be drained by one consumer.
+template <typename T, size_t Capacity>
+class MpscRing {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    MpscRing() : m_cells{std::make_unique<Cell[]>(Capacity)} {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // fill(T&) writes the element in place, so large elements aren't copied twice.
+    template <typename F>
+    bool try_push(F&& fill) {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+
+        for (;;) {
+            auto& cell = m_cells[pos & (Capacity - 1)];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell.value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer. Returns the number of elements handed to f.
+    template <typename F>
+    size_t drain(F&& f, size_t max = Capacity) {
+        size_t count = 0;
+
+        while (count < max) {
+            auto& cell = m_cells[m_head & (Capacity - 1)];
+
+            if (cell.sequence.load(std::memory_order_acquire) != m_head + 1) {
+                break;
+            }
+
+            f(cell.value);
+            cell.sequence.store(m_head + Capacity, std::memory_order_release);
+            ++m_head;
+            ++count;
+        }
+
+        return count;
+    }
+
+    // Consumer side. Nothing left to drain right now, a push may still be in flight.
+    bool empty() const {
+        return m_cells[m_head & (Capacity - 1)].sequence.load(std::memory_order_acquire) != m_head + 1;
+    }
+
+    // Elements rejected because the ring was full.
+    uint64_t dropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<size_t> m_tail{0};
+    alignas(64) size_t m_head{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+}
@@ -1,82 +1,241 @@
 #pragma once
 
-#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
-#include <utility/ScopeGuard.hpp>
 
-// Safe callback vector that handles additions during iteration
-// Prevents vector reallocation crashes by queuing new callbacks added during iteration
-// and merging them when iteration completes.
+// Callback list that can be iterated from any number of threads while callbacks are added or removed,
+// including from inside the callbacks themselves.
+//
+// Readers iterate an immutable snapshot published through an atomic pointer. Starting an iteration is
+// two atomic operations and never blocks. Writers build a new snapshot under a mutex and retire the
+// old one. Retired snapshots are freed by the next writer (or collect()) that sees no active readers.
+//
+// Removal is by the handle add() returned. It flags the callback so iterations in progress skip it right away,
+// the snapshots are compacted later.
+//
+// Writers, clear() and collect() free callbacks, so when T holds Lua references they must run with the
+// owning Lua state locked.
 template<typename T>
 class SafeCallbackVector {
+public:
+    using Handle = uint64_t;
+
 private:
-    std::vector<T> m_callbacks;
-    std::vector<T> m_pending;
-    std::vector<T> m_pending_removals;
-    int m_use_count = 0;
+    struct Node {
+        Node(Handle handle, const T& callback) : handle{handle}, callback{callback} {}
+
+        Handle handle{};
+        T callback;
+        std::atomic<bool> removed{false};
+    };
+
+    struct Snapshot {
+        std::vector<std::shared_ptr<Node>> nodes{};
+    };
 
 public:
-    // Create a scope guard that increments use count and merges pending when released
-    auto acquire_iteration() {
-        m_use_count++;
-        return utility::ScopeGuard([this]() {
-            m_use_count--;
-            if (m_use_count == 0) {
-                // Apply pending removals
-                if (!m_pending_removals.empty()) {
-                    for (const auto& item : m_pending_removals) {
-                        auto it = std::find(m_callbacks.begin(), m_callbacks.end(), item);
-                        if (it != m_callbacks.end()) {
-                            m_callbacks.erase(it);
-                        }
-                    }
-                    m_pending_removals.clear();
-                }
-                
-                // Merge pending additions
-                if (!m_pending.empty()) {
-                    m_callbacks.insert(m_callbacks.end(), m_pending.begin(), m_pending.end());
-                    m_pending.clear();
+    // Entry handed to iterating code.
+    struct Entry {
+        Handle handle;
+        T& callback;
+    };
+
+    class Iteration {
+    public:
+        class iterator {
+        public:
+            iterator(const std::shared_ptr<Node>* it, const std::shared_ptr<Node>* end) : m_it{it}, m_end{end} {
+                skip_removed();
+            }
+
+            Entry operator*() const {
+                return Entry{(*m_it)->handle, (*m_it)->callback};
+            }
+
+            iterator& operator++() {
+                ++m_it;
+                skip_removed();
+                return *this;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return m_it != other.m_it;
+            }
+
+        private:
+            void skip_removed() {
+                while (m_it != m_end && (*m_it)->removed.load(std::memory_order_acquire)) {
+                    ++m_it;
                 }
             }
-        });
+
+            const std::shared_ptr<Node>* m_it;
+            const std::shared_ptr<Node>* m_end;
+        };
+
+        Iteration(const Iteration&) = delete;
+        Iteration& operator=(const Iteration&) = delete;
+
+        ~Iteration() {
+            m_owner->m_active_readers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        iterator begin() const {
+            const auto data = m_snapshot->nodes.data();
+            return iterator{data, data + m_snapshot->nodes.size()};
+        }
+
+        iterator end() const {
+            const auto data = m_snapshot->nodes.data();
+            return iterator{data + m_snapshot->nodes.size(), data + m_snapshot->nodes.size()};
+        }
+
+    private:
+        friend class SafeCallbackVector;
+
+        Iteration(const SafeCallbackVector* owner, const Snapshot* snapshot) : m_owner{owner}, m_snapshot{snapshot} {}
+
+        const SafeCallbackVector* m_owner;
+        const Snapshot* m_snapshot;
+    };
+
+    SafeCallbackVector() {
+        m_current.store(new Snapshot{}, std::memory_order_release);
     }
 
-    // Get the callback vector for iteration
-    std::vector<T>& get() {
-        return m_callbacks;
+    SafeCallbackVector(const SafeCallbackVector&) = delete;
+    SafeCallbackVector& operator=(const SafeCallbackVector&) = delete;
+
+    ~SafeCallbackVector() {
+        delete m_current.load(std::memory_order_acquire);
     }
 
-    // Add a callback (queues if currently iterating)
-    void add(const T& callback) {
-        if (m_use_count > 0) {
-            m_pending.push_back(callback);
-        } else {
-            m_callbacks.push_back(callback);
-        }
+    // Pins the current snapshot for the lifetime of the returned object.
+    // Callbacks added during the iteration show up in the next one, removed ones are skipped immediately.
+    Iteration acquire_iteration() const {
+        // The reader count has to be visible before the snapshot is loaded, see try_reclaim_locked.
+        m_active_readers.fetch_add(1, std::memory_order_seq_cst);
+        return Iteration{this, m_current.load(std::memory_order_seq_cst)};
     }
 
-    // Remove a callback (queues if currently iterating)
-    void remove(const T& callback) {
-        if (m_use_count > 0) {
-            m_pending_removals.push_back(callback);
-        } else {
-            auto it = std::find(m_callbacks.begin(), m_callbacks.end(), callback);
-            if (it != m_callbacks.end()) {
-                m_callbacks.erase(it);
-            }
+    Handle add(const T& callback) {
+        std::scoped_lock _{m_write_mutex};
+
+        auto node = std::make_shared<Node>(++m_next_handle, callback);
+        m_by_handle[node->handle] = node;
+        m_nodes.push_back(std::move(node));
+        m_size.store(m_by_handle.size(), std::memory_order_relaxed);
+
+        compact_locked();
+        publish_locked();
+
+        return m_next_handle;
+    }
+
+    // O(1), the snapshot itself is compacted once enough entries are dead.
+    bool remove(Handle handle) {
+        std::scoped_lock _{m_write_mutex};
+
+        auto it = m_by_handle.find(handle);
+
+        if (it == m_by_handle.end()) {
+            return false;
+        }
+
+        it->second->removed.store(true, std::memory_order_release);
+        m_by_handle.erase(it);
+        m_size.store(m_by_handle.size(), std::memory_order_relaxed);
+        ++m_num_removed;
+
+        if (m_num_removed * 2 > m_nodes.size()) {
+            compact_locked();
+            publish_locked();
         }
+
+        return true;
     }
 
-    // Clear all callbacks
     void clear() {
-        m_callbacks.clear();
-        m_pending.clear();
-        m_pending_removals.clear();
+        std::scoped_lock _{m_write_mutex};
+
+        for (auto& node : m_nodes) {
+            node->removed.store(true, std::memory_order_release);
+        }
+
+        m_nodes.clear();
+        m_by_handle.clear();
+        m_num_removed = 0;
+        m_size.store(0, std::memory_order_relaxed);
+
+        publish_locked();
+    }
+
+    // Frees retired snapshots if no iteration is running. Writers already do this, call it
+    // periodically if callbacks are removed without being followed by another write.
+    void collect() {
+        if (!has_retired()) {
+            return;
+        }
+
+        std::scoped_lock _{m_write_mutex};
+        try_reclaim_locked();
+    }
+
+    // Lock free, lets callers skip locking a Lua state when there's nothing to collect.
+    bool has_retired() const {
+        return m_num_retired.load(std::memory_order_relaxed) != 0;
     }
 
-    // Check if empty
+    // Lock free, lets callers skip locking a Lua state when there's nothing to call.
     bool empty() const {
-        return m_callbacks.empty() && m_pending.empty();
+        return m_size.load(std::memory_order_relaxed) == 0;
+    }
+
+    size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+private:
+    void compact_locked() {
+        if (m_num_removed == 0) {
+            return;
+        }
+
+        std::erase_if(m_nodes, [](const auto& node) { return node->removed.load(std::memory_order_relaxed); });
+        m_num_removed = 0;
     }
+
+    void publish_locked() {
+        auto next = new Snapshot{m_nodes};
+        m_retired.emplace_back(m_current.exchange(next, std::memory_order_seq_cst));
+        m_num_retired.store(m_retired.size(), std::memory_order_relaxed);
+
+        try_reclaim_locked();
+    }
+
+    void try_reclaim_locked() {
+        // A reader that could still see a retired snapshot incremented m_active_readers before the snapshot
+        // was replaced. Readers that start after this check can only load the current one.
+        if (!m_retired.empty() && m_active_readers.load(std::memory_order_seq_cst) == 0) {
+            m_retired.clear();
+            m_num_retired.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<const Snapshot*> m_current{nullptr};
+    mutable std::atomic<uint32_t> m_active_readers{0};
+    std::atomic<size_t> m_size{0};
+    std::atomic<size_t> m_num_retired{0};
+
+    // Writer side, guarded by m_write_mutex.
+    std::mutex m_write_mutex{};
+    std::vector<std::shared_ptr<Node>> m_nodes{};
+    std::unordered_map<Handle, std::shared_ptr<Node>> m_by_handle{};
+    std::vector<std::unique_ptr<const Snapshot>> m_retired{};
+    size_t m_num_removed{0};
+    Handle m_next_handle{0};
 };
@@ -0,0 +1,156 @@
+#include <algorithm>
+
+#include "SubstringIndex.hpp"
+
+namespace utility {
+namespace {
+char to_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+}
+
+uint32_t SubstringIndex::make_trigram(char a, char b, char c) {
+    return ((uint32_t)(uint8_t)to_lower(a) << 16) | ((uint32_t)(uint8_t)to_lower(b) << 8) | (uint32_t)(uint8_t)to_lower(c);
+}
+
+void SubstringIndex::Builder::add(uint32_t owner, std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+
+    auto [it, inserted] = m_ids.try_emplace(std::string{text}, (uint32_t)m_strings.size());
+
+    if (inserted) {
+        m_strings.push_back(it->first);
+    }
+
+    m_links.emplace_back(it->second, owner);
+    m_num_owners = std::max(m_num_owners, owner + 1);
+}
+
+SubstringIndex SubstringIndex::Builder::build() {
+    SubstringIndex result{};
+    result.m_num_owners = m_num_owners;
+
+    size_t total_size = 0;
+
+    for (const auto& str : m_strings) {
+        total_size += str.size() + 1;
+    }
+
+    result.m_text.reserve(total_size);
+    result.m_offsets.reserve(m_strings.size() + 1);
+
+    for (uint32_t id = 0; id < m_strings.size(); ++id) {
+        const auto str = m_strings[id];
+
+        result.m_offsets.push_back((uint32_t)result.m_text.size());
+        result.m_text.append(str);
+        result.m_text.push_back('\0');
+
+        // Ids only go up, so checking the back is enough to keep each list sorted and unique.
+        for (size_t i = 0; i + 3 <= str.size(); ++i) {
+            auto& postings = result.m_postings[make_trigram(str[i], str[i + 1], str[i + 2])];
+
+            if (postings.empty() || postings.back() != id) {
+                postings.push_back(id);
+            }
+        }
+    }
+
+    result.m_offsets.push_back((uint32_t)result.m_text.size());
+
+    std::sort(m_links.begin(), m_links.end());
+    m_links.erase(std::unique(m_links.begin(), m_links.end()), m_links.end());
+
+    result.m_owner_offsets.assign(m_strings.size() + 1, 0);
+    result.m_owners.reserve(m_links.size());
+
+    for (const auto& [id, owner] : m_links) {
+        ++result.m_owner_offsets[id + 1];
+        result.m_owners.push_back(owner);
+    }
+
+    for (size_t i = 1; i < result.m_owner_offsets.size(); ++i) {
+        result.m_owner_offsets[i] += result.m_owner_offsets[i - 1];
+    }
+
+    for (auto& [trigram, postings] : result.m_postings) {
+        postings.shrink_to_fit();
+    }
+
+    m_ids.clear();
+    m_strings.clear();
+    m_links.clear();
+
+    return result;
+}
+
+void SubstringIndex::search(std::string_view query, Search& state, std::vector<uint32_t>& owners) const {
+    owners.clear();
+
+    if (query.empty()) {
+        state = {};
+        return;
+    }
+
+    std::vector<uint32_t> matches{};
+
+    const auto check = [&](uint32_t id) {
+        if (get_string(id).find(query) != std::string_view::npos) {
+            matches.push_back(id);
+        }
+    };
+
+    if (state.index == this && !state.query.empty() && query.find(state.query) != std::string_view::npos) {
+        // Typing more characters can only narrow the result.
+        for (const auto id : state.matches) {
+            check(id);
+        }
+    } else if (query.size() >= 3) {
+        // Every match contains all of the query's trigrams, so the rarest one bounds the candidates.
+        const std::vector<uint32_t>* candidates{nullptr};
+
+        for (size_t i = 0; i + 3 <= query.size(); ++i) {
+            const auto it = m_postings.find(make_trigram(query[i], query[i + 1], query[i + 2]));
+
+            if (it == m_postings.end()) {
+                candidates = nullptr;
+                break;
+            }
+
+            if (candidates == nullptr || it->second.size() < candidates->size()) {
+                candidates = &it->second;
+            }
+        }
+
+        if (candidates != nullptr) {
+            for (const auto id : *candidates) {
+                check(id);
+            }
+        }
+    } else {
+        for (uint32_t id = 0; id < get_num_strings(); ++id) {
+            check(id);
+        }
+    }
+
+    state.index = this;
+    state.query = query;
+    state.matches = std::move(matches);
+
+    std::vector<bool> found(m_num_owners, false);
+
+    for (const auto id : state.matches) {
+        for (auto i = m_owner_offsets[id]; i < m_owner_offsets[id + 1]; ++i) {
+            found[m_owners[i]] = true;
+        }
+    }
+
+    for (uint32_t owner = 0; owner < m_num_owners; ++owner) {
+        if (found[owner]) {
+            owners.push_back(owner);
+        }
+    }
+}
+}
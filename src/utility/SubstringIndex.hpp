@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace utility {
+// Case sensitive substring search over a large set of strings, each linked to one or more owners.
+// Strings are interned, candidates come from lowercase trigram postings and are verified against the
+// original text. Immutable after building, so one index can be built on a worker and read from the UI.
+class SubstringIndex {
+public:
+    class Builder {
+    public:
+        void add(uint32_t owner, std::string_view text);
+        SubstringIndex build();
+
+    private:
+        std::unordered_map<std::string, uint32_t> m_ids{};
+        std::vector<std::string_view> m_strings{}; // Keys of m_ids, in id order
+        std::vector<std::pair<uint32_t, uint32_t>> m_links{}; // String -> owner
+        uint32_t m_num_owners{0};
+    };
+
+    // Per search box. A query that contains the previous one only rechecks the previous matches.
+    struct Search {
+        const SubstringIndex* index{nullptr};
+        std::string query{};
+        std::vector<uint32_t> matches{}; // String ids
+    };
+
+    // owners is filled in ascending order.
+    void search(std::string_view query, Search& state, std::vector<uint32_t>& owners) const;
+
+    std::string_view get_string(uint32_t id) const {
+        return std::string_view{m_text}.substr(m_offsets[id], m_offsets[id + 1] - m_offsets[id] - 1);
+    }
+
+    size_t get_num_strings() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    uint32_t get_num_owners() const { return m_num_owners; }
+
+private:
+    static uint32_t make_trigram(char a, char b, char c);
+
+    std::string m_text{}; // Every string followed by a '\0'
+    std::vector<uint32_t> m_offsets{};
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings{}; // Trigram -> sorted string ids
+    std::vector<uint32_t> m_owner_offsets{}; // String id -> range in m_owners
+    std::vector<uint32_t> m_owners{};
+    uint32_t m_num_owners{0};
+};
+}
@@ -0,0 +1,247 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <utility/AddressIndex.hpp>
+
+#include "Test.hpp"
+
+using utility::AddressIndex;
+using utility::SmallLru;
+
+namespace {
+using Index = AddressIndex<uint32_t>;
+using Entry = Index::Entry;
+
+const Entry* brute_nearest(const std::vector<Entry>& sorted, uintptr_t addr) {
+    const Entry* best = nullptr;
+
+    for (const auto& e : sorted) {
+        if (e.start <= addr) {
+            best = &e;
+        }
+    }
+
+    return best;
+}
+
+const Entry* brute_containing(const std::vector<Entry>& sorted, uintptr_t addr) {
+    for (const auto& e : sorted) {
+        if (e.start <= addr && addr < e.end) {
+            return &e;
+        }
+    }
+
+    return nullptr;
+}
+
+// Functions with random sizes and gaps between the unwind end and the next start, some without an end.
+std::vector<Entry> make_functions(size_t n, uint64_t seed) {
+    std::mt19937_64 rng{seed};
+    std::vector<Entry> entries{};
+    uintptr_t address = 0x140001000;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        const auto size = 1 + rng() % 0x400;
+        entries.push_back({address, rng() % 8 == 0 ? 0 : address + size, i});
+        address += size + rng() % 0x40;
+    }
+
+    return entries;
+}
+
+void test_basic() {
+    Index index{};
+    CHECK(index.empty());
+    CHECK(index.find_nearest(0x1000) == nullptr);
+    CHECK(index.find_containing(0x1000) == nullptr);
+
+    // Unsorted, with a duplicate start (the first one wins).
+    index.build({{0x3000, 0x3100, 3}, {0x1000, 0x1080, 1}, {0x2000, 0, 2}, {0x1000, 0x1FFF, 9}});
+
+    CHECK(index.size() == 3);
+    CHECK(index.entries()[0].value == 1);
+    CHECK(index.entries()[1].value == 2);
+    CHECK(index.entries()[2].value == 3);
+
+    // Before the first function.
+    CHECK(index.find_nearest(0) == nullptr);
+    CHECK(index.find_nearest(0xFFF) == nullptr);
+    CHECK(index.find_containing(0xFFF) == nullptr);
+    CHECK(index.find_exact(0xFFF) == nullptr);
+
+    // Inside and at the start.
+    CHECK(index.find_nearest(0x1000)->value == 1);
+    CHECK(index.find_exact(0x1000)->value == 1);
+    CHECK(index.find_containing(0x1000)->value == 1);
+    CHECK(index.find_containing(0x107F)->value == 1);
+
+    // In the gap after the unwind end: still the nearest, but not contained.
+    CHECK(index.find_nearest(0x1080)->value == 1);
+    CHECK(index.find_containing(0x1080) == nullptr);
+    CHECK(index.find_containing(0x1FFF) == nullptr);
+    CHECK(index.find_exact(0x1001) == nullptr);
+
+    // Unknown end, never contained.
+    CHECK(index.find_nearest(0x2010)->value == 2);
+    CHECK(index.find_containing(0x2000) == nullptr);
+
+    // Past the last function.
+    CHECK(index.find_nearest(0x3100)->value == 3);
+    CHECK(index.find_nearest(UINTPTR_MAX)->value == 3);
+    CHECK(index.find_containing(0x3100) == nullptr);
+
+    const std::vector<uintptr_t> addrs{0x3050, 0xFFF, 0x1040, 0x3050, 0x2000};
+    std::vector<const Entry*> out(addrs.size());
+    index.find_nearest_many(addrs, out);
+
+    CHECK(out[0]->value == 3);
+    CHECK(out[1] == nullptr);
+    CHECK(out[2]->value == 1);
+    CHECK(out[3]->value == 3);
+    CHECK(out[4]->value == 2);
+
+    index.clear();
+    CHECK(index.empty());
+    CHECK(index.find_nearest(0x1000) == nullptr);
+}
+
+void test_against_brute_force() {
+    auto entries = make_functions(2000, 1);
+    const auto sorted = entries;
+
+    Index index{};
+    index.build(std::move(entries));
+    CHECK(index.size() == sorted.size());
+
+    std::mt19937_64 rng{2};
+    const auto lo = sorted.front().start - 0x100;
+    const auto hi = sorted.back().start + 0x1000;
+
+    std::vector<uintptr_t> addrs{};
+
+    for (size_t i = 0; i < 5000; ++i) {
+        addrs.push_back(lo + rng() % (hi - lo));
+    }
+
+    // Exact starts and ends too.
+    for (size_t i = 0; i < sorted.size(); i += 7) {
+        addrs.push_back(sorted[i].start);
+        addrs.push_back(sorted[i].end);
+        addrs.push_back(sorted[i].start - 1);
+    }
+
+    size_t mismatches = 0;
+
+    for (const auto addr : addrs) {
+        const auto nearest = index.find_nearest(addr);
+        const auto expected = brute_nearest(sorted, addr);
+
+        if ((nearest == nullptr) != (expected == nullptr) || (nearest != nullptr && nearest->value != expected->value)) {
+            ++mismatches;
+        }
+
+        const auto containing = index.find_containing(addr);
+        const auto expected_containing = brute_containing(sorted, addr);
+
+        if ((containing == nullptr) != (expected_containing == nullptr) || (containing != nullptr && containing->value != expected_containing->value)) {
+            ++mismatches;
+        }
+    }
+
+    std::vector<const Entry*> out(addrs.size());
+    index.find_nearest_many(addrs, out);
+
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        if (out[i] != index.find_nearest(addrs[i])) {
+            ++mismatches;
+        }
+    }
+
+    CHECK(mismatches == 0);
+}
+
+void test_lru() {
+    SmallLru<uint64_t, int, 4> lru{};
+
+    CHECK(lru.find(1) == nullptr);
+
+    lru.insert(1, 10);
+    lru.insert(2, 20);
+    lru.insert(3, 30);
+    lru.insert(4, 40);
+
+    CHECK(*lru.find(1) == 10);
+    CHECK(*lru.find(4) == 40);
+
+    // Order is now 4, 1, 3, 2 (most recent first), so 2 goes first and 3 after it.
+    lru.insert(5, 50);
+    CHECK(lru.find(2) == nullptr);
+    CHECK(*lru.find(3) == 30);
+    CHECK(*lru.find(5) == 50);
+
+    // Now 5, 3, 4, 1.
+    lru.insert(6, 60);
+    CHECK(lru.find(1) == nullptr);
+    CHECK(*lru.find(4) == 40);
+    CHECK(*lru.find(3) == 30);
+    CHECK(*lru.find(5) == 50);
+    CHECK(*lru.find(6) == 60);
+
+    // Values follow their keys when reordered.
+    *lru.find(4) = 41;
+    CHECK(*lru.find(6) == 60);
+    CHECK(*lru.find(4) == 41);
+
+    lru.clear();
+    CHECK(lru.find(4) == nullptr);
+    CHECK(lru.find(6) == nullptr);
+
+    lru.insert(7, 70);
+    CHECK(*lru.find(7) == 70);
+}
+
+void bench(bool full) {
+    const size_t num_functions = full ? 1'000'000 : 200'000;
+    constexpr size_t NUM_ADDRS = 1'000'000;
+
+    auto entries = make_functions(num_functions, 3);
+    const auto lo = entries.front().start;
+    const auto hi = entries.back().end != 0 ? entries.back().end : entries.back().start + 1;
+
+    Index index{};
+    const auto build_ms = test::time_ms([&] { index.build(std::move(entries)); });
+
+    std::mt19937_64 rng{4};
+    std::vector<uintptr_t> addrs(NUM_ADDRS);
+
+    for (auto& a : addrs) {
+        a = lo + rng() % (hi - lo);
+    }
+
+    size_t found = 0;
+
+    const auto nearest_ms = test::time_ms([&] {
+        for (const auto a : addrs) {
+            found += index.find_containing(a) != nullptr;
+        }
+    });
+
+    std::vector<const Entry*> out(addrs.size());
+    const auto many_ms = test::time_ms([&] { index.find_nearest_many(addrs, out); });
+
+    CHECK(found > 0);
+
+    std::printf("%zu functions: build %.2f ms, %zu random find_containing %.2f ms (%.1f ns each), find_nearest_many %.2f ms\n",
+        num_functions, build_ms, NUM_ADDRS, nearest_ms, nearest_ms * 1e6 / NUM_ADDRS, many_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_basic();
+    test_against_brute_force();
+    test_lru();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("AddressIndexTests");
+}
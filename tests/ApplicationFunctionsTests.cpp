@@ -0,0 +1,139 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sdk/Application.hpp>
+#include <sdk/GameIdentity.hpp>
+
+#include "Test.hpp"
+
+using sdk::Application;
+
+namespace {
+// A module entry table laid out like the game's, written through the same offsets the accessors read.
+struct SyntheticTable {
+    SyntheticTable(size_t count) : bytes(count * Application::get_function_stride()), count{count} {}
+
+    Application::Function* get(size_t i) {
+        return Application::get_function_at((Application::Function*)bytes.data(), i);
+    }
+
+    void set(size_t i, const char* description, uint16_t priority) {
+        const auto base = (uint8_t*)get(i);
+        std::memcpy(base + 0x10, &description, sizeof(description));
+        std::memcpy(base + 0x18, &priority, sizeof(priority));
+    }
+
+    std::vector<uint8_t> bytes{};
+    size_t count{};
+};
+
+// The scans the index replaced: first slot with the name or priority wins.
+Application::Function* linear_find(SyntheticTable& table, std::string_view name) {
+    for (size_t i = 0; i < table.count; ++i) {
+        const auto fn = table.get(i);
+
+        if (fn->get_description() != nullptr && name == fn->get_description()) {
+            return fn;
+        }
+    }
+
+    return nullptr;
+}
+
+Application::Function* linear_find(SyntheticTable& table, uint16_t priority) {
+    for (size_t i = 0; i < table.count; ++i) {
+        if (table.get(i)->get_priority() == priority) {
+            return table.get(i);
+        }
+    }
+
+    return nullptr;
+}
+
+void test_lookups() {
+    SyntheticTable table{Application::MAX_FUNCTIONS};
+    std::vector<std::string> names{};
+
+    for (size_t i = 0; i < table.count; ++i) {
+        names.push_back("Entry" + std::to_string(i % 700)); // Some repeated names
+    }
+
+    std::mt19937 rng{7};
+
+    for (size_t i = 0; i < table.count; ++i) {
+        // Unnamed slots and repeated priorities like the tail of a real table.
+        const auto description = (i % 37 == 0) ? nullptr : names[i].c_str();
+        table.set(i, description, (uint16_t)(rng() % 1500));
+    }
+
+    const Application::FunctionIndex index{table.get(0), table.count};
+
+    for (size_t i = 0; i < 700; ++i) {
+        const auto name = "Entry" + std::to_string(i);
+        CHECK(index.find(name) == linear_find(table, name));
+    }
+
+    CHECK(index.find("Missing") == nullptr);
+
+    for (uint16_t priority = 0; priority < 1600; ++priority) {
+        CHECK(index.find(priority) == linear_find(table, priority));
+    }
+
+    // A range holds exactly one entry per priority present, in priority order.
+    for (const auto [start, end] : {std::pair<uint16_t, uint16_t>{0, 1500}, {100, 200}, {1499, 1499}, {300, 299}}) {
+        const auto range = index.get_range(start, end);
+        std::vector<Application::Function*> expected{};
+
+        for (uint32_t priority = start; priority <= end; ++priority) {
+            if (const auto fn = linear_find(table, (uint16_t)priority); fn != nullptr) {
+                expected.push_back(fn);
+            }
+        }
+
+        CHECK(std::vector<Application::Function*>(range.begin(), range.end()) == expected);
+    }
+}
+
+void bench_lookups() {
+    SyntheticTable table{Application::MAX_FUNCTIONS};
+    std::vector<std::string> names{};
+
+    for (size_t i = 0; i < table.count; ++i) {
+        names.push_back("via.module.Entry" + std::to_string(i));
+    }
+
+    for (size_t i = 0; i < table.count; ++i) {
+        table.set(i, names[i].c_str(), (uint16_t)i);
+    }
+
+    const Application::FunctionIndex index{table.get(0), table.count};
+    constexpr size_t NUM_LOOKUPS = 10'000;
+    size_t found = 0;
+
+    const auto indexed_ms = test::time_ms([&] {
+        for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+            found += index.find(names[(i * 7919) % names.size()]) != nullptr;
+        }
+    });
+
+    const auto linear_ms = test::time_ms([&] {
+        for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+            found += linear_find(table, names[(i * 7919) % names.size()]) != nullptr;
+        }
+    });
+
+    CHECK(found == NUM_LOOKUPS * 2);
+    std::printf("%zu name lookups: indexed %.2f ms, linear %.2f ms\n", NUM_LOOKUPS, indexed_ms, linear_ms);
+}
+}
+
+int main() {
+    sdk::GameIdentity::initialize();
+
+    test_lookups();
+    bench_lookups();
+
+    return test::finish("ApplicationFunctionsTests");
+}
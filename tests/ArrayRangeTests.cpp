@@ -0,0 +1,220 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <sdk/ArrayRange.hpp>
+
+#include "Test.hpp"
+
+using namespace sdk::array_range;
+
+namespace {
+// Same shape as an REArrayBase (REManagedObject header, contained type, dimensions, count)
+// followed by its element storage.
+struct FakeArrayHeader {
+    void* info{};
+    int32_t reference_count{1};
+    int32_t unk{};
+    void* contained_type{};
+    int32_t num1{1};
+    int32_t num_elements{};
+};
+
+static_assert(sizeof(FakeArrayHeader) == 0x20);
+
+struct FakeArray {
+    FakeArray(int32_t num_elements, uint32_t element_size, size_t storage_elements)
+        : element_size{element_size},
+          blob(sizeof(FakeArrayHeader) + storage_elements * element_size + 16, 0xCD)
+    {
+        header() = FakeArrayHeader{};
+        header().num_elements = num_elements;
+    }
+
+    FakeArrayHeader& header() {
+        return *(FakeArrayHeader*)blob.data();
+    }
+
+    uint8_t* data() {
+        return blob.data() + sizeof(FakeArrayHeader);
+    }
+
+    size_t size() {
+        return size_from_header(header().num_elements);
+    }
+
+    template <typename T>
+    std::span<T> elements() {
+        return {(T*)data(), size()};
+    }
+
+    uint32_t element_size{};
+    std::vector<uint8_t> blob{};
+};
+
+// The fill byte past the end of the elements is untouched.
+bool guard_intact(FakeArray& array, size_t storage_elements) {
+    for (auto p = array.data() + storage_elements * array.element_size; p < array.blob.data() + array.blob.size(); ++p) {
+        if (*p != 0xCD) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void test_size_from_header() {
+    CHECK(size_from_header(0) == 0);
+    CHECK(size_from_header(5) == 5);
+    CHECK(size_from_header(-1) == 0);
+    CHECK(size_from_header(INT32_MIN) == 0);
+    CHECK(size_from_header(INT32_MAX) == (size_t)INT32_MAX);
+}
+
+void test_fits() {
+    CHECK(fits(10, 0, 10));
+    CHECK(fits(10, 10, 0));
+    CHECK(fits(10, 3, 7));
+    CHECK(fits(0, 0, 0));
+
+    // start > size
+    CHECK(!fits(10, 11, 0));
+    CHECK(!fits(0, 1, 0));
+
+    // count > size - start
+    CHECK(!fits(10, 3, 8));
+    CHECK(!fits(10, 0, 11));
+
+    // Would wrap around if added up.
+    CHECK(!fits(10, 5, SIZE_MAX));
+    CHECK(!fits(10, SIZE_MAX, 1));
+    CHECK(!fits(SIZE_MAX, SIZE_MAX, 1));
+}
+
+void test_copy_out() {
+    FakeArray array{8, sizeof(void*), 8};
+    auto objects = array.elements<void*>();
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+        objects[i] = (void*)(0x1000 + i);
+    }
+
+    std::vector<void*> out(16, nullptr);
+
+    CHECK(copy_out(objects, std::span{out}, 0) == 8);
+    CHECK(out[0] == (void*)0x1000 && out[7] == (void*)0x1007 && out[8] == nullptr);
+
+    // count > size - start, clipped to what's left.
+    std::fill(out.begin(), out.end(), nullptr);
+    CHECK(copy_out(objects, std::span{out}.first(4), 6) == 2);
+    CHECK(out[0] == (void*)0x1006 && out[1] == (void*)0x1007 && out[2] == nullptr);
+
+    // Clipped to the output.
+    std::fill(out.begin(), out.end(), nullptr);
+    CHECK(copy_out(objects, std::span{out}.first(3), 2) == 3);
+    CHECK(out[0] == (void*)0x1002 && out[2] == (void*)0x1004 && out[3] == nullptr);
+
+    // start == size and start > size copy nothing.
+    std::fill(out.begin(), out.end(), nullptr);
+    CHECK(copy_out(objects, std::span{out}, 8) == 0);
+    CHECK(copy_out(objects, std::span{out}, 9) == 0);
+    CHECK(copy_out(objects, std::span{out}, SIZE_MAX) == 0);
+    CHECK(out[0] == nullptr);
+
+    CHECK(copy_out(objects, std::span<void*>{}, 0) == 0);
+
+    // A negative count in the header is an empty array, nothing is read.
+    array.header().num_elements = -5;
+    CHECK(copy_out(array.elements<void*>(), std::span{out}, 0) == 0);
+    CHECK(out[0] == nullptr);
+}
+
+void test_write_raw() {
+    struct Vec3 {
+        float x, y, z;
+    };
+
+    constexpr size_t N = 6;
+    FakeArray array{N, sizeof(Vec3), N};
+    std::memset(array.data(), 0, N * sizeof(Vec3));
+
+    const std::vector<Vec3> values{{1, 2, 3}, {4, 5, 6}};
+    const std::span<const uint8_t> bytes{(const uint8_t*)values.data(), values.size() * sizeof(Vec3)};
+
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), 2, bytes) == RawWrite::OK);
+
+    const auto elements = array.elements<Vec3>();
+    CHECK(elements[1].x == 0);
+    CHECK(elements[2].x == 1 && elements[2].z == 3);
+    CHECK(elements[3].y == 5);
+    CHECK(elements[4].x == 0);
+
+    // Up to the very end.
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), N - 2, bytes) == RawWrite::OK);
+    CHECK(elements[5].z == 6);
+    CHECK(guard_intact(array, N));
+
+    // Byte counts that aren't a multiple of the element size, checked before anything else.
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), 0, bytes.first(sizeof(Vec3) + 1)) == RawWrite::BAD_BYTE_COUNT);
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), 0, bytes.first(sizeof(Vec3) - 1)) == RawWrite::BAD_BYTE_COUNT);
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), 100, bytes.first(1)) == RawWrite::BAD_BYTE_COUNT);
+    CHECK(write_raw(array.data(), array.size(), 0, 0, bytes) == RawWrite::BAD_BYTE_COUNT);
+
+    // start > size
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), N + 1, {}) == RawWrite::OUT_OF_RANGE);
+
+    // count > size - start, nothing is written.
+    std::vector<uint8_t> before{array.data(), array.data() + N * sizeof(Vec3)};
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), N - 1, bytes) == RawWrite::OUT_OF_RANGE);
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), SIZE_MAX, bytes) == RawWrite::OUT_OF_RANGE);
+    CHECK(std::memcmp(before.data(), array.data(), before.size()) == 0);
+    CHECK(guard_intact(array, N));
+
+    // Empty writes are fine anywhere inside, including at the end.
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), N, {}) == RawWrite::OK);
+
+    // A negative header count takes nothing.
+    array.header().num_elements = -1;
+    CHECK(write_raw(array.data(), array.size(), sizeof(Vec3), 0, bytes) == RawWrite::OUT_OF_RANGE);
+}
+
+void bench(bool full) {
+    const size_t n = full ? 10'000'000 : 1'000'000;
+
+    FakeArray array{(int32_t)n, sizeof(void*), n};
+    auto objects = array.elements<void*>();
+    std::iota((uintptr_t*)objects.data(), (uintptr_t*)objects.data() + n, (uintptr_t)0x1000);
+
+    std::vector<void*> out(n);
+    size_t copied = 0;
+
+    const auto copy_ms = test::time_ms([&] { copied = copy_out(objects, std::span{out}, 0); });
+    CHECK(copied == n);
+
+    // What a per-element loop with its own bounds check costs for the same copy.
+    const auto per_element_ms = test::time_ms([&] {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = fits(array.size(), i, 1) ? objects[i] : nullptr;
+        }
+    });
+
+    std::vector<uint8_t> bytes(n * sizeof(void*), 0x11);
+    RawWrite result{};
+    const auto raw_ms = test::time_ms([&] { result = write_raw(array.data(), array.size(), sizeof(void*), 0, bytes); });
+    CHECK(result == RawWrite::OK);
+
+    std::printf("%zu elements: copy_out %.2f ms, per element %.2f ms, write_raw %.2f ms\n", n, copy_ms, per_element_ms, raw_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_size_from_header();
+    test_fits();
+    test_copy_out();
+    test_write_raw();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("ArrayRangeTests");
+}
@@ -0,0 +1,255 @@
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utility/ConfigStore.hpp>
+
+#include "Test.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+fs::path make_temp_dir() {
+    auto dir = fs::temp_directory_path() / ("reframework_config_store_" + std::to_string(std::random_device{}()));
+    fs::create_directories(dir);
+    return dir;
+}
+
+// Shaped like re2_fw_config.txt: Mod_Value keys with bools, ints, floats and strings.
+utility::Config make_config(size_t num_keys) {
+    utility::Config cfg{};
+
+    for (size_t i = 0; i < num_keys; ++i) {
+        const auto key = "Mod" + std::to_string(i % 40) + "_Value" + std::to_string(i);
+
+        switch (i % 4) {
+        case 0: cfg.set<bool>(key, i % 8 == 0); break;
+        case 1: cfg.set<int32_t>(key, (int32_t)i - 5000); break;
+        case 2: cfg.set<float>(key, (float)i * 0.25f); break;
+        default: cfg.set<std::string>(key, "option_" + std::to_string(i)); break;
+        }
+    }
+
+    return cfg;
+}
+
+// What a ModValue does: intern once, then read through whichever table is bound to the config.
+template <typename T>
+std::optional<T> load_value(const utility::Config& cfg, uint32_t key, const std::string& name) {
+    const auto table = utility::ConfigTable::bound_to(cfg);
+    return table != nullptr ? table->get<T>(key) : cfg.get<T>(name);
+}
+
+void test_table(const fs::path& dir) {
+    constexpr size_t NUM_KEYS = 10'000;
+
+    auto source = make_config(NUM_KEYS);
+    CHECK(source.save((dir / "table.txt").string()));
+
+    utility::ConfigStore store{dir / "table.txt"};
+    const auto snapshot = store.load_snapshot();
+
+    CHECK(snapshot->table.size() == NUM_KEYS);
+    CHECK(store.load_snapshot() == snapshot); // Parsed once until the file changes
+    CHECK(utility::ConfigKeys::find("Mod0_Value0") != utility::ConfigKeys::INVALID);
+    CHECK(utility::ConfigKeys::find("Mod0_Missing") == utility::ConfigKeys::INVALID);
+
+    const utility::ConfigTable::Binding _{snapshot->config, snapshot->table};
+    size_t num_mismatched = 0;
+
+    for (size_t i = 0; i < NUM_KEYS; ++i) {
+        const auto name = "Mod" + std::to_string(i % 40) + "_Value" + std::to_string(i);
+        const auto key = utility::ConfigKeys::intern(name);
+
+        const auto matches = [&]<typename T>() {
+            return load_value<T>(snapshot->config, key, name) == snapshot->config.get<T>(name);
+        };
+
+        switch (i % 4) {
+        case 0: num_mismatched += !matches.operator()<bool>(); break;
+        case 1: num_mismatched += !matches.operator()<int32_t>(); break;
+        case 2: num_mismatched += !matches.operator()<float>(); break;
+        default: num_mismatched += !matches.operator()<std::string>(); break;
+        }
+    }
+
+    CHECK(num_mismatched == 0);
+
+    // Values that don't convert are missing either way.
+    const auto string_key = utility::ConfigKeys::intern("Mod3_Value3");
+    CHECK(!snapshot->table.get<int32_t>(string_key).has_value());
+    CHECK(!snapshot->table.get<bool>(string_key).has_value());
+    CHECK(!snapshot->table.get<int32_t>(utility::ConfigKeys::intern("Mod0_NeverSaved")).has_value());
+}
+
+// Odd values a hand-edited config can hold convert the same way through the table and the config.
+void test_parsing_matches_config() {
+    const std::vector<std::string> values{
+        "12", "12abc", " 12", "\t7", "+5", "-3", "1.5", "1e3", "abc", "", " ", "99999999999",
+        "true", "false", " true", "TRUE", "1", "0", "truex", "0x10",
+    };
+
+    utility::Config cfg{};
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        cfg.set<std::string>("Parse_Value" + std::to_string(i), values[i]);
+    }
+
+    const auto table = utility::ConfigTable::from_key_values(cfg.get_key_values());
+    size_t num_mismatched = 0;
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto name = "Parse_Value" + std::to_string(i);
+        const auto key = utility::ConfigKeys::intern(name);
+
+        num_mismatched += table.get<int32_t>(key) != cfg.get<int32_t>(name);
+        num_mismatched += table.get<float>(key) != cfg.get<float>(name);
+        num_mismatched += table.get<bool>(key) != cfg.get<bool>(name);
+    }
+
+    CHECK(num_mismatched == 0);
+
+    const auto get_int = [&](size_t i) { return table.get<int32_t>(utility::ConfigKeys::intern("Parse_Value" + std::to_string(i))); };
+    const auto get_bool = [&](size_t i) { return table.get<bool>(utility::ConfigKeys::intern("Parse_Value" + std::to_string(i))); };
+
+    CHECK(get_int(1) == 12); // Trailing characters are ignored
+    CHECK(get_int(2) == 12);
+    CHECK(get_int(3) == 7);
+    CHECK(get_int(4) == 5);
+    CHECK(!get_int(8).has_value());
+    CHECK(!get_int(9).has_value());
+    CHECK(!get_int(11).has_value()); // Out of range
+    CHECK(get_bool(14) == true);
+    CHECK(!get_bool(16).has_value());
+}
+
+void test_binding() {
+    utility::Config a{};
+    utility::Config b{};
+    utility::ConfigTable table_a{};
+    utility::ConfigTable table_b{};
+
+    CHECK(utility::ConfigTable::bound_to(a) == nullptr);
+
+    {
+        const utility::ConfigTable::Binding bind_a{a, table_a};
+        CHECK(utility::ConfigTable::bound_to(a) == &table_a);
+        CHECK(utility::ConfigTable::bound_to(b) == nullptr);
+
+        {
+            const utility::ConfigTable::Binding bind_b{b, table_b};
+            CHECK(utility::ConfigTable::bound_to(b) == &table_b);
+        }
+
+        CHECK(utility::ConfigTable::bound_to(a) == &table_a);
+
+        // Bindings are per thread.
+        std::thread{[&] { CHECK(utility::ConfigTable::bound_to(a) == nullptr); }}.join();
+    }
+
+    CHECK(utility::ConfigTable::bound_to(a) == nullptr);
+}
+
+void test_save_now(const fs::path& dir) {
+    const auto path = dir / "save_now.txt";
+    utility::ConfigStore store{path};
+
+    auto cfg = make_config(10);
+    cfg.set<bool>("Test_Flag", true);
+
+    CHECK(store.save_now(std::move(cfg)));
+    CHECK(!store.has_pending());
+    CHECK(utility::Config{path.string()}.get<bool>("Test_Flag") == true);
+    CHECK(store.load()->get<bool>("Test_Flag") == true);
+}
+
+void test_failed_write_retries(const fs::path& dir) {
+    // The directory doesn't exist yet, so the first writes fail.
+    const auto path = dir / "later" / "config.txt";
+    utility::ConfigStore store{path};
+
+    utility::Config cfg{};
+    cfg.set<int32_t>("Test_Value", 42);
+    store.save(std::move(cfg));
+
+    CHECK(!store.flush());
+    CHECK(store.has_pending());
+
+    // Not lost: loads still see it, and the writer thread keeps trying.
+    CHECK(store.load()->get<int32_t>("Test_Value") == 42);
+    CHECK(store.load_snapshot()->table.get<int32_t>(utility::ConfigKeys::intern("Test_Value")) == 42);
+
+    fs::create_directories(path.parent_path());
+
+    const auto deadline = std::chrono::steady_clock::now() + utility::ConfigStore::SAVE_RETRY_DELAY * 3;
+
+    while (store.has_pending() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+
+    CHECK(!store.has_pending());
+    CHECK(utility::Config{path.string()}.get<int32_t>("Test_Value") == 42);
+}
+
+void bench(const fs::path& dir, bool full) {
+    const size_t num_keys = full ? 100'000 : 10'000;
+    const auto path = dir / "bench.txt";
+
+    auto source = make_config(num_keys);
+    source.save(path.string());
+
+    std::vector<std::pair<uint32_t, std::string>> values{};
+
+    for (size_t i = 0; i < num_keys; ++i) {
+        auto name = "Mod" + std::to_string(i % 40) + "_Value" + std::to_string(i);
+        values.emplace_back(utility::ConfigKeys::intern(name), std::move(name));
+    }
+
+    // Before: every startup pass parsed the file again and looked every value up by name.
+    size_t found = 0;
+
+    const auto reparse_ms = test::time_ms([&] {
+        for (size_t pass = 0; pass < 3; ++pass) {
+            const utility::Config cfg{path.string()};
+
+            for (const auto& [key, name] : values) {
+                found += cfg.get(name).has_value();
+            }
+        }
+    });
+
+    // After: one parse shared by every pass, values read by key id.
+    utility::ConfigStore store{path};
+
+    const auto store_ms = test::time_ms([&] {
+        for (size_t pass = 0; pass < 3; ++pass) {
+            const auto snapshot = store.load_snapshot();
+
+            for (const auto& [key, name] : values) {
+                found += snapshot->table.get(key) != nullptr;
+            }
+        }
+    });
+
+    CHECK(found == num_keys * 6);
+    std::printf("%zu keys, 3 load passes: reparse by name %.2f ms, shared table by id %.2f ms\n", num_keys, reparse_ms, store_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    const auto dir = make_temp_dir();
+
+    test_table(dir);
+    test_parsing_matches_config();
+    test_binding();
+    test_save_now(dir);
+    test_failed_write_retries(dir);
+    bench(dir, test::full_size(argc, argv));
+
+    std::error_code ec{};
+    fs::remove_all(dir, ec);
+
+    return test::finish("ConfigStoreTests");
+}
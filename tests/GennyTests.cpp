@@ -0,0 +1,124 @@
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Genny.hpp>
+
+#include "Test.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+// Namespaces full of classes with parents, fields, methods and enums, like ObjectExplorer builds from the TDB.
+void build_sdk(genny::Sdk& sdk, int num_namespaces, int types_per_namespace) {
+    auto g = sdk.global_ns();
+    sdk.include("cstdint");
+
+    auto u32 = g->type("uint32_t")->size(4);
+    auto f32 = g->type("float")->size(4);
+
+    std::mt19937 rng{7};
+    std::vector<genny::Struct*> all{};
+
+    for (int n = 0; n < num_namespaces; ++n) {
+        auto ns = g->namespace_("app")->namespace_("ns" + std::to_string(n));
+
+        for (int t = 0; t < types_per_namespace; ++t) {
+            auto s = ns->class_("Type" + std::to_string(t));
+            s->size(0x40);
+
+            if (!all.empty() && rng() % 2 != 0) {
+                s->parent(all[rng() % all.size()]);
+            }
+
+            for (int v = 0; v < 4; ++v) {
+                s->variable("v" + std::to_string(v))->type(rng() % 2 != 0 ? u32 : f32)->offset(0x10 + v * 4);
+            }
+
+            for (int f = 0; f < 3; ++f) {
+                auto fn = s->function("fn" + std::to_string(f));
+                fn->returns(all.empty() ? (genny::Type*)u32 : (genny::Type*)all[rng() % all.size()]->ptr());
+                fn->param("a")->type(u32);
+                fn->procedure("return {};");
+            }
+
+            if (t % 10 == 0) {
+                ns->enum_("E" + std::to_string(t))->value("A", 1)->value("B", 2)->type(u32);
+            }
+
+            all.push_back(s);
+        }
+    }
+}
+
+// Every file under dir, keyed by relative path. file_list.txt names the output directory, which differs per run.
+std::map<std::string, std::string> read_tree(const fs::path& dir) {
+    std::map<std::string, std::string> files{};
+
+    for (const auto& entry : fs::recursive_directory_iterator{dir}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+
+        std::ifstream f{entry.path(), std::ios::binary};
+        std::stringstream ss{};
+        ss << f.rdbuf();
+
+        auto contents = ss.str();
+        const auto dir_name = dir.string();
+
+        for (size_t pos = 0; (pos = contents.find(dir_name, pos)) != std::string::npos;) {
+            contents.replace(pos, dir_name.size(), "<sdk>");
+        }
+
+        files[fs::relative(entry.path(), dir).generic_string()] = std::move(contents);
+    }
+
+    return files;
+}
+
+double generate(const genny::Sdk& sdk, const fs::path& dir, size_t num_threads) {
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    return test::time_ms([&] {
+        if (num_threads == 0) {
+            sdk.generate(dir);
+        } else {
+            sdk.generate(dir, num_threads);
+        }
+    });
+}
+}
+
+int main(int argc, char** argv) {
+    const auto full = test::full_size(argc, argv);
+
+    genny::Sdk sdk{};
+    build_sdk(sdk, full ? 40 : 10, full ? 150 : 50);
+
+    const auto root = fs::temp_directory_path() / "reframework_genny_tests";
+    const auto serial_dir = root / "serial";
+    const auto parallel_dir = root / "parallel";
+
+    const auto serial_ms = generate(sdk, serial_dir, 0);
+    const auto expected = read_tree(serial_dir);
+
+    CHECK(expected.size() > 1);
+    std::printf("serial: %zu files in %.2f ms\n", expected.size(), serial_ms);
+
+    for (const size_t num_threads : {1, 2, 4, 8, 16}) {
+        const auto ms = generate(sdk, parallel_dir, num_threads);
+
+        CHECK(read_tree(parallel_dir) == expected);
+        std::printf("%2zu threads: %.2f ms\n", num_threads, ms);
+    }
+
+    fs::remove_all(root);
+
+    return test::finish("GennyTests");
+}
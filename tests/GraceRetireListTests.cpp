@@ -0,0 +1,210 @@
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <utility/GraceRetireList.hpp>
+
+#include "Test.hpp"
+
+using utility::GraceRetireList;
+using utility::InFlightCounter;
+
+namespace {
+// Stands in for ScriptState::DelegateStorage: the thunk counts the call, the callback uncounts it.
+struct Storage {
+    InFlightCounter calls{};
+    std::atomic<bool> released{false};
+};
+
+using Item = std::unique_ptr<Storage>;
+
+size_t collect(GraceRetireList<Item>& list) {
+    return list.collect(
+        [](const Item& storage) { return storage->calls.idle(); },
+        [](Item& storage) { storage->released = true; }
+    );
+}
+
+void test_grace_period() {
+    GraceRetireList<Item> list{2};
+
+    list.retire(std::make_unique<Storage>());
+
+    // Idle, but a call may have loaded its address and not counted itself yet.
+    CHECK(collect(list) == 0);
+    list.advance();
+    CHECK(collect(list) == 0);
+    list.advance();
+    CHECK(collect(list) == 1);
+    CHECK(list.empty());
+
+    // Retired later, waits for its own grace period.
+    list.retire(std::make_unique<Storage>());
+    list.advance();
+    list.retire(std::make_unique<Storage>());
+    list.advance();
+    CHECK(collect(list) == 1);
+    CHECK(list.size() == 1);
+    list.advance();
+    CHECK(collect(list) == 1);
+    CHECK(list.empty());
+}
+
+void test_busy_item() {
+    GraceRetireList<Item> list{1};
+
+    auto busy = std::make_unique<Storage>();
+    auto busy_ptr = busy.get();
+    busy->calls.enter();
+
+    list.retire(std::move(busy));
+    list.retire(std::make_unique<Storage>());
+
+    for (size_t i = 0; i < 5; ++i) {
+        list.advance();
+    }
+
+    // A long call only holds back its own storage.
+    CHECK(collect(list) == 1);
+    CHECK(list.size() == 1);
+    CHECK(!busy_ptr->released);
+
+    busy_ptr->calls.leave();
+    CHECK(collect(list) == 1);
+    CHECK(list.empty());
+}
+
+void test_counter_layout() {
+    // Counters of different storages never share a cache line.
+    static_assert(alignof(InFlightCounter) == 64);
+    static_assert(sizeof(InFlightCounter) == 64);
+
+    Storage a{}, b{};
+    CHECK(a.calls.idle());
+    a.calls.enter();
+    a.calls.enter();
+    CHECK(!a.calls.idle());
+    CHECK(b.calls.idle());
+    a.calls.leave();
+    a.calls.leave();
+    CHECK(a.calls.idle());
+}
+
+// Threads invoke through a binding that keeps being swapped and retired, like delegate invocations the engine
+// calls while scripts are reloaded. Each frame ends once every invoker has passed a quiescent point (between two
+// invocations), which is what a frame boundary is for the engine's threads.
+void test_invocations(bool full) {
+    constexpr size_t NUM_THREADS = 8;
+    const size_t num_invocations = full ? 10'000'000 : 1'000'000;
+    const size_t per_thread = num_invocations / NUM_THREADS;
+
+    struct alignas(64) Invoker {
+        std::atomic<uint64_t> seen_frame{0};
+        std::atomic<bool> done{false};
+    };
+
+    GraceRetireList<Item> list{2};
+    std::vector<Item> graveyard{}; // Released storages stay allocated so a late call shows up as a flag, not a crash
+    std::atomic<Storage*> binding{new Storage{}};
+    std::atomic<uint64_t> frame{0};
+    std::atomic<size_t> num_late{0};
+    std::atomic<size_t> num_calls{0};
+    std::vector<Invoker> invokers(NUM_THREADS);
+    std::vector<std::thread> threads{};
+
+    size_t num_frames = 0;
+
+    const auto ms = test::time_ms([&] {
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                auto& self = invokers[t];
+                size_t late = 0;
+
+                for (size_t i = 0; i < per_thread; ++i) {
+                    // The window the grace period covers: the address is loaded, the call isn't counted yet.
+                    const auto storage = binding.load(std::memory_order_acquire);
+                    storage->calls.enter();
+
+                    if (storage->released.load(std::memory_order_relaxed)) {
+                        ++late;
+                    }
+
+                    storage->calls.leave();
+
+                    self.seen_frame.store(frame.load(std::memory_order_acquire), std::memory_order_release);
+
+                    // Lets the rebinding thread in on machines with fewer cores than invokers.
+                    if (i % 1024 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                num_late += late;
+                num_calls += per_thread;
+                self.done = true;
+            });
+        }
+
+        auto all_done = [&] {
+            for (const auto& invoker : invokers) {
+                if (!invoker.done) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        while (!all_done()) {
+            // Rebind and retire the old storage, then end the frame.
+            list.retire(Item{binding.exchange(new Storage{}, std::memory_order_acq_rel)});
+
+            const auto current = frame.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+            for (const auto& invoker : invokers) {
+                while (!invoker.done && invoker.seen_frame.load(std::memory_order_acquire) < current) {
+                    std::this_thread::yield();
+                }
+            }
+
+            list.advance();
+            ++num_frames;
+
+            list.collect(
+                [](const Item& storage) { return storage->calls.idle(); },
+                [&](Item& storage) {
+                    storage->released = true;
+                    graveyard.push_back(std::move(storage));
+                }
+            );
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    CHECK(num_late == 0);
+    CHECK(num_calls == per_thread * NUM_THREADS);
+    CHECK(list.size() <= 2);
+    CHECK(graveyard.size() + list.size() == num_frames);
+
+    delete binding.load();
+
+    std::printf("%zu invocations from %zu threads across %zu rebinds: %.2f ms (%.1f ns/invocation)\n",
+        num_calls.load(), NUM_THREADS, num_frames, ms, ms * 1e6 / (double)num_calls.load());
+}
+}
+
+int main(int argc, char** argv) {
+    const auto full = test::full_size(argc, argv);
+
+    test_grace_period();
+    test_busy_item();
+    test_counter_layout();
+    test_invocations(full);
+
+    return test::finish("GraceRetireListTests");
+}
@@ -0,0 +1,261 @@
+#include <atomic>
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <utility/LockFree.hpp>
+
+#include "Test.hpp"
+
+using utility::ShardedCounters;
+using utility::SlabPool;
+
+namespace {
+// Owner is set when an object is handed out and cleared before it's released,
+// so an object handed to two threads at once fails the exchange.
+struct Object {
+    std::atomic<uint32_t> owner{0};
+    uint64_t payload{};
+};
+
+void test_slab_exhaustion() {
+    constexpr size_t SLAB_SIZE = 4;
+    constexpr size_t MAX_SLABS = 3;
+
+    SlabPool<Object, SLAB_SIZE, MAX_SLABS> pool{};
+    CHECK(pool.capacity() == 0);
+
+    std::set<Object*> objects{};
+
+    for (size_t i = 0; i < SLAB_SIZE * MAX_SLABS; ++i) {
+        const auto object = pool.acquire();
+        CHECK(object != nullptr);
+        objects.insert(object);
+    }
+
+    CHECK(objects.size() == SLAB_SIZE * MAX_SLABS);
+    CHECK(pool.capacity() == SLAB_SIZE * MAX_SLABS);
+
+    // Full, and it stays full.
+    CHECK(pool.acquire() == nullptr);
+    CHECK(pool.acquire() == nullptr);
+    CHECK(pool.capacity() == SLAB_SIZE * MAX_SLABS);
+
+    // A released object is the next one handed out, nothing is allocated for it.
+    const auto released = *objects.begin();
+    pool.release(released);
+    CHECK(pool.acquire() == released);
+    CHECK(pool.acquire() == nullptr);
+
+    pool.release(nullptr);
+    CHECK(pool.acquire() == nullptr);
+
+    for (const auto object : objects) {
+        pool.release(object);
+    }
+
+    std::set<Object*> again{};
+
+    for (size_t i = 0; i < SLAB_SIZE * MAX_SLABS; ++i) {
+        again.insert(pool.acquire());
+    }
+
+    CHECK(again == objects);
+}
+
+// Threads hold a few objects at a time from a pool smaller than what they all want,
+// so acquire sees empty free lists, growth races and nullptr returns.
+void test_slab_contention(bool full) {
+    constexpr uint32_t NUM_THREADS = 8;
+    constexpr size_t HOLD = 6;
+    const size_t rounds = full ? 200'000 : 20'000;
+
+    SlabPool<Object, 8, 4> pool{};
+    std::atomic<size_t> num_duplicates{0};
+    std::atomic<size_t> num_corrupt{0};
+    std::atomic<size_t> num_exhausted{0};
+    std::atomic<size_t> num_acquired{0};
+    std::vector<std::thread> threads{};
+
+    const auto ms = test::time_ms([&] {
+        for (uint32_t t = 1; t <= NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                std::vector<Object*> held{};
+                size_t duplicates = 0, corrupt = 0, exhausted = 0, acquired = 0;
+
+                for (size_t round = 0; round < rounds; ++round) {
+                    for (size_t i = 0; i < HOLD; ++i) {
+                        const auto object = pool.acquire();
+
+                        if (object == nullptr) {
+                            ++exhausted;
+                            continue;
+                        }
+
+                        uint32_t expected = 0;
+
+                        if (!object->owner.compare_exchange_strong(expected, t)) {
+                            ++duplicates;
+                            continue;
+                        }
+
+                        object->payload = ((uint64_t)t << 32) | round;
+                        held.push_back(object);
+                        ++acquired;
+                    }
+
+                    for (const auto object : held) {
+                        if (object->owner.load() != t || object->payload != (((uint64_t)t << 32) | round)) {
+                            ++corrupt;
+                        }
+
+                        object->owner.store(0);
+                        pool.release(object);
+                    }
+
+                    held.clear();
+                }
+
+                num_duplicates += duplicates;
+                num_corrupt += corrupt;
+                num_exhausted += exhausted;
+                num_acquired += acquired;
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    CHECK(num_duplicates == 0);
+    CHECK(num_corrupt == 0);
+    CHECK(num_acquired + num_exhausted == NUM_THREADS * rounds * HOLD);
+
+    // Grown on demand, how far depends on how the threads overlapped.
+    CHECK(pool.capacity() <= 8 * 4);
+
+    // Everything was released, the whole pool is available again.
+    std::set<Object*> objects{};
+
+    for (size_t i = 0; i < 8 * 4; ++i) {
+        objects.insert(pool.acquire());
+    }
+
+    CHECK(!objects.contains(nullptr));
+    CHECK(objects.size() == 8 * 4);
+    CHECK(pool.acquire() == nullptr);
+
+    std::printf("SlabPool: %zu acquire/release pairs from %u threads (%zu exhausted): %.2f ms\n",
+        num_acquired.load(), NUM_THREADS, num_exhausted.load(), ms);
+}
+
+uint64_t make_key(uint16_t shard, uint64_t low) {
+    return ((uint64_t)shard << 48) | low;
+}
+
+void test_counters_basic() {
+    ShardedCounters<4, 16> counters{};
+
+    CHECK(counters.size() == 0);
+    CHECK(!counters.get(make_key(0, 1)).has_value());
+
+    CHECK(counters.increment(make_key(0, 1)) == 0);
+    CHECK(counters.increment(make_key(0, 1)) == 1);
+    CHECK(counters.increment(make_key(1, 1)) == 0); // Same low bits, other shard
+    CHECK(counters.increment(make_key(0, 17)) == 0); // Same slot, probes to the next one
+
+    CHECK(counters.get(make_key(0, 1)) == 2);
+    CHECK(counters.get(make_key(1, 1)) == 1);
+    CHECK(counters.get(make_key(0, 17)) == 1);
+    CHECK(!counters.get(make_key(0, 33)).has_value());
+    CHECK(counters.size() == 3);
+
+    counters.clear();
+    CHECK(counters.size() == 0);
+    CHECK(!counters.get(make_key(0, 1)).has_value());
+    CHECK(counters.increment(make_key(0, 1)) == 0);
+    CHECK(counters.size() == 1);
+}
+
+void test_counters_overflow() {
+    constexpr size_t SLOTS = 8;
+    ShardedCounters<2, SLOTS> counters{};
+
+    for (uint64_t i = 1; i <= SLOTS; ++i) {
+        CHECK(counters.increment(make_key(0, i)) == 0);
+    }
+
+    CHECK(counters.size() == SLOTS);
+
+    // Shard 0 is full, new keys share the overflow counter and aren't tracked on their own.
+    CHECK(counters.increment(make_key(0, 100)) == 0);
+    CHECK(counters.increment(make_key(0, 101)) == 1);
+    CHECK(counters.increment(make_key(0, 100)) == 2);
+    CHECK(!counters.get(make_key(0, 100)).has_value());
+    CHECK(counters.size() == SLOTS);
+
+    // Known keys in the full shard and keys in the other shard still count on their own.
+    CHECK(counters.increment(make_key(0, 1)) == 1);
+    CHECK(counters.increment(make_key(1, 100)) == 0);
+    CHECK(counters.get(make_key(1, 100)) == 1);
+    CHECK(counters.size() == SLOTS + 1);
+
+    counters.clear();
+    CHECK(counters.increment(make_key(0, 100)) == 0);
+    CHECK(counters.get(make_key(0, 100)) == 1);
+}
+
+void test_counters_contention(bool full) {
+    constexpr uint32_t NUM_THREADS = 8;
+    constexpr uint64_t NUM_KEYS = 512;
+    const size_t per_thread = full ? 2'000'000 : 200'000;
+
+    ShardedCounters<> counters{};
+    std::vector<std::thread> threads{};
+
+    // Every thread walks all keys, starting at a different one, so first inserts race.
+    const auto key_at = [](uint64_t i) { return make_key((uint16_t)(i % 16), i * 2654435761ull % (1ull << 40) + 1); };
+
+    const auto ms = test::time_ms([&] {
+        for (uint32_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    counters.increment(key_at((i + t * 61) % NUM_KEYS));
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    uint64_t total = 0;
+
+    for (uint64_t i = 0; i < NUM_KEYS; ++i) {
+        const auto count = counters.get(key_at(i));
+        CHECK(count.has_value());
+        total += count.value_or(0);
+    }
+
+    CHECK(counters.size() == NUM_KEYS);
+    CHECK(total == NUM_THREADS * per_thread);
+
+    std::printf("ShardedCounters: %zu increments from %u threads over %llu keys: %.2f ms\n",
+        NUM_THREADS * per_thread, NUM_THREADS, (unsigned long long)NUM_KEYS, ms);
+}
+}
+
+int main(int argc, char** argv) {
+    const auto full = test::full_size(argc, argv);
+
+    test_slab_exhaustion();
+    test_slab_contention(full);
+    test_counters_basic();
+    test_counters_overflow();
+    test_counters_contention(full);
+
+    return test::finish("LockFreeTests");
+}
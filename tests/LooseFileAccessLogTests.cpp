@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/base_sink.h>
+
+#include <mods/LooseFileAccessLog.hpp>
+#include <utility/LockFree.hpp>
+
+#include "Test.hpp"
+
+namespace {
+class CountingSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    size_t count() {
+        std::scoped_lock _{mutex_};
+        return m_count;
+    }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg&) override { ++m_count; }
+    void flush_() override {}
+
+private:
+    size_t m_count{0};
+};
+
+struct Loggers {
+    std::shared_ptr<CountingSink> accessed_sink{std::make_shared<CountingSink>()};
+    std::shared_ptr<CountingSink> loose_sink{std::make_shared<CountingSink>()};
+    std::shared_ptr<spdlog::logger> accessed{std::make_shared<spdlog::logger>("accessed", accessed_sink)};
+    std::shared_ptr<spdlog::logger> loose{std::make_shared<spdlog::logger>("loose", loose_sink)};
+};
+
+void test_ring_order() {
+    struct Item {
+        uint32_t producer{};
+        uint32_t seq{};
+    };
+
+    constexpr size_t NUM_PRODUCERS = 8;
+    constexpr uint32_t PER_PRODUCER = 50'000;
+
+    utility::MpscRing<Item, 1024> ring{};
+    std::atomic<size_t> num_done{0};
+    std::vector<uint32_t> next_seq(NUM_PRODUCERS, 0);
+    std::vector<uint32_t> accepted(NUM_PRODUCERS, 0);
+    size_t received = 0;
+    bool in_order = true;
+
+    const auto consume = [&](const Item& item) {
+        // Each producer's items come out in the order they went in, gaps are drops.
+        in_order &= item.seq >= next_seq[item.producer];
+        next_seq[item.producer] = item.seq + 1;
+        ++received;
+    };
+
+    std::vector<std::thread> producers{};
+
+    for (uint32_t p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                if (ring.try_push([&](Item& item) { item = {p, i}; })) {
+                    ++accepted[p];
+                }
+
+                if ((i & 255) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            ++num_done;
+        });
+    }
+
+    while (num_done != NUM_PRODUCERS) {
+        ring.drain(consume);
+        std::this_thread::yield();
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    ring.drain(consume);
+
+    size_t total_accepted = 0;
+
+    for (const auto count : accepted) {
+        total_accepted += count;
+    }
+
+    CHECK(in_order);
+    CHECK(received == total_accepted);
+    CHECK(received + ring.dropped() == NUM_PRODUCERS * PER_PRODUCER);
+}
+
+void test_dedup() {
+    Loggers loggers{};
+
+    {
+        LooseFileAccessLog log{loggers.accessed, loggers.loose};
+
+        constexpr uint8_t all = LooseFileAccessLog::LOG_ACCESSED | LooseFileAccessLog::LOG_LOOSE | LooseFileAccessLog::SHOW_RECENT;
+
+        log.push(L"natives/stm/a.tex", 1, all | LooseFileAccessLog::LOOSE);
+        log.push(L"natives/stm/a.tex", 1, all | LooseFileAccessLog::LOOSE);
+        log.push(L"natives/stm/b.tex", 2, all);
+        log.push(L"natives/stm/c.tex", 3, LooseFileAccessLog::SHOW_RECENT); // Only shown, never logged
+    }
+
+    // Destroying the log drains whatever the writer hadn't got to.
+    CHECK(loggers.accessed_sink->count() == 2);
+    CHECK(loggers.loose_sink->count() == 1);
+}
+
+// Waits up to a second for the writer to log count paths.
+bool wait_for_count(CountingSink& sink, size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+
+    while (sink.count() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    return sink.count() == count;
+}
+
+void test_wake_from_idle() {
+    Loggers loggers{};
+    LooseFileAccessLog log{loggers.accessed, loggers.loose};
+
+    // Every push comes from a new thread: rings are per thread and this one's belongs to the log test_dedup made.
+    const auto push_from_thread = [&](size_t id) {
+        std::thread{[&] {
+            const auto path = L"natives/stm/idle" + std::to_wstring(id) + L".tex";
+            log.push(path.c_str(), id, LooseFileAccessLog::LOG_ACCESSED);
+        }}.join();
+    };
+
+    // The writer found nothing and sleeps without a timeout, each push after that has to wake it.
+    // Some pushes land right after the previous batch, while the writer is still deciding whether to go idle.
+    for (size_t i = 1; i <= 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{i % 4 == 0 ? 150 : 1});
+        push_from_thread(i);
+
+        CHECK(wait_for_count(*loggers.accessed_sink, i));
+    }
+}
+
+void test_stress(bool full) {
+    constexpr size_t NUM_THREADS = 16;
+    const size_t total = full ? 1'000'000 : 160'000;
+    const size_t per_thread = total / NUM_THREADS;
+
+    Loggers loggers{};
+    auto log = std::make_unique<LooseFileAccessLog>(loggers.accessed, loggers.loose);
+
+    std::vector<std::thread> threads{};
+
+    const auto ms = test::time_ms([&] {
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                std::wstring path{};
+
+                for (size_t i = 0; i < per_thread; ++i) {
+                    const auto id = t * per_thread + i;
+
+                    path = L"natives/stm/dir" + std::to_wstring(id % 512) + L"/file" + std::to_wstring(id) + L".tex";
+                    log->push(path.c_str(), id, LooseFileAccessLog::LOG_ACCESSED);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    // Pushes never block, so a ring that fills before the writer wakes drops. Every path is unique,
+    // so each one is either logged once or counted as dropped.
+    const auto dropped = log->get_dropped();
+    log.reset();
+
+    CHECK(loggers.accessed_sink->count() + dropped == per_thread * NUM_THREADS);
+    std::printf("%zu paths from %zu threads pushed in %.2f ms, %llu dropped, %zu logged\n", per_thread * NUM_THREADS, NUM_THREADS, ms, (unsigned long long)dropped, loggers.accessed_sink->count());
+}
+}
+
+int main(int argc, char** argv) {
+    test_ring_order();
+    test_dedup();
+    test_wake_from_idle();
+    test_stress(test::full_size(argc, argv));
+
+    return test::finish("LooseFileAccessLogTests");
+}
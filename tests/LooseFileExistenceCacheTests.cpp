@@ -0,0 +1,225 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <mods/LooseFileExistenceCache.hpp>
+
+#include "Test.hpp"
+
+namespace {
+std::atomic<size_t> g_num_probes{0};
+
+// Stands in for the disk: a path exists if the number in its file name is even.
+bool probe(const wchar_t* path) {
+    ++g_num_probes;
+
+    const wchar_t* name = path;
+
+    for (auto p = path; *p != L'\0'; ++p) {
+        if (*p == L'/' || *p == L'\\') {
+            name = p + 1;
+        }
+    }
+
+    // The digit just before the extension.
+    for (auto p = name; *p != L'\0'; ++p) {
+        if (*p == L'.') {
+            return p != name && p[-1] >= L'0' && p[-1] <= L'9' && (p[-1] - L'0') % 2 == 0;
+        }
+    }
+
+    return false;
+}
+
+// Paths shaped like the ones the game streams: a few hundred directories, versioned extensions.
+std::vector<std::wstring> make_paths(size_t count) {
+    std::vector<std::wstring> paths{};
+
+    for (size_t i = 0; i < count; ++i) {
+        paths.push_back(L"natives/STM/Character/dir" + std::to_wstring(i % 300) + L"/file" + std::to_wstring(i) + L".tex.241106027");
+    }
+
+    return paths;
+}
+
+void test_probe_once() {
+    LooseFileExistenceCache cache{};
+    const auto paths = make_paths(10'000);
+
+    g_num_probes = 0;
+
+    for (const auto& path : paths) {
+        const auto result = cache.check(path.c_str(), probe);
+        CHECK(result.first_seen);
+        CHECK(!result.cached);
+        CHECK(result.exists == probe(path.c_str()));
+    }
+
+    CHECK(g_num_probes == paths.size() * 2);
+    g_num_probes = 0;
+
+    for (const auto& path : paths) {
+        const auto result = cache.check(path.c_str(), probe);
+        CHECK(!result.first_seen);
+        CHECK(result.cached);
+    }
+
+    CHECK(g_num_probes == 0);
+    CHECK(cache.get_size() == paths.size());
+
+    // Case and separators are folded, so these are the same file.
+    CHECK(cache.check(L"NATIVES\\stm\\character\\DIR0\\FILE0.TEX.241106027", probe).cached);
+    CHECK(g_num_probes == 0);
+
+    // Without the L1 every lookup goes to the shared table.
+    cache.set_use_l1(false);
+    CHECK(cache.check(paths[5].c_str(), probe).cached);
+    CHECK(g_num_probes == 0);
+}
+
+void test_clear() {
+    LooseFileExistenceCache cache{};
+    const auto paths = make_paths(100);
+
+    for (const auto& path : paths) {
+        cache.check(path.c_str(), probe);
+    }
+
+    cache.clear();
+
+    // Nothing was reading the old table, so it's already gone.
+    CHECK(cache.get_num_retired() == 0);
+    CHECK(cache.get_size() == 0);
+
+    g_num_probes = 0;
+
+    for (const auto& path : paths) {
+        CHECK(cache.check(path.c_str(), probe).first_seen);
+    }
+
+    CHECK(g_num_probes == paths.size());
+}
+
+void test_clear_under_lookups() {
+    constexpr size_t NUM_THREADS = 8;
+
+    LooseFileExistenceCache cache{};
+    const auto paths = make_paths(20'000);
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> num_wrong{0};
+    std::vector<std::thread> threads{};
+
+    for (size_t t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; !done.load(std::memory_order_relaxed); i += NUM_THREADS) {
+                const auto& path = paths[i % paths.size()];
+
+                if (cache.check(path.c_str(), probe).exists != probe(path.c_str())) {
+                    ++num_wrong;
+                }
+            }
+        });
+    }
+
+    // Clearing while lookups run retires tables that can't be freed yet. Freed too early, the lookups
+    // read reused memory and the results go wrong (or a sanitizer build reports it).
+    for (size_t i = 0; i < 200; ++i) {
+        // Every other round without the L1, so lookups always go to whichever table is current.
+        cache.set_use_l1(i % 2 == 0);
+        cache.clear();
+        cache.collect_garbage();
+        std::this_thread::yield();
+    }
+
+    done = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    cache.collect_garbage();
+
+    CHECK(num_wrong == 0);
+    CHECK(cache.get_num_retired() == 0);
+}
+
+// What LooseFileLoader::handle_path did before: a global set behind a lock, probing while holding it.
+class LockedSets {
+public:
+    bool check(const wchar_t* path) {
+        std::unique_lock _{m_mutex};
+
+        if (m_seen.contains(path)) {
+            return m_existing.contains(path);
+        }
+
+        m_seen.insert(path);
+
+        if (probe(path)) {
+            m_existing.insert(path);
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::unordered_set<std::wstring> m_seen{};
+    std::unordered_set<std::wstring> m_existing{};
+};
+
+template <typename F>
+double run_threads(size_t num_threads, size_t lookups_per_thread, F&& fn) {
+    std::vector<std::thread> threads{};
+
+    return test::time_ms([&] {
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = 0; i < lookups_per_thread; ++i) {
+                    fn(t, i);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+}
+
+void bench(bool full) {
+    const auto paths = make_paths(full ? 150'000 : 30'000);
+    const size_t lookups_per_thread = full ? 2'000'000 : 200'000;
+
+    for (const size_t num_threads : {1, 4, 16}) {
+        std::atomic<size_t> found{0};
+
+        LooseFileExistenceCache cache{};
+        const auto cache_ms = run_threads(num_threads, lookups_per_thread, [&](size_t t, size_t i) {
+            found += cache.check(paths[(t * 7919 + i * 31) % paths.size()].c_str(), probe).exists;
+        });
+
+        LockedSets sets{};
+        const auto locked_ms = run_threads(num_threads, lookups_per_thread, [&](size_t t, size_t i) {
+            found += sets.check(paths[(t * 7919 + i * 31) % paths.size()].c_str());
+        });
+
+        std::printf("%zu paths, %2zu threads x %zu lookups: cache %.2f ms, locked sets %.2f ms (%zu found)\n",
+            paths.size(), num_threads, lookups_per_thread, cache_ms, locked_ms, found.load());
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    test_probe_once();
+    test_clear();
+    test_clear_under_lookups();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("LooseFileExistenceCacheTests");
+}
@@ -0,0 +1,261 @@
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mods/MethodTable.hpp>
+
+#include "Test.hpp"
+
+using Entry = MethodTable::Entry;
+using CacheStatus = MethodTable::CacheStatus;
+
+namespace {
+constexpr uint64_t KEY = 0x1234'5678'9ABC'DEF0;
+
+struct Table {
+    std::vector<Entry> entries{};
+    std::vector<char> arena{};
+
+    void add(uint32_t rva, std::string_view name) {
+        entries.push_back({rva, (uint32_t)arena.size()});
+        arena.insert(arena.end(), name.begin(), name.end());
+        arena.push_back('\0');
+    }
+};
+
+// The cache file image, in an 8 byte aligned buffer like a mapped view.
+struct CacheImage {
+    std::vector<uint64_t> storage{};
+    size_t size{};
+
+    explicit CacheImage(const std::string& bytes) : storage((bytes.size() + 7) / 8), size{bytes.size()} {
+        std::memcpy(storage.data(), bytes.data(), bytes.size());
+    }
+
+    std::span<const char> data() const {
+        return {(const char*)storage.data(), size};
+    }
+
+    char* bytes() {
+        return (char*)storage.data();
+    }
+};
+
+std::string serialize(const Table& table, uint64_t key = KEY) {
+    std::ostringstream out{};
+    CHECK(MethodTable::write_cache(out, key, table.entries, table.arena));
+    return out.str();
+}
+
+Table make_table(size_t n, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::vector<std::vector<Entry>> entries(4);
+    std::vector<std::vector<char>> arenas(4);
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto w = i % 4;
+        const auto name = "app.Type" + std::to_string(rng() % 5000) + ".method" + std::to_string(i);
+
+        entries[w].push_back({(uint32_t)(0x1000 + rng() % 0x4000000), (uint32_t)arenas[w].size()});
+        arenas[w].insert(arenas[w].end(), name.begin(), name.end());
+        arenas[w].push_back('\0');
+    }
+
+    Table table{};
+    MethodTable::merge(entries, arenas, table.entries, table.arena);
+    return table;
+}
+
+void test_find() {
+    Table table{};
+    table.add(0x100, "A.a");
+    table.add(0x200, "A.b");
+    table.add(0x300, "B.a");
+
+    const std::span<const Entry> entries{table.entries};
+
+    // Below the first entry.
+    CHECK(MethodTable::find(entries, 0) == nullptr);
+    CHECK(MethodTable::find(entries, 0xFF) == nullptr);
+
+    // Exact hits.
+    CHECK(MethodTable::find(entries, 0x100) == &table.entries[0]);
+    CHECK(MethodTable::find(entries, 0x200) == &table.entries[1]);
+    CHECK(MethodTable::find(entries, 0x300) == &table.entries[2]);
+
+    // Between entries.
+    CHECK(MethodTable::find(entries, 0x101) == &table.entries[0]);
+    CHECK(MethodTable::find(entries, 0x1FF) == &table.entries[0]);
+    CHECK(MethodTable::find(entries, 0x2FF) == &table.entries[1]);
+
+    // Past the last one.
+    CHECK(MethodTable::find(entries, 0x301) == &table.entries[2]);
+    CHECK(MethodTable::find(entries, UINT32_MAX) == &table.entries[2]);
+
+    CHECK(MethodTable::name(table.arena, *MethodTable::find(entries, 0x250)) == "A.b");
+
+    CHECK(MethodTable::find({}, 0x100) == nullptr);
+
+    const Entry one{0x100, 0};
+    CHECK(MethodTable::find({&one, 1}, 0xFF) == nullptr);
+    CHECK(MethodTable::find({&one, 1}, 0x100) == &one);
+    CHECK(MethodTable::find({&one, 1}, 0x101) == &one);
+}
+
+void test_merge() {
+    std::vector<std::vector<Entry>> entries{{{0x300, 0}, {0x100, 4}}, {{0x200, 0}, {0x100, 4}}};
+    std::vector<std::vector<char>> arenas{{'A', '.', 'c', '\0', 'A', '.', 'a', '\0'}, {'B', '.', 'b', '\0', 'B', '.', 'a', '\0'}};
+
+    Table table{};
+    MethodTable::merge(entries, arenas, table.entries, table.arena);
+
+    // Sorted, offsets rebased, the first of two entries at 0x100 kept.
+    CHECK(table.entries.size() == 3);
+    CHECK(table.arena.size() == 16);
+    CHECK(table.entries[0].rva == 0x100 && MethodTable::name(table.arena, table.entries[0]) == "A.a");
+    CHECK(table.entries[1].rva == 0x200 && MethodTable::name(table.arena, table.entries[1]) == "B.b");
+    CHECK(table.entries[2].rva == 0x300 && MethodTable::name(table.arena, table.entries[2]) == "A.c");
+}
+
+void test_cache_round_trip() {
+    const auto table = make_table(1000, 1);
+    const CacheImage image{serialize(table)};
+
+    const auto cache = MethodTable::parse_cache(image.data(), KEY);
+    CHECK(cache.status == CacheStatus::OK);
+    CHECK(cache.entries.size() == table.entries.size());
+    CHECK(cache.arena.size() == table.arena.size());
+    CHECK(std::memcmp(cache.entries.data(), table.entries.data(), cache.entries.size_bytes()) == 0);
+    CHECK(std::equal(cache.arena.begin(), cache.arena.end(), table.arena.begin()));
+
+    // Views into the image, not copies.
+    CHECK((const char*)cache.entries.data() == image.data().data() + sizeof(MethodTable::CacheHeader));
+
+    for (size_t i = 0; i < table.entries.size(); i += 97) {
+        const auto& e = table.entries[i];
+        const auto found = MethodTable::find(cache.entries, e.rva);
+        CHECK(found != nullptr && MethodTable::name(cache.arena, *found) == MethodTable::name(table.arena, e));
+    }
+
+    // An empty table round trips too.
+    const CacheImage empty{serialize(Table{})};
+    const auto empty_cache = MethodTable::parse_cache(empty.data(), KEY);
+    CHECK(empty_cache.status == CacheStatus::OK);
+    CHECK(empty_cache.entries.empty() && empty_cache.arena.empty());
+}
+
+void test_cache_rejected() {
+    Table table{};
+    table.add(0x100, "A.a");
+    table.add(0x200, "A.b");
+
+    const auto bytes = serialize(table);
+
+    // Another game version.
+    CHECK(MethodTable::parse_cache(CacheImage{bytes}.data(), KEY + 1).status == CacheStatus::STALE);
+
+    // Truncated anywhere, including inside the header.
+    for (const auto size : {bytes.size() - 1, bytes.size() - 4, sizeof(MethodTable::CacheHeader) + 8, sizeof(MethodTable::CacheHeader), (size_t)8, (size_t)0}) {
+        CHECK(MethodTable::parse_cache(CacheImage{bytes.substr(0, size)}.data(), KEY).status == CacheStatus::STALE);
+    }
+
+    // Trailing garbage.
+    CHECK(MethodTable::parse_cache(CacheImage{bytes + "x"}.data(), KEY).status == CacheStatus::STALE);
+
+    // Bad magic and version.
+    {
+        CacheImage image{bytes};
+        ((MethodTable::CacheHeader*)image.bytes())->magic ^= 1;
+        CHECK(MethodTable::parse_cache(image.data(), KEY).status == CacheStatus::STALE);
+    }
+
+    {
+        CacheImage image{bytes};
+        ((MethodTable::CacheHeader*)image.bytes())->version += 1;
+        CHECK(MethodTable::parse_cache(image.data(), KEY).status == CacheStatus::STALE);
+    }
+
+    // A name offset at and past the end of the arena.
+    for (const auto offset : {(uint32_t)table.arena.size(), (uint32_t)table.arena.size() + 100, UINT32_MAX}) {
+        CacheImage image{bytes};
+        auto entries = (Entry*)(image.bytes() + sizeof(MethodTable::CacheHeader));
+        entries[1].name_offset = offset;
+        CHECK(MethodTable::parse_cache(image.data(), KEY).status == CacheStatus::CORRUPT);
+    }
+
+    // An arena that doesn't end in a terminator.
+    {
+        CacheImage image{bytes};
+        image.bytes()[bytes.size() - 1] = 'x';
+        CHECK(MethodTable::parse_cache(image.data(), KEY).status == CacheStatus::CORRUPT);
+    }
+
+    // A header whose counts don't add up to the file size.
+    {
+        CacheImage image{bytes};
+        ((MethodTable::CacheHeader*)image.bytes())->num_entries = 0x20000000;
+        CHECK(MethodTable::parse_cache(image.data(), KEY).status == CacheStatus::STALE);
+    }
+}
+
+void bench(bool full) {
+    const size_t n = full ? 2'000'000 : 500'000;
+
+    std::mt19937 rng{2};
+    std::vector<std::vector<Entry>> entries(8);
+    std::vector<std::vector<char>> arenas(8);
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto w = i % 8;
+        const auto name = "app.Type" + std::to_string(i / 16) + ".method" + std::to_string(i % 16);
+
+        entries[w].push_back({(uint32_t)(rng() % 0x8000000), (uint32_t)arenas[w].size()});
+        arenas[w].insert(arenas[w].end(), name.begin(), name.end());
+        arenas[w].push_back('\0');
+    }
+
+    Table table{};
+    const auto build_ms = test::time_ms([&] { MethodTable::merge(entries, arenas, table.entries, table.arena); });
+
+    std::string bytes{};
+    const auto save_ms = test::time_ms([&] { bytes = serialize(table); });
+
+    const CacheImage image{bytes};
+    MethodTable::CacheView cache{};
+    const auto load_ms = test::time_ms([&] { cache = MethodTable::parse_cache(image.data(), KEY); });
+    CHECK(cache.status == CacheStatus::OK);
+
+    constexpr size_t NUM_QUERIES = 1'000'000;
+    std::vector<uint32_t> queries(NUM_QUERIES);
+
+    for (auto& q : queries) {
+        q = rng() % 0x8000000;
+    }
+
+    size_t found = 0;
+    const auto query_ms = test::time_ms([&] {
+        for (const auto q : queries) {
+            found += MethodTable::find(cache.entries, q) != nullptr;
+        }
+    });
+
+    CHECK(found > 0);
+
+    std::printf("%zu methods (%zu unique, %.1f MB cache): build %.2f ms, save %.2f ms, validate %.2f ms, %zu queries %.2f ms (%.1f ns/query)\n",
+        n, table.entries.size(), bytes.size() / (1024.0 * 1024.0), build_ms, save_ms, load_ms,
+        NUM_QUERIES, query_ms, query_ms * 1e6 / NUM_QUERIES);
+}
+}
+
+int main(int argc, char** argv) {
+    test_find();
+    test_merge();
+    test_cache_round_trip();
+    test_cache_rejected();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("MethodTableTests");
+}
@@ -0,0 +1,205 @@
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sdk/NameRegistry.hpp>
+
+#include "Test.hpp"
+
+using Registry = sdk::NameRegistry<uintptr_t>;
+
+namespace {
+// Singleton name -> object slot, shaped like the table REGlobals publishes.
+std::vector<std::pair<std::string, uintptr_t>> make_objects(size_t count, uintptr_t tag) {
+    std::vector<std::pair<std::string, uintptr_t>> objects{};
+
+    for (size_t i = 0; i < count; ++i) {
+        objects.emplace_back("app.ns" + std::to_string(i % 37) + ".Manager" + std::to_string(i), tag + i * 8);
+    }
+
+    return objects;
+}
+
+void test_lookups() {
+    Registry registry{};
+
+    CHECK(registry.empty());
+    CHECK(!registry.find("app.Missing").has_value());
+
+    auto objects = make_objects(5000, 0x10000);
+    objects.emplace_back("app.ns0.Manager0", 0x1); // Later duplicates win, like map assignment
+
+    std::unordered_map<std::string, uintptr_t> expected{};
+
+    for (const auto& [name, value] : objects) {
+        expected[name] = value;
+    }
+
+    CHECK(registry.publish(std::vector{objects}));
+    CHECK(registry.generation() == 1);
+    CHECK(registry.values().size() == objects.size());
+
+    for (const auto& [name, value] : expected) {
+        CHECK(registry.find(name) == value);
+    }
+
+    CHECK(!registry.find("app.ns0.Manager").has_value());
+    CHECK(!registry.find("").has_value());
+
+    // Same contents don't publish again.
+    CHECK(!registry.publish(std::vector{objects}));
+    CHECK(registry.generation() == 1);
+
+    objects.pop_back();
+    CHECK(registry.publish(std::move(objects)));
+    CHECK(registry.find("app.ns0.Manager0") == 0x10000);
+    CHECK(registry.generation() == 2);
+}
+
+void test_negative_cache() {
+    Registry registry{};
+    const auto now = Registry::Clock::now();
+    const auto h = Registry::hash("app.NotYet");
+
+    CHECK(!registry.is_known_missing(h, now));
+
+    registry.mark_missing(h, std::chrono::milliseconds{500}, now);
+    CHECK(registry.is_known_missing(h, now));
+    CHECK(registry.is_known_missing(h, now + std::chrono::milliseconds{499}));
+    CHECK(!registry.is_known_missing(h, now + std::chrono::milliseconds{500}));
+    CHECK(!registry.is_known_missing(Registry::hash("app.Other"), now));
+
+    // Publishing anything forgets the misses, the name may exist now.
+    registry.publish(make_objects(1, 0x20000));
+    CHECK(!registry.is_known_missing(h, now));
+}
+
+void test_reclamation() {
+    Registry registry{};
+    registry.publish(make_objects(100, 0x10000));
+
+    {
+        // A pinned snapshot stays readable across any number of publishes.
+        const auto reader = registry.snapshot();
+
+        for (uintptr_t i = 1; i <= 10; ++i) {
+            registry.publish(make_objects(100, 0x10000 * (i + 1)));
+        }
+
+        CHECK(registry.get_num_retired() == 10);
+        CHECK(*reader->find("app.ns0.Manager0") == 0x10000);
+        CHECK(reader->values().size() == 100);
+    }
+
+    registry.collect();
+    CHECK(registry.get_num_retired() == 0);
+    CHECK(registry.find("app.ns0.Manager0") == 0x10000 * 11);
+}
+
+void test_concurrent_readers() {
+    constexpr size_t NUM_READERS = 8;
+    constexpr size_t NUM_OBJECTS = 500;
+    constexpr uintptr_t TAG = 0x100000;
+
+    Registry registry{};
+    registry.publish(make_objects(NUM_OBJECTS, TAG));
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> num_torn{0};
+    std::atomic<size_t> num_lookups{0};
+    std::vector<std::thread> readers{};
+
+    for (size_t r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937 rng{(uint32_t)r};
+            size_t lookups = 0;
+
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto i = rng() % NUM_OBJECTS;
+                const auto name = "app.ns" + std::to_string(i % 37) + ".Manager" + std::to_string(i);
+
+                // Every value in a snapshot carries the same tag, so reading a freed or half built one shows up here.
+                const auto reader = registry.snapshot();
+                const auto value = reader->find(name);
+                const auto tag = reader->values().front() & ~(TAG - 1);
+
+                if (value == nullptr || (*value & ~(TAG - 1)) != tag || *value - tag != i * 8) {
+                    ++num_torn;
+                }
+
+                ++lookups;
+            }
+
+            num_lookups += lookups;
+        });
+    }
+
+    size_t num_publishes = 0;
+
+    for (uintptr_t generation = 2; generation < 2000; ++generation) {
+        num_publishes += registry.publish(make_objects(NUM_OBJECTS, TAG * generation));
+
+        if (generation % 64 == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    done = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    registry.collect();
+
+    CHECK(num_torn == 0);
+    CHECK(num_publishes == 1998);
+    CHECK(registry.get_num_retired() == 0);
+    std::printf("%zu lookups from %zu threads during %zu publishes\n", num_lookups.load(), NUM_READERS, num_publishes);
+}
+
+void bench(bool full) {
+    // Roughly the number of singletons a current title registers.
+    const auto objects = make_objects(full ? 4000 : 1500, 0x10000);
+    const size_t num_lookups = full ? 10'000'000 : 1'000'000;
+
+    Registry registry{};
+    registry.publish(std::vector{objects});
+
+    // What REGlobals::get did before: a map behind the refresh mutex.
+    std::mutex mutex{};
+    std::unordered_map<std::string, uintptr_t> map{objects.begin(), objects.end()};
+
+    size_t found = 0;
+
+    const auto registry_ms = test::time_ms([&] {
+        for (size_t i = 0; i < num_lookups; ++i) {
+            found += registry.find(objects[(i * 7919) % objects.size()].first).has_value();
+        }
+    });
+
+    const auto map_ms = test::time_ms([&] {
+        for (size_t i = 0; i < num_lookups; ++i) {
+            std::scoped_lock _{mutex};
+            found += map.contains(objects[(i * 7919) % objects.size()].first);
+        }
+    });
+
+    CHECK(found == num_lookups * 2);
+    std::printf("%zu objects, %zu lookups: registry %.2f ms, locked map %.2f ms\n", objects.size(), num_lookups, registry_ms, map_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_lookups();
+    test_negative_cache();
+    test_reclamation();
+    test_concurrent_readers();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("NameRegistryTests");
+}
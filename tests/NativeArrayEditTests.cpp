@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <sdk/NativeArrayEdit.hpp>
+
+#include "Test.hpp"
+
+namespace {
+template<typename T>
+std::vector<T> to_vector(const sdk::NativeArrayNoCapacity<T>& arr) {
+    return arr.elements != nullptr ? std::vector<T>(arr.elements, arr.elements + arr.num) : std::vector<T>{};
+}
+
+template<typename T>
+void assign(sdk::NativeArrayNoCapacity<T>& arr, const std::vector<T>& values) {
+    std::vector<uint32_t> removed{};
+    sdk::rebuild_array(arr, removed, values);
+}
+
+void test_rebuild_array() {
+    sdk::NativeArrayNoCapacity<uint32_t> arr{};
+    assign(arr, {10, 11, 12, 13, 14});
+
+    // Positions refer to the array before the edit, duplicates and out of range ones are ignored.
+    std::vector<uint32_t> removed{3, 1, 3, 99};
+    CHECK(sdk::rebuild_array(arr, removed, std::vector<uint32_t>{20, 21}));
+    CHECK((to_vector(arr) == std::vector<uint32_t>{10, 12, 14, 20, 21}));
+
+    // Only removing compacts in place.
+    const auto elements = arr.elements;
+    removed = {0, 4};
+    CHECK(sdk::rebuild_array(arr, removed, std::vector<uint32_t>{}));
+    CHECK(arr.elements == elements);
+    CHECK((to_vector(arr) == std::vector<uint32_t>{12, 14, 20}));
+
+    removed = {};
+    CHECK(sdk::rebuild_array(arr, removed, std::vector<uint32_t>{}));
+    CHECK(arr.elements == elements);
+
+    sdk::NativeArrayNoCapacity<int32_t> empty{};
+    removed = {0};
+    CHECK(sdk::rebuild_array(empty, removed, std::vector<int32_t>{-1}));
+    CHECK((to_vector(empty) == std::vector<int32_t>{-1}));
+}
+
+void test_append_all() {
+    sdk::NativeArray<void*> arr{};
+    int objects[8]{};
+
+    CHECK(sdk::append_all(arr, std::vector<void*>{&objects[0], &objects[1]}));
+    CHECK(arr.num == 2);
+    CHECK(arr.num_allocated == 2);
+
+    // Spare capacity is used without reallocating.
+    arr.num = 1;
+    const auto elements = arr.elements;
+    CHECK(sdk::append_all(arr, std::vector<void*>{&objects[2]}));
+    CHECK(arr.elements == elements);
+    CHECK(arr.elements[1] == &objects[2]);
+
+    CHECK(sdk::append_all(arr, std::vector<void*>{&objects[3], &objects[4]}));
+    CHECK(arr.num == 4);
+    CHECK(arr.elements[0] == &objects[0]);
+    CHECK(arr.elements[3] == &objects[4]);
+}
+
+// A tree's action array plus its nodes' action index arrays.
+struct SyntheticTree {
+    SyntheticTree(size_t num_nodes, size_t num_actions) : nodes(num_nodes) {
+        std::vector<void*> actions(num_actions);
+
+        for (size_t i = 0; i < num_actions; ++i) {
+            actions[i] = (void*)(0x10000 + i * 0x40);
+        }
+
+        sdk::append_all(tree_actions, actions);
+
+        for (auto& node : nodes) {
+            assign(node, {0, 1, 2, 3});
+        }
+    }
+
+    sdk::NativeArray<void*> tree_actions{};
+    std::vector<sdk::NativeArrayNoCapacity<uint32_t>> nodes;
+};
+
+void bench_actions(bool full) {
+    const size_t num_inserted = full ? 10'000 : 1'000;
+
+    std::mt19937 rng{1};
+    std::vector<std::pair<void*, uint32_t>> inserts(num_inserted);
+
+    for (auto& [action, node] : inserts) {
+        action = (void*)(uintptr_t)(0x900000 + rng() % 0x10000 * 0x40);
+        node = (uint32_t)(rng() % 200);
+    }
+
+    // Before: one edit at a time, like NativeArray::push_back and TreeNode::append_action.
+    // Every element reallocates the tree array (capacity grows by one) and the node's index array.
+    SyntheticTree before{200, 5000};
+    std::vector<uint32_t> removed{};
+
+    const auto before_ms = test::time_ms([&] {
+        for (const auto& [action, node] : inserts) {
+            auto value = action;
+            before.tree_actions.push_back(value);
+
+            const auto index = before.tree_actions.num - 1;
+            removed.clear();
+            sdk::rebuild_array(before.nodes[node], removed, std::vector<uint32_t>{index});
+        }
+    });
+
+    // After: what TreeTransaction::commit does, one allocation per touched array.
+    SyntheticTree after{200, 5000};
+
+    const auto after_ms = test::time_ms([&] {
+        const auto base = after.tree_actions.num;
+        std::vector<void*> actions{};
+        std::vector<std::vector<uint32_t>> appended(after.nodes.size());
+
+        for (const auto& [action, node] : inserts) {
+            appended[node].push_back(base + (uint32_t)actions.size());
+            actions.push_back(action);
+        }
+
+        sdk::append_all(after.tree_actions, actions);
+
+        for (size_t node = 0; node < after.nodes.size(); ++node) {
+            removed.clear();
+            sdk::rebuild_array(after.nodes[node], removed, appended[node]);
+        }
+    });
+
+    // Both end up with the same tree.
+    CHECK(before.tree_actions.num == after.tree_actions.num);
+    CHECK(std::equal(before.tree_actions.elements, before.tree_actions.elements + before.tree_actions.num, after.tree_actions.elements));
+
+    for (size_t node = 0; node < before.nodes.size(); ++node) {
+        CHECK(to_vector(before.nodes[node]) == to_vector(after.nodes[node]));
+    }
+
+    std::printf("%zu actions into 5000 across 200 nodes: one at a time %.3f ms, batched %.3f ms\n", num_inserted, before_ms, after_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_rebuild_array();
+    test_append_all();
+    bench_actions(test::full_size(argc, argv));
+
+    return test::finish("NativeArrayEditTests");
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <sdk/RSZLayout.hpp>
+
+#include "Test.hpp"
+
+using Sequence = sdk::RSZLayout::Sequence;
+
+namespace {
+constexpr uint8_t BOOL = 7;
+constexpr uint8_t U16 = 13;
+constexpr uint8_t S32 = 14;
+constexpr uint8_t F32 = 18;
+constexpr uint8_t F64 = 19;
+constexpr uint8_t STRING = 20;
+constexpr uint8_t ENUM = 22;
+constexpr uint8_t FLOAT3 = 30;
+constexpr uint8_t GUID = 45;
+constexpr uint8_t STRUCT = 3;
+constexpr uint8_t OBJECT = 1;
+
+// A flat value type: bool, u16, float3, double, enum, guid. Stream and object padding differ.
+const std::vector<Sequence> g_sequences{
+    {BOOL, 0, 0x00, 1, 1},
+    {U16, 0, 0x02, 2, 2},
+    {FLOAT3, 0, 0x04, 12, 4},
+    {F64, 0, 0x18, 8, 8},
+    {ENUM, 0, 0x10, 4, 4},
+    {GUID, 0, 0x20, 16, 8},
+};
+
+constexpr size_t OBJECT_SIZE = 0x30;
+
+size_t align_up(size_t value, size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+// Serializes instances the way RSZ lays them out: each field aligned relative to the start of the stream.
+std::vector<uint8_t> make_blob(size_t start, size_t count) {
+    std::vector<uint8_t> blob(start, 0xCC);
+    uint8_t value = 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        for (const auto& sequence : g_sequences) {
+            blob.resize(align_up(blob.size(), sequence.align), 0xCC);
+
+            for (size_t b = 0; b < sequence.size; ++b) {
+                blob.push_back(value++);
+            }
+        }
+    }
+
+    return blob;
+}
+
+// Field by field, what the engine's deserializer does for these types.
+size_t reference_decode(const std::vector<uint8_t>& blob, size_t pos, uint8_t* dst) {
+    for (const auto& sequence : g_sequences) {
+        pos = align_up(pos, sequence.align);
+        std::memcpy(dst + sequence.offset, blob.data() + pos, sequence.size);
+        pos += sequence.size;
+    }
+
+    return pos;
+}
+
+void test_plain_codes() {
+    CHECK(sdk::RSZLayout::is_plain_code(BOOL));
+    CHECK(sdk::RSZLayout::is_plain_code(F64));
+    CHECK(sdk::RSZLayout::is_plain_code(ENUM));
+    CHECK(sdk::RSZLayout::is_plain_code(FLOAT3));
+    CHECK(sdk::RSZLayout::is_plain_code(GUID));
+
+    CHECK(!sdk::RSZLayout::is_plain_code(0));
+    CHECK(!sdk::RSZLayout::is_plain_code(OBJECT));
+    CHECK(!sdk::RSZLayout::is_plain_code(STRUCT));
+    CHECK(!sdk::RSZLayout::is_plain_code(STRING));
+    CHECK(!sdk::RSZLayout::is_plain_code(21)); // MBString
+    CHECK(!sdk::RSZLayout::is_plain_code(48)); // AABB and the rest of the geometry
+    CHECK(!sdk::RSZLayout::is_plain_code(75)); // GameObjectRef
+}
+
+void test_rejected() {
+    // Anything the engine has to resolve, or a nested struct, falls back.
+    for (const auto code : {OBJECT, STRUCT, STRING}) {
+        auto sequences = g_sequences;
+        sequences[2].code = code;
+        CHECK(!sdk::RSZLayout::compile_sequences(sequences).has_value());
+    }
+
+    auto nested = g_sequences;
+    nested[3].depth = 1;
+    CHECK(!sdk::RSZLayout::compile_sequences(nested).has_value());
+
+    CHECK(!sdk::RSZLayout::compile_sequences({}).has_value());
+
+    auto bad_align = g_sequences;
+    bad_align[1].align = 3;
+    CHECK(!sdk::RSZLayout::compile_sequences(bad_align).has_value());
+}
+
+void test_decode() {
+    const auto layout = sdk::RSZLayout::compile_sequences(g_sequences);
+    CHECK(layout.has_value());
+
+    if (!layout) {
+        return;
+    }
+
+    CHECK(layout->max_align() == 8);
+    CHECK(layout->stream_size() == 0x30);
+    CHECK(layout->num_copies() < g_sequences.size()); // bool + u16 + float3 are contiguous on both sides
+
+    // Aligned and misaligned starts, the latter takes the per field path.
+    for (const size_t start : {0, 8, 3, 12}) {
+        const auto blob = make_blob(start, 1);
+
+        uint8_t expected[OBJECT_SIZE]{};
+        uint8_t decoded[OBJECT_SIZE]{};
+        const auto expected_end = reference_decode(blob, start, expected);
+
+        const auto end = layout->decode(blob.data(), blob.size(), start, decoded);
+        CHECK(end == expected_end);
+        CHECK(std::memcmp(expected, decoded, OBJECT_SIZE) == 0);
+
+        // One byte short fails without reading past the end.
+        CHECK(!layout->decode(blob.data(), expected_end - 1, start, decoded).has_value());
+    }
+}
+
+void test_decode_batch() {
+    const auto layout = sdk::RSZLayout::compile_sequences(g_sequences);
+
+    if (!layout) {
+        CHECK(false);
+        return;
+    }
+
+    for (const size_t start : {16, 5}) {
+        constexpr size_t COUNT = 64;
+        const auto blob = make_blob(start, COUNT);
+
+        std::vector<uint8_t> expected(OBJECT_SIZE * COUNT);
+        std::vector<uint8_t> decoded(OBJECT_SIZE * COUNT);
+        std::vector<uint8_t*> dsts{};
+        size_t expected_end = start;
+
+        for (size_t i = 0; i < COUNT; ++i) {
+            expected_end = reference_decode(blob, expected_end, expected.data() + i * OBJECT_SIZE);
+            dsts.push_back(decoded.data() + i * OBJECT_SIZE);
+        }
+
+        CHECK(layout->decode_batch(blob.data(), blob.size(), start, dsts) == expected_end);
+        CHECK(expected == decoded);
+
+        // Nothing is written when the aligned batch doesn't fit.
+        if (start % layout->max_align() == 0) {
+            std::fill(decoded.begin(), decoded.end(), 0);
+            CHECK(!layout->decode_batch(blob.data(), blob.size() - 1, start, dsts).has_value());
+            CHECK(std::all_of(decoded.begin(), decoded.end(), [](uint8_t b) { return b == 0; }));
+        }
+    }
+}
+
+void bench(bool full) {
+    const size_t count = full ? 1'000'000 : 100'000;
+    const auto layout = sdk::RSZLayout::compile_sequences(g_sequences);
+
+    if (!layout) {
+        return;
+    }
+
+    const auto blob = make_blob(0, count);
+    std::vector<uint8_t> objects(OBJECT_SIZE * count);
+
+    const auto reference_ms = test::time_ms([&] {
+        size_t pos = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            pos = reference_decode(blob, pos, objects.data() + i * OBJECT_SIZE);
+        }
+    });
+
+    std::vector<uint8_t*> dsts(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        dsts[i] = objects.data() + i * OBJECT_SIZE;
+    }
+
+    const auto layout_ms = test::time_ms([&] {
+        layout->decode_batch(blob.data(), blob.size(), 0, dsts);
+    });
+
+    std::printf("%zu instances of %zu fields: per field %.2f ms, precompiled batch %.2f ms\n", count, g_sequences.size(), reference_ms, layout_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_plain_codes();
+    test_rejected();
+    test_decode();
+    test_decode_batch();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("RSZLayoutTests");
+}
@@ -0,0 +1,503 @@
+// Headless benchmarks for the SDK lookup structures that build without a running game, run against a
+// generated type table shaped like a TDB (namespaces, nested generics, methods, fields, deep parent chains).
+//
+// > reframework_bench [--out results.json] [--filter name] [--quick]
+//
+// Results are written as JSON in the same shape Google Benchmark emits (context + benchmarks[]) so the
+// same trend tooling can read either.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <sdk/NameRegistry.hpp>
+#include <sdk/RSZLayout.hpp>
+#include <sdk/TypeHierarchy.hpp>
+#include <utility/AddressIndex.hpp>
+#include <utility/SubstringIndex.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+constexpr auto MIN_REPETITION_TIME = std::chrono::milliseconds{20};
+
+// Keeps the optimizer from dropping the measured calls.
+template <typename T>
+void keep(const T& value) {
+    static const void* volatile sink{};
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+struct Options {
+    std::string out{};
+    std::string filter{};
+    size_t repetitions{9};
+    bool quick{false};
+};
+
+struct Result {
+    std::string name{};
+    size_t iterations{};
+    double best_ns{};
+    double median_ns{};
+};
+
+// Generated stand-in for a TDB: every type has a full name, a parent, and a few methods and fields.
+// Sizes are in the range of the larger games (RE4/DD2 have ~100k types).
+struct SyntheticTDB {
+    std::vector<std::string> full_names{};
+    std::vector<uint32_t> parents{};
+    std::vector<std::vector<std::string>> methods{};
+    std::vector<std::vector<std::string>> fields{};
+
+    static SyntheticTDB generate(uint32_t num_types, uint32_t seed) {
+        SyntheticTDB tdb{};
+        std::mt19937 rng{seed};
+
+        tdb.full_names.reserve(num_types);
+        tdb.parents.reserve(num_types);
+        tdb.methods.resize(num_types);
+        tdb.fields.resize(num_types);
+
+        // A handful of roots (System.Object, System.ValueType...), everything else hangs below an earlier type,
+        // biased towards recent ones so some chains get deep.
+        constexpr uint32_t NUM_ROOTS = 4;
+        constexpr std::string_view NAMESPACES[] = {"app", "app.ropeway", "via", "via.gui", "via.motion", "System", "System.Collections.Generic", "snow"};
+        constexpr std::string_view GENERICS[] = {"List`1", "Dictionary`2", "HashSet`1", "Action`1"};
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            if (i < NUM_ROOTS) {
+                tdb.parents.push_back(sdk::TypeHierarchy::parent_from_tdb(0));
+            } else if (rng() % 4 == 0) {
+                tdb.parents.push_back(i - 1 - rng() % std::min<uint32_t>(i, 8));
+            } else {
+                tdb.parents.push_back(rng() % i);
+            }
+
+            const auto ns = NAMESPACES[rng() % std::size(NAMESPACES)];
+
+            // One in eight is a generic instance over earlier types.
+            if (i > 16 && rng() % 8 == 0) {
+                const auto generic = GENERICS[rng() % std::size(GENERICS)];
+                const auto arity = generic.back() - '0';
+                std::string name = "System.Collections.Generic." + std::string{generic} + "<";
+
+                for (auto a = 0; a < arity; ++a) {
+                    name += (a != 0 ? "," : "") + tdb.full_names[rng() % i];
+                }
+
+                tdb.full_names.push_back(name + ">");
+            } else {
+                tdb.full_names.push_back(std::string{ns} + ".Type" + std::to_string(i));
+            }
+
+            for (uint32_t m = 0, n = rng() % 12; m < n; ++m) {
+                tdb.methods[i].push_back((m % 2 == 0 ? "get_Value" : "set_Value") + std::to_string(m / 2));
+            }
+
+            for (uint32_t f = 0, n = rng() % 8; f < n; ++f) {
+                tdb.fields[i].push_back("_field" + std::to_string(f));
+            }
+        }
+
+        return tdb;
+    }
+};
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : m_options{options} {}
+
+    // body performs ops operations per call.
+    template <typename F>
+    void run(std::string_view name, size_t ops, F&& body) {
+        if (!m_options.filter.empty() && name.find(m_options.filter) == std::string_view::npos) {
+            return;
+        }
+
+        using clock = std::chrono::steady_clock;
+
+        // Steady state is what's tracked, the first call warms the caches.
+        body();
+
+        size_t loops = 1;
+
+        while (!m_options.quick) {
+            const auto start = clock::now();
+
+            for (size_t i = 0; i < loops; ++i) {
+                body();
+            }
+
+            if (clock::now() - start >= MIN_REPETITION_TIME || loops >= (1 << 20)) {
+                break;
+            }
+
+            loops *= 2;
+        }
+
+        const auto repetitions = m_options.quick ? 1 : m_options.repetitions;
+        std::vector<double> samples{};
+
+        for (size_t r = 0; r < repetitions; ++r) {
+            const auto start = clock::now();
+
+            for (size_t i = 0; i < loops; ++i) {
+                body();
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            samples.push_back(elapsed / (double)(loops * std::max<size_t>(ops, 1)));
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        m_results.push_back({std::string{name}, loops * ops, samples.front(), samples[samples.size() / 2]});
+        std::fprintf(stderr, "%-40s %10.1f ns/op (best %.1f)\n", m_results.back().name.c_str(), m_results.back().median_ns, m_results.back().best_ns);
+    }
+
+    json to_json() const {
+        json benchmarks = json::array();
+
+        for (const auto& result : m_results) {
+            benchmarks.push_back({
+                {"name", result.name},
+                {"run_type", "aggregate"},
+                {"aggregate_name", "median"},
+                {"iterations", result.iterations},
+                {"real_time", result.median_ns},
+                {"cpu_time", result.median_ns},
+                {"best_time", result.best_ns},
+                {"time_unit", "ns"},
+            });
+        }
+
+        return {
+            {"context", {
+                {"executable", "reframework_bench"},
+                {"num_cpus", std::thread::hardware_concurrency()},
+                {"repetitions", m_options.quick ? 1 : m_options.repetitions},
+                {"library_build_type",
+#ifdef NDEBUG
+                    "release"
+#else
+                    "debug"
+#endif
+                },
+            }},
+            {"benchmarks", benchmarks},
+        };
+    }
+
+private:
+    const Options& m_options;
+    std::vector<Result> m_results{};
+};
+
+// RETypeDefinition::is_a, numbered hierarchy vs the parent walk it replaced.
+void bench_is_a(Runner& runner, const SyntheticTDB& tdb) {
+    const auto n = (uint32_t)tdb.parents.size();
+
+    runner.run("is_a/build_hierarchy", n, [&] {
+        sdk::TypeHierarchy hierarchy{};
+        hierarchy.build(tdb.parents);
+        keep(hierarchy);
+    });
+
+    sdk::TypeHierarchy hierarchy{};
+    hierarchy.build(tdb.parents);
+
+    std::mt19937 rng{1};
+    std::vector<std::pair<uint32_t, uint32_t>> queries(4096);
+
+    for (auto& [type, base] : queries) {
+        type = rng() % n;
+        // Half of them ask about an actual ancestor.
+        base = (rng() % 2 == 0 && tdb.parents[type] < n) ? tdb.parents[type] : rng() % n;
+    }
+
+    runner.run("is_a/numbered", queries.size(), [&] {
+        size_t hits = 0;
+
+        for (const auto& [type, base] : queries) {
+            hits += hierarchy.is_a(type, base).value_or(false);
+        }
+
+        keep(hits);
+    });
+
+    runner.run("is_a/parent_walk", queries.size(), [&] {
+        size_t hits = 0;
+
+        for (const auto& [type, base] : queries) {
+            for (auto t = type; t < n; t = tdb.parents[t]) {
+                if (t == base) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+
+        keep(hits);
+    });
+}
+
+// Name -> type lookups (find_type, singleton tables) through NameRegistry snapshots.
+void bench_find_type(Runner& runner, const SyntheticTDB& tdb) {
+    const auto n = (uint32_t)tdb.full_names.size();
+
+    std::vector<std::pair<std::string, uint32_t>> entries{};
+    entries.reserve(n);
+
+    for (uint32_t i = 0; i < n; ++i) {
+        entries.emplace_back(tdb.full_names[i], i);
+    }
+
+    runner.run("find_type/publish", n, [&] {
+        sdk::NameRegistry<uint32_t> registry{};
+        registry.publish(std::vector{entries});
+        keep(registry);
+    });
+
+    sdk::NameRegistry<uint32_t> registry{};
+    registry.publish(std::move(entries));
+
+    std::mt19937 rng{2};
+    std::vector<std::string_view> hits{};
+    std::vector<std::string> misses{};
+
+    for (size_t i = 0; i < 4096; ++i) {
+        hits.push_back(tdb.full_names[rng() % n]);
+        misses.push_back(tdb.full_names[rng() % n] + "Missing");
+    }
+
+    runner.run("find_type/hit", hits.size(), [&] {
+        const auto reader = registry.snapshot();
+        size_t found = 0;
+
+        for (const auto name : hits) {
+            found += reader->find(name) != nullptr;
+        }
+
+        keep(found);
+    });
+
+    runner.run("find_type/miss", misses.size(), [&] {
+        const auto reader = registry.snapshot();
+        size_t found = 0;
+
+        for (const auto& name : misses) {
+            found += reader->find(name) != nullptr;
+        }
+
+        keep(found);
+    });
+
+    runner.run("find_type/pinned_lookup", hits.size(), [&] {
+        size_t found = 0;
+
+        for (const auto name : hits) {
+            found += registry.find(name).has_value();
+        }
+
+        keep(found);
+    });
+}
+
+// get_method/get_field style lookups by (type, name hash), the shape of the SDK's per-type caches.
+void bench_get_method(Runner& runner, const SyntheticTDB& tdb) {
+    const auto n = (uint32_t)tdb.methods.size();
+
+    std::vector<std::pair<std::string, uint32_t>> entries{};
+
+    for (uint32_t i = 0; i < n; ++i) {
+        for (const auto& method : tdb.methods[i]) {
+            entries.emplace_back(tdb.full_names[i] + "::" + method, i);
+        }
+
+        for (const auto& field : tdb.fields[i]) {
+            entries.emplace_back(tdb.full_names[i] + "." + field, i);
+        }
+    }
+
+    if (entries.empty()) {
+        return;
+    }
+
+    sdk::NameRegistry<uint32_t> registry{};
+    registry.publish(std::vector{entries});
+
+    std::mt19937 rng{3};
+    std::vector<std::string_view> queries{};
+
+    for (size_t i = 0; i < 4096; ++i) {
+        queries.push_back(entries[rng() % entries.size()].first);
+    }
+
+    runner.run("get_method/qualified_name", queries.size(), [&] {
+        const auto reader = registry.snapshot();
+        size_t found = 0;
+
+        for (const auto name : queries) {
+            found += reader->find(name) != nullptr;
+        }
+
+        keep(found);
+    });
+}
+
+// ObjectExplorer's type/method name search.
+void bench_name_search(Runner& runner, const SyntheticTDB& tdb) {
+    const auto n = (uint32_t)tdb.full_names.size();
+
+    runner.run("name_search/build", n, [&] {
+        utility::SubstringIndex::Builder builder{};
+
+        for (uint32_t i = 0; i < n; ++i) {
+            builder.add(i, tdb.full_names[i]);
+        }
+
+        auto index = builder.build();
+        keep(index);
+    });
+
+    utility::SubstringIndex::Builder builder{};
+
+    for (uint32_t i = 0; i < n; ++i) {
+        builder.add(i, tdb.full_names[i]);
+    }
+
+    const auto index = builder.build();
+
+    for (const auto query : {"Type12", "List`1<app", "via.gui.Type"}) {
+        runner.run(std::string{"name_search/"} + query, 1, [&] {
+            utility::SubstringIndex::Search state{};
+            std::vector<uint32_t> owners{};
+            index.search(query, state, owners);
+            keep(owners);
+        });
+    }
+}
+
+// Plain-value RSZ instances decoded from a stream.
+void bench_rsz(Runner& runner) {
+    const std::vector<sdk::RSZLayout::Field> fields{
+        {0x10, 4, 4}, {0x14, 4, 4}, {0x18, 4, 4}, {0x1C, 1, 1}, {0x20, 16, 16}, {0x30, 8, 8},
+    };
+
+    const auto layout = *sdk::RSZLayout::compile(fields);
+    constexpr size_t NUM_INSTANCES = 1024;
+
+    std::vector<uint8_t> stream(layout.stream_size() * NUM_INSTANCES + 64);
+    std::vector<uint8_t> objects(0x40 * NUM_INSTANCES);
+    std::vector<uint8_t*> dsts{};
+
+    for (size_t i = 0; i < NUM_INSTANCES; ++i) {
+        dsts.push_back(objects.data() + i * 0x40);
+    }
+
+    runner.run("rsz/decode_batch", NUM_INSTANCES, [&] {
+        keep(layout.decode_batch(stream.data(), stream.size(), 0, dsts));
+    });
+}
+
+// Callstack symbolization (address -> function).
+void bench_address_index(Runner& runner, bool quick) {
+    using Index = utility::AddressIndex<uint32_t>;
+
+    const uint32_t num_functions = quick ? 20'000 : 200'000;
+    std::mt19937_64 rng{4};
+    std::vector<Index::Entry> entries{};
+    uintptr_t address = 0x140001000;
+
+    for (uint32_t i = 0; i < num_functions; ++i) {
+        const auto size = 16 + rng() % 512;
+        entries.push_back({address, address + size, i});
+        address += size + rng() % 64;
+    }
+
+    Index index{};
+    index.build(std::move(entries));
+
+    std::vector<uintptr_t> addrs(64);
+
+    for (auto& a : addrs) {
+        a = 0x140001000 + rng() % (address - 0x140001000);
+    }
+
+    runner.run("address_index/find_nearest", addrs.size(), [&] {
+        size_t found = 0;
+
+        for (const auto a : addrs) {
+            found += index.find_nearest(a) != nullptr;
+        }
+
+        keep(found);
+    });
+
+    std::vector<const Index::Entry*> out(addrs.size());
+
+    runner.run("address_index/find_nearest_many", addrs.size(), [&] {
+        index.find_nearest_many(addrs, out);
+        keep(out);
+    });
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+
+        if (arg == "--out" && i + 1 < argc) {
+            options.out = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--quick") {
+            options.quick = true;
+        }
+    }
+
+    return options;
+}
+}
+
+int main(int argc, char** argv) {
+    const auto options = parse_options(argc, argv);
+    const auto tdb = SyntheticTDB::generate(options.quick ? 10'000 : 100'000, 1234);
+
+    Runner runner{options};
+
+    bench_is_a(runner, tdb);
+    bench_find_type(runner, tdb);
+    bench_get_method(runner, tdb);
+    bench_name_search(runner, tdb);
+    bench_rsz(runner);
+    bench_address_index(runner, options.quick);
+
+    const auto out = runner.to_json().dump(2);
+
+    if (options.out.empty()) {
+        std::printf("%s\n", out.c_str());
+        return 0;
+    }
+
+    std::ofstream file{options.out};
+
+    if (!file) {
+        std::fprintf(stderr, "reframework_bench: can't write %s\n", options.out.c_str());
+        return 1;
+    }
+
+    file << out << '\n';
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <utility/Relocate.hpp>
+
+#include "Test.hpp"
+
+using utility::PointerRelocator;
+using utility::RelocationRange;
+
+namespace {
+// Same rule as the relocator, one range at a time.
+uintptr_t expected_value(uintptr_t value, const std::vector<RelocationRange>& ranges) {
+    for (const auto& range : ranges) {
+        if (value >= range.old_start && value < range.old_end) {
+            return range.new_start + (value - range.old_start);
+        }
+    }
+
+    return value;
+}
+
+void test_flat_scan() {
+    std::vector<uint8_t> old_a(0x1000), old_b(0x400), new_a(0x1000), new_b(0x400);
+    const std::vector<RelocationRange> ranges{
+        {(uintptr_t)old_a.data(), (uintptr_t)old_a.data() + old_a.size(), (uintptr_t)new_a.data()},
+        {(uintptr_t)old_b.data(), (uintptr_t)old_b.data() + old_b.size(), (uintptr_t)new_b.data()},
+    };
+
+    std::mt19937_64 rng{1234};
+
+    // Odd slot count so the scalar tail after the 4-wide loop runs too.
+    for (const size_t num_slots : {1, 3, 4, 5, 511, 1023}) {
+        std::vector<uintptr_t> block(num_slots);
+
+        for (auto& slot : block) {
+            switch (rng() % 6) {
+            case 0: slot = (uintptr_t)old_a.data() + rng() % old_a.size(); break;
+            case 1: slot = (uintptr_t)old_b.data() + rng() % old_b.size(); break;
+            case 2: slot = (uintptr_t)old_a.data() + old_a.size(); break; // One past the end, not in the range
+            case 3: slot = (uintptr_t)old_b.data() - 1; break;
+            case 4: slot = 0; break;
+            default: slot = rng(); break;
+            }
+        }
+
+        auto expected = block;
+
+        for (auto& value : expected) {
+            value = expected_value(value, ranges);
+        }
+
+        PointerRelocator relocator{ranges};
+        relocator.scan((uint8_t*)block.data(), 0, (uint32_t)(num_slots * sizeof(uintptr_t)));
+
+        CHECK(block == expected);
+    }
+}
+
+void test_unaligned_skip() {
+    std::vector<uint8_t> old_range(0x100), new_range(0x100);
+    const RelocationRange range{(uintptr_t)old_range.data(), (uintptr_t)old_range.data() + old_range.size(), (uintptr_t)new_range.data()};
+
+    // A pointer at an odd offset is only found when stepping a byte at a time.
+    alignas(8) uint8_t block[64]{};
+    const auto ptr = (uintptr_t)old_range.data() + 0x10;
+    std::memcpy(block + 3, &ptr, sizeof(ptr));
+
+    PointerRelocator relocator{std::span{&range, 1}, 1};
+    relocator.scan(block, 0, sizeof(block) - sizeof(void*));
+
+    uintptr_t result{};
+    std::memcpy(&result, block + 3, sizeof(result));
+
+    CHECK(result == (uintptr_t)new_range.data() + 0x10);
+    CHECK(relocator.get_num_relocated() == 1);
+}
+
+struct Node {
+    Node* children[4]{};
+    uint64_t payload{};
+};
+
+void test_follows_graph() {
+    // Nodes in old memory, the tree that links them lives outside every range and is reached by following pointers.
+    std::vector<Node> old_nodes(64), new_nodes(64);
+    const RelocationRange range{(uintptr_t)old_nodes.data(), (uintptr_t)(old_nodes.data() + old_nodes.size()), (uintptr_t)new_nodes.data()};
+
+    std::vector<Node> inner(4);
+    Node root{};
+
+    for (size_t i = 0; i < inner.size(); ++i) {
+        root.children[i] = &inner[i];
+
+        for (size_t j = 0; j < 4; ++j) {
+            inner[i].children[j] = &old_nodes[i * 4 + j];
+        }
+
+        inner[i].payload = 0x1234;
+    }
+
+    PointerRelocator relocator{std::span{&range, 1}};
+    relocator.scan((uint8_t*)&root, 1, sizeof(root));
+
+    for (size_t i = 0; i < inner.size(); ++i) {
+        CHECK(root.children[i] == &inner[i]);
+        CHECK(inner[i].payload == 0x1234);
+
+        for (size_t j = 0; j < 4; ++j) {
+            CHECK(inner[i].children[j] == &new_nodes[i * 4 + j]);
+        }
+    }
+
+    CHECK(relocator.get_num_relocated() == 16);
+
+    // Blocks are only visited once per relocator, even when reached again.
+    const auto blocks = relocator.get_num_blocks();
+    relocator.scan((uint8_t*)&root, 1, sizeof(root));
+    CHECK(relocator.get_num_blocks() == blocks + 1);
+}
+
+void test_overlapping_scanned_blocks() {
+    std::vector<uint8_t> old_range(0x100), new_range(0x100);
+    const RelocationRange range{(uintptr_t)old_range.data(), (uintptr_t)old_range.data() + old_range.size(), (uintptr_t)new_range.data()};
+
+    std::vector<uintptr_t> arena(0x4000 / sizeof(uintptr_t));
+    const auto base = (uint8_t*)arena.data();
+
+    PointerRelocator relocator{std::span{&range, 1}};
+
+    // [0, 0x1000) and [0x1000, 0x2000) touch, [0x800, 0x900) sits inside the first one and starts after it.
+    relocator.scan(base, 0, 0x1000);
+    relocator.scan(base + 0x1000, 0, 0x1000);
+    relocator.scan(base + 0x800, 0, 0x100);
+    CHECK(relocator.get_num_blocks() == 3);
+
+    // Pointers into both recorded blocks, past the end of the nested one. None of them need scanning again.
+    uintptr_t root[3]{(uintptr_t)(base + 0xA00), (uintptr_t)(base + 0x1800), (uintptr_t)(base + 0xFF8)};
+    relocator.scan((uint8_t*)root, 1, sizeof(root));
+    CHECK(relocator.get_num_blocks() == 4);
+
+    // A pointer past everything scanned so far is still followed.
+    uintptr_t outside[1]{(uintptr_t)(base + 0x2800)};
+    relocator.scan((uint8_t*)outside, 1, sizeof(outside));
+    CHECK(relocator.get_num_blocks() == 6);
+}
+
+void test_stops_at_unreadable_memory() {
+#ifdef _WIN32
+    const size_t page_size = 0x1000;
+    auto pages = (uint8_t*)VirtualAlloc(nullptr, page_size * 2, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    DWORD old_protect{};
+    VirtualProtect(pages + page_size, page_size, PAGE_NOACCESS, &old_protect);
+#else
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    auto pages = (uint8_t*)mmap(nullptr, page_size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    mprotect(pages + page_size, page_size, PROT_NONE);
+#endif
+
+    std::vector<uint8_t> old_range(0x100), new_range(0x100);
+    const RelocationRange range{(uintptr_t)old_range.data(), (uintptr_t)old_range.data() + old_range.size(), (uintptr_t)new_range.data()};
+
+    // The last 4 slots of the readable page, the scan size runs well into the guard page.
+    auto slots = (uintptr_t*)(pages + page_size) - 4;
+
+    for (size_t i = 0; i < 4; ++i) {
+        slots[i] = (uintptr_t)old_range.data() + i;
+    }
+
+    PointerRelocator relocator{std::span{&range, 1}};
+    relocator.scan((uint8_t*)slots, 0, 0x1000);
+
+    for (size_t i = 0; i < 4; ++i) {
+        CHECK(slots[i] == (uintptr_t)new_range.data() + i);
+    }
+
+    CHECK(relocator.get_num_relocated() == 4);
+
+#ifdef _WIN32
+    VirtualFree(pages, 0, MEM_RELEASE);
+#else
+    munmap(pages, page_size * 2);
+#endif
+}
+
+void bench_flat_scan(bool full) {
+    // Roughly what a large behavior tree move looks like, a few ranges and a lot of node memory.
+    const size_t num_slots = full ? (64 << 20) / sizeof(uintptr_t) : (4 << 20) / sizeof(uintptr_t);
+
+    std::vector<uint8_t> old_ranges[4], new_ranges[4];
+    std::vector<RelocationRange> ranges{};
+
+    for (size_t r = 0; r < 4; ++r) {
+        old_ranges[r].resize(0x10000);
+        new_ranges[r].resize(0x10000);
+        ranges.push_back({(uintptr_t)old_ranges[r].data(), (uintptr_t)old_ranges[r].data() + 0x10000, (uintptr_t)new_ranges[r].data()});
+    }
+
+    std::vector<uintptr_t> block(num_slots);
+    std::mt19937_64 rng{42};
+
+    for (auto& slot : block) {
+        slot = (rng() % 64 == 0) ? ranges[rng() % 4].old_start + rng() % 0x10000 : rng();
+    }
+
+    PointerRelocator relocator{ranges};
+    const auto ms = test::time_ms([&] { relocator.scan((uint8_t*)block.data(), 0, (uint32_t)(block.size() * sizeof(uintptr_t))); });
+
+    std::printf("flat scan: %zu MB, %zu pointers relocated in %.2f ms\n", block.size() * sizeof(uintptr_t) >> 20, relocator.get_num_relocated(), ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_flat_scan();
+    test_unaligned_skip();
+    test_follows_graph();
+    test_overlapping_scanned_blocks();
+    test_stops_at_unreadable_memory();
+    bench_flat_scan(test::full_size(argc, argv));
+
+    return test::finish("RelocateTests");
+}
@@ -0,0 +1,167 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <utility/SubstringIndex.hpp>
+
+#include "Test.hpp"
+
+using utility::SubstringIndex;
+
+namespace {
+// Type -> method signatures, shaped like the ones ObjectExplorer indexes.
+struct SyntheticTdb {
+    std::vector<std::vector<std::string>> signatures{};
+};
+
+SyntheticTdb make_tdb(size_t num_types, uint32_t seed) {
+    static const char* words[] = {"get", "set", "Update", "Player", "Enemy", "Camera", "Motion", "Fsm", "Layer", "Tree",
+        "Node", "Position", "Rotation", "Velocity", "Health", "Damage", "Item", "Inventory", "Gui", "Sound"};
+    static const char* types[] = {"System.Int32", "System.Single", "System.Boolean", "System.String", "via.vec3", "via.Quaternion"};
+
+    std::mt19937 rng{seed};
+    SyntheticTdb tdb{};
+    tdb.signatures.resize(num_types);
+
+    for (auto& signatures : tdb.signatures) {
+        const auto num_methods = rng() % 12;
+
+        for (size_t m = 0; m < num_methods; ++m) {
+            std::string sig = std::string{types[rng() % 6]} + " ";
+
+            for (auto n = 1 + rng() % 3; n > 0; --n) {
+                sig += words[rng() % 20];
+            }
+
+            sig += "(" + std::string{types[rng() % 6]} + ")";
+            signatures.push_back(std::move(sig));
+        }
+    }
+
+    return tdb;
+}
+
+SubstringIndex build_index(const SyntheticTdb& tdb) {
+    SubstringIndex::Builder builder{};
+
+    for (uint32_t type = 0; type < tdb.signatures.size(); ++type) {
+        for (const auto& sig : tdb.signatures[type]) {
+            builder.add(type, sig);
+        }
+    }
+
+    return builder.build();
+}
+
+std::vector<uint32_t> brute_force(const SyntheticTdb& tdb, std::string_view query) {
+    std::vector<uint32_t> result{};
+
+    if (query.empty()) {
+        return result;
+    }
+
+    for (uint32_t type = 0; type < tdb.signatures.size(); ++type) {
+        for (const auto& sig : tdb.signatures[type]) {
+            if (sig.find(query) != std::string::npos) {
+                result.push_back(type);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+void test_matches_brute_force() {
+    const auto tdb = make_tdb(2000, 1);
+    const auto index = build_index(tdb);
+
+    std::vector<uint32_t> owners{};
+
+    // Short queries skip the trigrams, "player" checks the search stays case sensitive.
+    for (const auto query : {"g", "Up", "get", "Player", "player", "PlayerHealth", "(System.Single)", "via.vec3 set", "Nope", "xyz", ""}) {
+        SubstringIndex::Search search{};
+        index.search(query, search, owners);
+
+        CHECK(owners == brute_force(tdb, query));
+    }
+}
+
+void test_incremental() {
+    const auto tdb = make_tdb(2000, 2);
+    const auto index = build_index(tdb);
+
+    SubstringIndex::Search search{};
+    std::vector<uint32_t> owners{};
+    const std::string typed = "System.Boolean getPlayerPosition";
+
+    // Typing one character at a time narrows the previous matches, backspacing starts over.
+    for (size_t i = 1; i <= typed.size(); ++i) {
+        index.search(typed.substr(0, i), search, owners);
+        CHECK(owners == brute_force(tdb, typed.substr(0, i)));
+    }
+
+    for (size_t i = typed.size(); i > 0; --i) {
+        index.search(typed.substr(0, i), search, owners);
+        CHECK(owners == brute_force(tdb, typed.substr(0, i)));
+    }
+
+    // A state from another index is never reused.
+    const auto other = build_index(make_tdb(100, 3));
+    other.search("get", search, owners);
+    index.search("getP", search, owners);
+    CHECK(owners == brute_force(tdb, "getP"));
+}
+
+void test_interning() {
+    SubstringIndex::Builder builder{};
+    builder.add(0, "void Update()");
+    builder.add(1, "void Update()");
+    builder.add(1, "void Update()");
+    builder.add(4, "bool get_Enabled()");
+    builder.add(2, "");
+
+    const auto index = builder.build();
+
+    CHECK(index.get_num_strings() == 2);
+    CHECK(index.get_num_owners() == 5);
+
+    SubstringIndex::Search search{};
+    std::vector<uint32_t> owners{};
+    index.search("Update", search, owners);
+
+    CHECK((owners == std::vector<uint32_t>{0, 1}));
+}
+
+void bench(bool full) {
+    // Roughly the size of a current title: ~90k types, ~600k methods.
+    const auto tdb = make_tdb(full ? 90'000 : 20'000, 4);
+
+    SubstringIndex index{};
+    const auto build_ms = test::time_ms([&] { index = build_index(tdb); });
+
+    SubstringIndex::Search search{};
+    std::vector<uint32_t> owners{};
+    const std::string typed = "getPlayerHealth";
+    double indexed_ms = 0.0;
+    double brute_ms = 0.0;
+
+    for (size_t i = 1; i <= typed.size(); ++i) {
+        const auto query = typed.substr(0, i);
+        indexed_ms += test::time_ms([&] { index.search(query, search, owners); });
+        brute_ms += test::time_ms([&] { brute_force(tdb, query); });
+    }
+
+    std::printf("%zu types, %zu strings: build %.2f ms, typing %zu chars indexed %.2f ms, brute force %.2f ms\n",
+        tdb.signatures.size(), index.get_num_strings(), build_ms, typed.size(), indexed_ms, brute_ms);
+}
+}
+
+int main(int argc, char** argv) {
+    test_matches_brute_force();
+    test_incremental();
+    test_interning();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("SubstringIndexTests");
+}
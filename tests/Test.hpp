@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+// Minimal assertions for the host-side tests. Each test is an executable that returns non-zero on failure,
+// so CTest needs nothing else. Timings are printed, not checked, so they don't make the tests flaky.
+namespace test {
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline int finish(std::string_view name) {
+    if (failures() != 0) {
+        std::fprintf(stderr, "%.*s: %d check(s) failed\n", (int)name.size(), name.data(), failures());
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%.*s: ok\n", (int)name.size(), name.data());
+    return EXIT_SUCCESS;
+}
+
+template <typename F>
+double time_ms(F&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Larger inputs for benchmarking, off by default so CTest stays quick.
+inline bool full_size(int argc, char** argv) {
+    return argc > 1 && std::string_view{argv[1]} == "--full";
+}
+}
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            ++test::failures(); \
+        } \
+    } while (0)
@@ -0,0 +1,199 @@
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <sdk/TypeHierarchy.hpp>
+
+#include "Test.hpp"
+
+using sdk::TypeHierarchy;
+
+namespace {
+// What RETypeDefinition::is_a did before the numbering: walk up from type until base or a root.
+std::optional<bool> walk_is_a(const std::vector<uint32_t>& parents, uint32_t type, uint32_t base) {
+    const auto n = (uint32_t)parents.size();
+
+    for (uint32_t i = 0, t = type; i <= n; ++i) {
+        if (t == base) {
+            return true;
+        }
+
+        const auto p = parents[t];
+
+        if (p >= n || p == t) {
+            return false;
+        }
+
+        t = p;
+    }
+
+    return std::nullopt; // Cycle
+}
+
+// Types stuck in or under a parent cycle never reach a root and aren't numbered.
+bool reaches_root(const std::vector<uint32_t>& parents, uint32_t type) {
+    return walk_is_a(parents, type, TypeHierarchy::INVALID).has_value();
+}
+
+std::optional<bool> expected_is_a(const std::vector<uint32_t>& parents, uint32_t type, uint32_t base) {
+    if (!reaches_root(parents, type) || !reaches_root(parents, base)) {
+        return std::nullopt;
+    }
+
+    return walk_is_a(parents, type, base);
+}
+
+// A forest shaped like a TDB: a few deep roots (System.Object like) with wide, shallow subtrees.
+std::vector<uint32_t> make_forest(uint32_t num_types, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::vector<uint32_t> parents(num_types);
+
+    for (uint32_t i = 0; i < num_types; ++i) {
+        if (i < 8 || rng() % 500 == 0) {
+            parents[i] = (rng() % 2 == 0) ? TypeHierarchy::INVALID : i; // Both spellings of "root"
+        } else {
+            parents[i] = (uint32_t)(rng() % i);
+        }
+    }
+
+    return parents;
+}
+
+void test_matches_walk() {
+    auto parents = make_forest(5000, 1);
+
+    // Parents after their children, which the numbering doesn't rely on.
+    std::mt19937 rng{2};
+
+    for (uint32_t i = 200; i < parents.size(); i += 7) {
+        parents[i] = i + 1 + (uint32_t)(rng() % (parents.size() - i - 1));
+    }
+
+    // A cycle is never numbered, the caller falls back to the walk.
+    parents[100] = 101;
+    parents[101] = 100;
+    parents[102] = 100;
+
+    TypeHierarchy hierarchy{};
+    hierarchy.build(parents);
+
+    CHECK(hierarchy.size() == parents.size());
+
+    for (uint32_t type = 0; type < parents.size(); ++type) {
+        if (!reaches_root(parents, type)) {
+            CHECK(!hierarchy.is_a(type, type).has_value());
+            continue;
+        }
+
+        // Every ancestor, then some random types.
+        for (uint32_t base = type, i = 0; i < 64 && base < parents.size(); ++i) {
+            CHECK(hierarchy.is_a(type, base) == expected_is_a(parents, type, base));
+
+            if (parents[base] == base) {
+                break;
+            }
+
+            base = parents[base];
+        }
+
+        for (size_t i = 0; i < 4; ++i) {
+            const auto base = (uint32_t)(rng() % parents.size());
+            CHECK(hierarchy.is_a(type, base) == expected_is_a(parents, type, base));
+        }
+    }
+
+    CHECK(!hierarchy.is_a(0, (uint32_t)parents.size()).has_value());
+}
+
+void test_roots() {
+    // 0: root, 1: root (self), 2 -> 0, 3 -> 2, 4 -> 1, 5: root (out of range)
+    const std::vector<uint32_t> parents{TypeHierarchy::INVALID, 1, 0, 2, 1, 1000};
+
+    TypeHierarchy hierarchy{};
+    hierarchy.build(parents);
+
+    CHECK(hierarchy.is_a(0, 0) == true);
+    CHECK(hierarchy.is_a(3, 0) == true);
+    CHECK(hierarchy.is_a(3, 2) == true);
+    CHECK(hierarchy.is_a(2, 3) == false);
+    CHECK(hierarchy.is_a(4, 1) == true);
+    CHECK(hierarchy.is_a(4, 0) == false);
+    CHECK(hierarchy.is_a(0, 1) == false);
+    CHECK(hierarchy.is_a(5, 5) == true);
+    CHECK(hierarchy.is_a(5, 0) == false);
+}
+
+void test_tdb_parent_zero() {
+    // In the TDB, parent_typeid 0 means no parent. Passed through as-is, type 0 would be the base of everything.
+    const std::vector<uint32_t> tdb_parents{0, 0, 1, 0, 3};
+    std::vector<uint32_t> parents{};
+
+    for (const auto p : tdb_parents) {
+        parents.push_back(TypeHierarchy::parent_from_tdb(p));
+    }
+
+    TypeHierarchy hierarchy{};
+    hierarchy.build(parents);
+
+    for (uint32_t type = 1; type < parents.size(); ++type) {
+        CHECK(hierarchy.is_a(type, 0) == false);
+    }
+
+    CHECK(hierarchy.is_a(2, 1) == true);
+    CHECK(hierarchy.is_a(4, 3) == true);
+    CHECK(hierarchy.is_a(4, 1) == false);
+    CHECK(hierarchy.is_a(1, 1) == true);
+}
+
+void bench(bool full) {
+    const auto parents = make_forest(90'000, 3);
+    const size_t num_checks = full ? 10'000'000 : 1'000'000;
+
+    TypeHierarchy hierarchy{};
+    const auto build_ms = test::time_ms([&] { hierarchy.build(parents); });
+
+    std::mt19937 rng{4};
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(4096);
+
+    // Half of the checks against an ancestor, like REComponent::find hitting its match.
+    for (auto& [type, base] : pairs) {
+        type = (uint32_t)(rng() % parents.size());
+        base = (uint32_t)(rng() % parents.size());
+
+        if (rng() % 2 == 0) {
+            base = type;
+
+            for (auto steps = rng() % 4; steps > 0 && parents[base] < parents.size() && parents[base] != base; --steps) {
+                base = parents[base];
+            }
+        }
+    }
+
+    size_t hits = 0;
+
+    const auto numbered_ms = test::time_ms([&] {
+        for (size_t i = 0; i < num_checks; ++i) {
+            const auto& [type, base] = pairs[i & (pairs.size() - 1)];
+            hits += hierarchy.is_a(type, base).value_or(false);
+        }
+    });
+
+    const auto walk_ms = test::time_ms([&] {
+        for (size_t i = 0; i < num_checks; ++i) {
+            const auto& [type, base] = pairs[i & (pairs.size() - 1)];
+            hits += walk_is_a(parents, type, base).value_or(false);
+        }
+    });
+
+    std::printf("90000 types: build %.2f ms, %zu checks numbered %.2f ms, walk %.2f ms (%zu hits)\n", build_ms, num_checks, numbered_ms, walk_ms, hits);
+}
+}
+
+int main(int argc, char** argv) {
+    test_matches_walk();
+    test_roots();
+    test_tdb_parent_zero();
+    bench(test::full_size(argc, argv));
+
+    return test::finish("TypeHierarchyTests");
+}
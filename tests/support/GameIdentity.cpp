@@ -0,0 +1,36 @@
+#include <sdk/GameIdentity.hpp>
+
+// Stand-in for shared/sdk/GameIdentity.cpp, which detects the game from the host executable.
+// The tests always run with RE9's engine parameters.
+namespace sdk {
+GameIdentity GameIdentity::s_instance{};
+bool GameIdentity::s_initialized{false};
+
+void GameIdentity::initialize() {
+    if (s_initialized) {
+        return;
+    }
+
+    s_instance.detect_game();
+    s_instance.derive_engine_params();
+    s_initialized = true;
+}
+
+const GameIdentity& GameIdentity::get() {
+    return s_instance;
+}
+
+void GameIdentity::detect_game() {
+    m_game = GameID::RE9;
+}
+
+void GameIdentity::derive_engine_params() {
+    m_tdb_ver = 83;
+    m_type_index_bits = 19;
+    m_field_bits = 20;
+    m_reengine_packed = true;
+    m_reengine_at = true;
+    m_game_name = "re9";
+    m_target_name = "RE9";
+}
+}
@@ -0,0 +1,26 @@
+#include <cstdlib>
+
+#include <sdk/Memory.hpp>
+
+// Stand-in for shared/sdk/Memory.cpp, which calls the engine's allocator.
+namespace sdk {
+namespace memory {
+void* allocate(size_t size, bool zero_memory) {
+    return zero_memory ? std::calloc(1, size) : std::malloc(size);
+}
+
+void deallocate(void* ptr) {
+    std::free(ptr);
+}
+
+void* reallocate(void* ptr, size_t old_size, size_t size) {
+    return std::realloc(ptr, size);
+}
+
+namespace detail {
+void* allocate_plugin_loader(size_t size) {
+    return std::calloc(1, size);
+}
+}
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Stand-in for kananlib's utility/Config.hpp: key=value lines, values converted with iostreams.
+namespace utility {
+class Config {
+public:
+    Config(const std::string& path = "") {
+        if (!path.empty()) {
+            load(path);
+        }
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream f{path};
+
+        if (!f) {
+            return false;
+        }
+
+        for (std::string line{}; std::getline(f, line);) {
+            if (const auto pos = line.find('='); pos != std::string::npos) {
+                m_key_values[line.substr(0, pos)] = line.substr(pos + 1);
+            }
+        }
+
+        return true;
+    }
+
+    bool save(const std::string& path) {
+        std::ofstream f{path};
+
+        if (!f) {
+            return false;
+        }
+
+        for (const auto& [key, value] : m_key_values) {
+            f << key << "=" << value << "\n";
+        }
+
+        return (bool)f;
+    }
+
+    std::optional<std::string> get(std::string_view key) const {
+        if (auto it = m_key_values.find(std::string{key}); it != m_key_values.end()) {
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    template <typename T>
+    std::optional<T> get(std::string_view key) const {
+        const auto value = get(key);
+
+        if (!value) {
+            return std::nullopt;
+        }
+
+        T result{};
+        std::istringstream ss{*value};
+        ss >> std::boolalpha >> result;
+
+        if (ss.fail()) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    template <typename T>
+    void set(std::string_view key, const T& value) {
+        std::ostringstream ss{};
+        ss << std::boolalpha << value;
+        m_key_values[std::string{key}] = ss.str();
+    }
+
+    const auto& get_key_values() const {
+        return m_key_values;
+    }
+
+private:
+    std::unordered_map<std::string, std::string> m_key_values{};
+};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Stand-in for kananlib's utility/String.hpp, which is only fetched by the framework build.
+namespace utility {
+inline std::string narrow(std::wstring_view str) {
+    std::string result{};
+    result.reserve(str.size());
+
+    for (size_t i = 0; i < str.size(); ++i) {
+        auto c = (uint32_t)str[i];
+
+        // UTF-16 surrogate pairs, wchar_t is 16 bits on Windows.
+        if (c >= 0xD800 && c < 0xDC00 && i + 1 < str.size()) {
+            c = 0x10000 + ((c - 0xD800) << 10) + ((uint32_t)str[++i] - 0xDC00);
+        }
+
+        if (c < 0x80) {
+            result.push_back((char)c);
+        } else if (c < 0x800) {
+            result.push_back((char)(0xC0 | (c >> 6)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            result.push_back((char)(0xE0 | (c >> 12)));
+            result.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        } else {
+            result.push_back((char)(0xF0 | (c >> 18)));
+            result.push_back((char)(0x80 | ((c >> 12) & 0x3F)));
+            result.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        }
+    }
+
+    return result;
+}
+}